@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+
+# Compares 2 Laminar Comm Characterize sweeps (ex. with and without the FIFO cache hints in fifoHints.h)
+# and reports the gain of each test (topology level) at each block size
+
+import argparse
+import matplotlib.pyplot as plt
+import pandas as pd
+
+from PlotLaminarCommon.PlotLaminarCommon import *
+from PlotLaminarCharSweep import loadSweep
+
+avgLineWidth = 1
+
+def setup():
+    parser = argparse.ArgumentParser(description='Compares the results of 2 Laminar Comm Characterize sweeps')
+    parser.add_argument('--baseline-dir', type=str, required=True, help='The directory in which the baseline sweep results are located')
+    parser.add_argument('--variant-dir', type=str, required=True, help='The directory in which the sweep results to compare against the baseline are located')
+    parser.add_argument('--output-file-prefix', type=str, required=True, help='Plots and the gain table will be written to files with this given prefix')
+    parser.add_argument('--title', required=False, type=str, help='Title for the graphs')
+
+    args = parser.parse_args()
+
+    title = args.title
+    if title is None:
+        title = 'Laiminar Comm Characterize Sweep Gain'
+
+    return (args.baseline_dir, args.variant_dir, args.output_file_prefix, title)
+
+def compareSweeps(baseline, variant, title: str, outputPrefix: str):
+    blkSizesBytes = [blkSize for blkSize in baseline.blockSizesBytes if blkSize in variant.blockSizesBytes]
+    if len(blkSizesBytes) == 0:
+        raise ValueError('The sweeps have no block sizes in common')
+
+    baselineResults = {blkSize: result for (blkSize, result) in zip(baseline.blockSizesBytes, baseline.results)}
+    variantResults = {blkSize: result for (blkSize, result) in zip(variant.blockSizesBytes, variant.results)}
+
+    fig, ax = plt.subplots()
+    cmap = plt.get_cmap('tab20')
+
+    tbl = pd.DataFrame()
+    tbl['blkSizeBytes'] = blkSizesBytes
+
+    for (i, testName) in enumerate(REPORTS): #Use the order in REPORTS
+        if testName in baselineResults[blkSizesBytes[0]] and testName in variantResults[blkSizesBytes[0]]:
+            baselineGbps = [getAvgRate(baselineResults[blkSize][testName]) for blkSize in blkSizesBytes]
+            variantGbps = [getAvgRate(variantResults[blkSize][testName]) for blkSize in blkSizesBytes]
+            gain = [v/b for (v, b) in zip(variantGbps, baselineGbps)]
+
+            tbl[testName + ' - Baseline Gbps'] = baselineGbps
+            tbl[testName + ' - Variant Gbps'] = variantGbps
+            tbl[testName + ' - Gain'] = gain
+
+            ax.plot(blkSizesBytes, gain, label=testName, color=cmap(i), linewidth=avgLineWidth)
+
+    ax.axhline(1, color=(0, 0, 0, 1), linewidth=avgLineWidth, linestyle='--')
+    ax.set_ylabel('Gain (Variant Rate / Baseline Rate)')
+    ax.set_xlabel('Block Size (bytes)')
+    ax.set_title(title)
+    ax.legend(fontsize=8)
+
+    suffix = '_comm_sweep_gain'
+    fig.savefig(outputPrefix+suffix+'.pdf', format='pdf')
+    tbl.to_csv(outputPrefix+suffix+'.csv', index=False)
+
+def main():
+    (baselineDir, variantDir, outputPrefix, title) = setup()
+
+    baseline = loadSweep(baselineDir)
+    variant = loadSweep(variantDir)
+    compareSweeps(baseline, variant, title, outputPrefix)
+
+if __name__ == '__main__':
+    main()
@@ -112,9 +112,15 @@ def importReport(rptFiles: typing.List[str], filenameRegex: str, lblFormat: str,
                     reportPart['ServerGbps'] = (reportPart[FIFO_REPORT_FEILD_NAMES.bytesTx] / reportPart[FIFO_REPORT_FEILD_NAMES.serverTime]) * 8 / 1.0e9
                     #Compute Client Rate
                     reportPart['ClientGbps'] = (reportPart[FIFO_REPORT_FEILD_NAMES.bytesRx] / reportPart[FIFO_REPORT_FEILD_NAMES.clientTime]) * 8 / 1.0e9
+                    if 'SamplesTx' in reportPart.columns:
+                        #Compute Sample Rates (reports from before sample types were added do not include the sample count)
+                        reportPart['ServerMsps'] = (reportPart['SamplesTx'] / reportPart[FIFO_REPORT_FEILD_NAMES.serverTime]) / 1.0e6
+                        reportPart['ClientMsps'] = (reportPart['SamplesTx'] / reportPart[FIFO_REPORT_FEILD_NAMES.clientTime]) / 1.0e6
                 elif type == TestResultType.MEMORY:
                     #Compute Memory Rate
                     reportPart['RateGbps'] = (reportPart[MEMORY_REPORT_FEILD_NAMES.bytesTransacted] / reportPart[MEMORY_REPORT_FEILD_NAMES.memoryTime]) * 8 / 1.0e9
+                    if 'SamplesTransacted' in reportPart.columns:
+                        reportPart['RateMsps'] = (reportPart['SamplesTransacted'] / reportPart[MEMORY_REPORT_FEILD_NAMES.memoryTime]) / 1.0e6
                 else:
                     raise RuntimeError('Unknown TestResultType: ' + str(type))
 
@@ -0,0 +1,320 @@
+#include "adaptiveFifo.h"
+#include "pacedFifo.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "timeHelpers.h"
+
+/**
+ * The number of blocks in a ring of len+1 slots
+ */
+static inline int adaptiveFifoOccupancy(int8_t writeOffset, int8_t readOffset, int len){
+    return (writeOffset - readOffset - 1 + len + 1) % (len + 1);
+}
+
+void *adaptive_fifo_server_thread(void* args){
+    adaptive_fifo_threadArgs_t *args_cast = (adaptive_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    _Atomic int8_t *readOffsetPtr = args_cast->readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr = args_cast->writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr = args_cast->arrayPtr;
+    _Atomic int8_t *resizeRequestPtr = args_cast->resizeRequestPtr;
+    _Atomic int64_t *resizeAckPtr = args_cast->resizeAckPtr;
+    _Atomic int64_t *consumerStarvationsPtr = args_cast->consumerStarvationsPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    bool adaptive = args_cast->adaptive;
+    double intervalTSC = args_cast->intervalTSC;
+    int profile = args_cast->profile;
+    uint64_t randState = args_cast->seed == 0 ? 1 : args_cast->seed; //xorshift state must not be 0
+    uint64_t *scheduledTSC = args_cast->scheduledTSC;
+    bool paced = intervalTSC > 0;
+
+    //==== Setup Output FIFO ====
+    int len = args_cast->initialLenBlks;
+    int8_t writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t writeTmp;
+
+    //==== Init write temp ====
+    initFifoBlk(&writeTmp);
+
+    //==== Policy State ====
+    adaptive_fifo_stats_t stats = {0};
+    stats.minLen = len;
+    stats.maxLen = len;
+    int64_t windowProducerStalls = 0;
+    int64_t lastConsumerStarvations = 0;
+    int peakOccupancy = 0;
+    int quietWindows = 0;
+    int64_t resizeEpoch = 0;
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //The schedule is kept as a double so that rounding to TSC ticks does not accumulate
+    double nextRelease = (double) readTSC();
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<PACED_TRANSACTIONS_BLKS; blksTransfered++){
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "+m" (writeTmp)
+        :
+        :);
+
+        //Wait for the block's release time
+        uint64_t releaseTSC;
+        if(paced){
+            releaseTSC = (uint64_t) nextRelease;
+            while(readTSC() < releaseTSC){}
+            nextRelease += pacedNextInterval(profile, intervalTSC, blksTransfered, &randState);
+        }else{
+            releaseTSC = readTSC();
+        }
+
+        //Wait for output FIFO to be ready
+        bool notFull = (readOffsetCached != writeOffsetCached);
+        bool stalled = false;
+        while (!notFull)
+        {
+            readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+            notFull = (readOffsetCached != writeOffsetCached);
+
+            //Only a stall if the FIFO is still full once the cached offset is refreshed
+            if(!notFull && !stalled){
+                stalled = true;
+                stats.producerStalls++;
+                windowProducerStalls++;
+                peakOccupancy = len;
+            }
+        }
+
+        //Write into array
+        int writeOffset = writeOffsetCached;
+        copyBlkToFifo(arrayPtr + writeOffset, &writeTmp);
+        fifoProducerHint(arrayPtr + writeOffset);
+        if (writeOffset >= len)
+        {
+            writeOffset = 0;
+        }
+        else
+        {
+            writeOffset++;
+        }
+        writeOffsetCached = writeOffset;
+        //Update Write Ptr
+        atomic_store_explicit(writeOffsetPtr, writeOffset, memory_order_release);
+
+        scheduledTSC[blksTransfered] = releaseTSC;
+        stats.lenBlkSum += len;
+
+        if(!adaptive){
+            continue;
+        }
+
+        //Sample the occupancy
+        if((blksTransfered+1)%ADAPTIVE_FIFO_SAMPLE_BLKS == 0){
+            readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+            int occupancy = adaptiveFifoOccupancy(writeOffsetCached, readOffsetCached, len);
+            peakOccupancy = occupancy > peakOccupancy ? occupancy : peakOccupancy;
+        }
+
+        //Run the policy (not after the last block since the consumer would not be around to acknowledge a resize)
+        if((blksTransfered+1)%ADAPTIVE_FIFO_WINDOW_BLKS == 0 && blksTransfered+1 < PACED_TRANSACTIONS_BLKS){
+            int64_t consumerStarvations = atomic_load_explicit(consumerStarvationsPtr, memory_order_relaxed);
+            int newLen = adaptiveFifoPolicy(len, windowProducerStalls, consumerStarvations-lastConsumerStarvations, peakOccupancy, &quietWindows);
+            lastConsumerStarvations = consumerStarvations;
+            windowProducerStalls = 0;
+            peakOccupancy = 0;
+
+            if(newLen != len){
+                //Drain
+                while(adaptiveFifoOccupancy(writeOffsetCached, readOffsetCached, len) != 0){
+                    readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+                }
+
+                //Request the new depth and wait for the consumer to park
+                resizeEpoch++;
+                atomic_store_explicit(resizeRequestPtr, newLen, memory_order_release);
+                while(atomic_load_explicit(resizeAckPtr, memory_order_acquire) != resizeEpoch){}
+
+                //Reset the offsets (an empty FIFO) and release the consumer
+                atomic_store_explicit(readOffsetPtr, 0, memory_order_relaxed);
+                atomic_store_explicit(writeOffsetPtr, 1, memory_order_relaxed);
+                atomic_store_explicit(resizeRequestPtr, 0, memory_order_release);
+                readOffsetCached = 0;
+                writeOffsetCached = 1;
+
+                len = newLen;
+                stats.resizes++;
+                stats.minLen = len < stats.minLen ? len : stats.minLen;
+                stats.maxLen = len > stats.maxLen ? len : stats.maxLen;
+            }
+        }
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    stats.finalLen = len;
+    *(args_cast->stats) = stats;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+void *adaptive_fifo_client_thread(void* args){
+    adaptive_fifo_threadArgs_t *args_cast = (adaptive_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    _Atomic int8_t *readOffsetPtr = args_cast->readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr = args_cast->writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr = args_cast->arrayPtr;
+    _Atomic int8_t *resizeRequestPtr = args_cast->resizeRequestPtr;
+    _Atomic int64_t *resizeAckPtr = args_cast->resizeAckPtr;
+    _Atomic int64_t *consumerStarvationsPtr = args_cast->consumerStarvationsPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    bool adaptive = args_cast->adaptive;
+    uint64_t *receivedTSC = args_cast->receivedTSC;
+
+    //==== Setup Input FIFO ====
+    int len = args_cast->initialLenBlks;
+    int8_t writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t readTmp;
+    int64_t consumerStarvations = 0;
+    int64_t resizeEpoch = 0;
+    #if FIFO_BLK_CONSUME
+        fifo_sample_acc_t consumeAcc = 0;
+    #endif
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<PACED_TRANSACTIONS_BLKS; blksTransfered++){
+        //Wait for input FIFO to be ready
+        bool notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -len)));
+        bool starved = false;
+        bool resized = false;
+        while (!notEmpty)
+        {
+            writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+            notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -len)));
+
+            //Only a starvation if the FIFO is still empty once the cached offset is refreshed
+            starved |= !notEmpty;
+
+            //A resize is only requested once the FIFO has been drained
+            if(!notEmpty && adaptive){
+                int8_t requestedLen = atomic_load_explicit(resizeRequestPtr, memory_order_acquire);
+                if(requestedLen != 0){
+                    //Park until the producer has reset the offsets
+                    resizeEpoch++;
+                    atomic_store_explicit(resizeAckPtr, resizeEpoch, memory_order_release);
+                    while(atomic_load_explicit(resizeRequestPtr, memory_order_acquire) != 0){}
+
+                    len = requestedLen;
+                    readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+                    writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+                    notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -len)));
+                    resized = true;
+                }
+            }
+        }
+
+        //The wait for the first block (startup) and a wait which included a resize (the producer drained the FIFO) are not
+        //starvations.  Otherwise the policy would see the consumer go idle after every resize
+        if(starved && !resized && blksTransfered > 0){
+            consumerStarvations++;
+            atomic_store_explicit(consumerStarvationsPtr, consumerStarvations, memory_order_relaxed);
+        }
+
+        //Read from array
+        int readOffset = readOffsetCached;
+        if (readOffset >= len)
+        {
+            readOffset = 0;
+        }
+        else
+        {
+            readOffset++;
+        }
+        copyBlkFromFifo(&readTmp, arrayPtr + readOffset);
+        readOffsetCached = readOffset;
+        //Update Read Ptr
+        atomic_store_explicit(readOffsetPtr, readOffset, memory_order_release);
+
+        #if FIFO_BLK_CONSUME
+            consumeAcc += consumeFifoBlk(&readTmp);
+        #endif
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        :
+        : "rm" (readTmp)
+        :);
+
+        receivedTSC[blksTransfered] = readTSC();
+    }
+
+    #if FIFO_BLK_CONSUME
+        //Need to make sure that the consumer is not optimized out
+        asm volatile(""
+        :
+        : "rm" (consumeAcc)
+        :);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
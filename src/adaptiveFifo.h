@@ -0,0 +1,128 @@
+#ifndef _ADAPTIVE_FIFO_H
+#define _ADAPTIVE_FIFO_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * An experimental Laminar FIFO whose depth can change at runtime.  The array is allocated for ADAPTIVE_FIFO_MAX_LEN_BLKS blocks but
+ * the ring only spans the current depth (len+1 slots) so a shallow FIFO also has a small cache footprint.  Apart from the ring length
+ * being a variable, the offsets work as in the Laminar FIFO.
+ *
+ * The producer (server) runs the depth policy at the end of each window of ADAPTIVE_FIFO_WINDOW_BLKS blocks.  To change the depth:
+ *   1. The producer stops writing and waits for the consumer to drain the FIFO
+ *   2. The producer publishes the new depth in the resize request
+ *   3. The consumer only checks the request while it is waiting on an empty FIFO.  It acknowledges the request and parks until the
+ *      request is cleared
+ *   4. The producer resets both offsets (the read offset is only written by the producer while the consumer is parked) and clears
+ *      the request
+ *   5. The consumer reloads the offsets and continues with the new depth
+ *
+ * The blocks are released on the same schedule as the paced FIFO (see pacedFifo.h) so that the latency of each block can be compared
+ * against FIFOs of a fixed depth
+ */
+
+#ifndef ADAPTIVE_FIFO_MAX_LEN_BLKS
+    #define ADAPTIVE_FIFO_MAX_LEN_BLKS (64)
+#endif
+
+#ifndef ADAPTIVE_FIFO_MIN_LEN_BLKS
+    #define ADAPTIVE_FIFO_MIN_LEN_BLKS (2)
+#endif
+
+//The number of blocks between policy decisions
+#ifndef ADAPTIVE_FIFO_WINDOW_BLKS
+    #define ADAPTIVE_FIFO_WINDOW_BLKS (1024)
+#endif
+
+//The producer samples the occupancy (with a fresh load of the read offset) every ADAPTIVE_FIFO_SAMPLE_BLKS blocks
+#ifndef ADAPTIVE_FIFO_SAMPLE_BLKS
+    #define ADAPTIVE_FIFO_SAMPLE_BLKS (8)
+#endif
+
+//The depth is doubled if more than this percent of the blocks in a window found the FIFO full while the consumer also went idle
+#ifndef ADAPTIVE_FIFO_GROW_STALL_PCT
+    #define ADAPTIVE_FIFO_GROW_STALL_PCT (1)
+#endif
+
+//The depth is halved after this many consecutive windows with no stalls and a peak occupancy of at most a quarter of the depth
+#ifndef ADAPTIVE_FIFO_SHRINK_WINDOWS
+    #define ADAPTIVE_FIFO_SHRINK_WINDOWS (2)
+#endif
+
+//The offsets are int8_t
+_Static_assert(ADAPTIVE_FIFO_MAX_LEN_BLKS < 127, "ADAPTIVE_FIFO_MAX_LEN_BLKS must be < 127");
+_Static_assert(ADAPTIVE_FIFO_MIN_LEN_BLKS >= 1 && ADAPTIVE_FIFO_MIN_LEN_BLKS <= ADAPTIVE_FIFO_MAX_LEN_BLKS, "ADAPTIVE_FIFO_MIN_LEN_BLKS must be in [1, ADAPTIVE_FIFO_MAX_LEN_BLKS]");
+
+typedef struct {
+    int64_t producerStalls; //Blocks which found the FIFO full after refreshing the cached read offset
+    int64_t consumerStarvations; //Blocks which found the FIFO empty after refreshing the cached write offset (not counting the first block or a wait which included a resize)
+    int64_t resizes;
+    int64_t lenBlkSum; //The sum of the depth each block was written with (for the mean depth)
+    int minLen;
+    int maxLen;
+    int finalLen;
+} adaptive_fifo_stats_t;
+
+typedef struct {
+    _Atomic int8_t *readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr; //ADAPTIVE_FIFO_MAX_LEN_BLKS+1 blocks
+    _Atomic int8_t *resizeRequestPtr; //The requested depth, 0 if none.  Written by the producer
+    _Atomic int64_t *resizeAckPtr; //The number of requests acknowledged.  Written by the consumer
+    _Atomic int64_t *consumerStarvationsPtr; //Written by the consumer after a wait on an empty FIFO
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+
+    int initialLenBlks;
+    bool adaptive; //If false, the depth stays at initialLenBlks (a fixed depth baseline)
+
+    //Server only
+    double intervalTSC; //See paced_fifo_threadArgs_t
+    int profile;
+    uint64_t seed;
+    uint64_t *scheduledTSC; //PACED_TRANSACTIONS_BLKS entries
+    adaptive_fifo_stats_t *stats; //Written by the server before it returns
+
+    //Client only
+    uint64_t *receivedTSC; //PACED_TRANSACTIONS_BLKS entries
+} adaptive_fifo_threadArgs_t;
+
+/**
+ * The depth policy.  Called by the producer at the end of each window
+ * @param quietWindows the number of consecutive windows which qualified for shrinking.  Updated by the policy
+ * @returns the new depth (len if unchanged)
+ */
+static inline int adaptiveFifoPolicy(int len, int64_t windowProducerStalls, int64_t windowConsumerStarvations, int peakOccupancy, int *quietWindows){
+    //Stalls only indicate that more buffering would help if the consumer also went idle (the load is bursty rather than above the
+    //consumer's rate)
+    if(windowProducerStalls*100 > ADAPTIVE_FIFO_GROW_STALL_PCT*ADAPTIVE_FIFO_WINDOW_BLKS && windowConsumerStarvations > 0){
+        *quietWindows = 0;
+        return len*2 < ADAPTIVE_FIFO_MAX_LEN_BLKS ? len*2 : ADAPTIVE_FIFO_MAX_LEN_BLKS;
+    }
+
+    if(windowProducerStalls == 0 && peakOccupancy*4 <= len){
+        (*quietWindows)++;
+        if(*quietWindows >= ADAPTIVE_FIFO_SHRINK_WINDOWS){
+            *quietWindows = 0;
+            return len/2 > ADAPTIVE_FIFO_MIN_LEN_BLKS ? len/2 : ADAPTIVE_FIFO_MIN_LEN_BLKS;
+        }
+    }else{
+        *quietWindows = 0;
+    }
+    return len;
+}
+
+/**
+ * Takes adaptive_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *adaptive_fifo_server_thread(void* args);
+
+/**
+ * Takes adaptive_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *adaptive_fifo_client_thread(void* args);
+
+#endif
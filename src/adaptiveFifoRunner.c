@@ -0,0 +1,158 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "adaptiveFifoRunner.h"
+#include "pacedFifoRunner.h"
+#include "laminarFifo.h"
+#include "testParams.h"
+#include "cacheState.h"
+
+static int compareDouble(const void* a, const void* b){
+    double aVal = *((const double*) a);
+    double bVal = *((const double*) b);
+    return (aVal > bVal) - (aVal < bVal);
+}
+
+/**
+ * Nearest rank percentile of a sorted array
+ */
+static double percentile(double* sorted, int64_t len, double pct){
+    int64_t rank = (int64_t) ceil(pct/100.0*len);
+    if(rank < 1){
+        rank = 1;
+    }
+    return sorted[rank-1];
+}
+
+void writeAdaptiveFifoHeader(FILE* reportFile){
+    fprintf(reportFile, "Level,ServerCPU,ClientCPU,Profile,OfferedLoad,Mode,InitialLenBlks,MeanLenBlks,MinLenBlks,MaxLenBlks,FinalLenBlks,Resizes,TargetBytesPerSec,AchievedBytesPerSec,ServerTime,ClientTime,Blks,DeadlineNs,MissedDeadlines,ProducerStalls,ConsumerStarvations,LatencyMeanNs,LatencyP50Ns,LatencyP99Ns,LatencyP999Ns,LatencyMaxNs,CacheState\n");
+}
+
+double runAdaptiveFifoBench(int serverCPU, int clientCPU, const char* level, double targetBytesPerSec, double offeredLoad, int profile,
+                          int initialLenBlks, bool adaptive, FILE* reportFile){
+    if(initialLenBlks < 1 || initialLenBlks > ADAPTIVE_FIFO_MAX_LEN_BLKS){
+        printf("Adaptive FIFO depth must be between 1 and %d (ADAPTIVE_FIFO_MAX_LEN_BLKS) ... exiting\n", ADAPTIVE_FIFO_MAX_LEN_BLKS);
+        exit(1);
+    }
+
+    double tscFreqHz = getTSCFreqHz(); //Calibrate before starting the threads
+    int cpus[2] = {serverCPU, clientCPU};
+
+    //The array is allocated for the maximum depth.  The request and ack are each written by 1 side and placed on its core
+    _Atomic int8_t *readOffsetPtr = (_Atomic int8_t*) laminarAlloc(sizeof(_Atomic int8_t), clientCPU);
+    _Atomic int8_t *writeOffsetPtr = (_Atomic int8_t*) laminarAlloc(sizeof(_Atomic int8_t), serverCPU);
+    PartitionCrossingFIFO_t *arrayPtr = (PartitionCrossingFIFO_t*) laminarAlloc(sizeof(PartitionCrossingFIFO_t)*(ADAPTIVE_FIFO_MAX_LEN_BLKS+1), serverCPU);
+    _Atomic int8_t *resizeRequestPtr = (_Atomic int8_t*) laminarAlloc(sizeof(_Atomic int8_t), serverCPU);
+    _Atomic int64_t *resizeAckPtr = (_Atomic int64_t*) laminarAlloc(sizeof(_Atomic int64_t), clientCPU);
+    _Atomic int64_t *consumerStarvationsPtr = (_Atomic int64_t*) laminarAlloc(sizeof(_Atomic int64_t), clientCPU);
+    atomic_init(readOffsetPtr, 0);
+    atomic_init(writeOffsetPtr, 1);
+    atomic_init(resizeRequestPtr, 0);
+    atomic_init(resizeAckPtr, 0);
+    atomic_init(consumerStarvationsPtr, 0);
+
+    //The timestamp arrays are touched by the arena when allocated so that page faults do not occur durring the timed region
+    uint64_t *scheduledTSC = (uint64_t*) laminarAlloc(sizeof(uint64_t)*PACED_TRANSACTIONS_BLKS, serverCPU);
+    uint64_t *receivedTSC = (uint64_t*) laminarAlloc(sizeof(uint64_t)*PACED_TRANSACTIONS_BLKS, clientCPU);
+    adaptive_fifo_stats_t *stats = (adaptive_fifo_stats_t*) laminarAlloc(sizeof(adaptive_fifo_stats_t), serverCPU);
+
+    laminar_start_barrier_t *barrier = laminarBarrierCreate(cpus, 2);
+
+    double intervalTSC = targetBytesPerSec > 0 ? tscFreqHz*BLK_SIZE_BYTES/targetBytesPerSec : 0;
+
+    adaptive_fifo_threadArgs_t *args[2];
+    for(int i = 0; i<2; i++){
+        args[i] = (adaptive_fifo_threadArgs_t*) laminarAlloc(sizeof(adaptive_fifo_threadArgs_t), cpus[i]);
+        args[i]->readOffsetPtr = readOffsetPtr;
+        args[i]->writeOffsetPtr = writeOffsetPtr;
+        args[i]->arrayPtr = arrayPtr;
+        args[i]->resizeRequestPtr = resizeRequestPtr;
+        args[i]->resizeAckPtr = resizeAckPtr;
+        args[i]->consumerStarvationsPtr = consumerStarvationsPtr;
+        args[i]->startTrigger = barrier->startTrigger;
+        args[i]->readyFlag = barrier->readyFlags[i];
+        args[i]->initialLenBlks = initialLenBlks;
+        args[i]->adaptive = adaptive;
+        args[i]->intervalTSC = intervalTSC;
+        args[i]->profile = profile;
+        args[i]->seed = 0x9E3779B97F4A7C15ULL ^ (((uint64_t) serverCPU) << 32) ^ clientCPU; //The same schedule as the paced FIFO
+        args[i]->scheduledTSC = scheduledTSC;
+        args[i]->stats = stats;
+        args[i]->receivedTSC = receivedTSC;
+    }
+
+    //Set the cache state of the FIFO (see cacheState.h).  Only the slots of the initial depth are part of the ring
+    void* fifoBuffers[3] = {arrayPtr, readOffsetPtr, writeOffsetPtr};
+    size_t fifoBufferSizes[3] = {sizeof(PartitionCrossingFIFO_t)*(initialLenBlks+1), sizeof(_Atomic int8_t), sizeof(_Atomic int8_t)};
+    cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, 3, serverCPU, clientCPU);
+
+    laminarThreadStart(serverCPU, adaptive_fifo_server_thread, args[0]);
+    laminarThreadStart(clientCPU, adaptive_fifo_client_thread, args[1]);
+
+    //Start FIFO transfers once all threads are ready
+    laminarBarrierWaitAllReady(barrier);
+    cacheStateBeforeTrigger(fifoBuffers, fifoBufferSizes, 3);
+    laminarBarrierRelease(barrier);
+
+    //Wait for threads to finish
+    double times[2];
+    for(int i = 0; i<2; i++){
+        double *result = (double*) laminarThreadJoin(cpus[i]);
+        times[i] = *result;
+        free(result);
+    }
+    stats->consumerStarvations = atomic_load_explicit(consumerStarvationsPtr, memory_order_acquire);
+
+    //Compute the latency of each block
+    long long int bytesSent = ((long long int) PACED_TRANSACTIONS_BLKS)*BLK_SIZE_BYTES;
+    double achievedBytesPerSec = bytesSent/times[1];
+    double periodTSC = intervalTSC > 0 ? intervalTSC : tscFreqHz*BLK_SIZE_BYTES/achievedBytesPerSec;
+    double deadlineNs = PACED_DEADLINE_PERIODS*periodTSC/tscFreqHz*1.0e9;
+
+    double *latencyNs = (double*) malloc(sizeof(double)*PACED_TRANSACTIONS_BLKS);
+    double latencySum = 0;
+    int64_t missedDeadlines = 0;
+    for(int64_t blk = 0; blk<PACED_TRANSACTIONS_BLKS; blk++){
+        //The TSC is assumed to be invariant and synchronized across cores.  Clamp in case it is slightly skewed
+        double latency = receivedTSC[blk] > scheduledTSC[blk] ? (receivedTSC[blk] - scheduledTSC[blk])/tscFreqHz*1.0e9 : 0;
+        latencyNs[blk] = latency;
+        latencySum += latency;
+        if(latency > deadlineNs){
+            missedDeadlines++;
+        }
+    }
+    qsort(latencyNs, PACED_TRANSACTIONS_BLKS, sizeof(double), compareDouble);
+
+    //Write results
+    fprintf(reportFile, "%s,%d,%d,%s,%f,%s,%d,%f,%d,%d,%d,%ld,%e,%e,%e,%e,%d,%e,%ld,%ld,%ld,%e,%e,%e,%e,%e,%s\n", level, serverCPU, clientCPU,
+            targetBytesPerSec > 0 ? getPacedProfileName(profile) : "Unpaced", offeredLoad, adaptive ? "Adaptive" : "Fixed", initialLenBlks,
+            ((double) stats->lenBlkSum)/PACED_TRANSACTIONS_BLKS, stats->minLen, stats->maxLen, stats->finalLen, stats->resizes,
+            targetBytesPerSec, achievedBytesPerSec, times[0], times[1], PACED_TRANSACTIONS_BLKS, deadlineNs, missedDeadlines,
+            stats->producerStalls, stats->consumerStarvations, latencySum/PACED_TRANSACTIONS_BLKS, percentile(latencyNs, PACED_TRANSACTIONS_BLKS, 50),
+            percentile(latencyNs, PACED_TRANSACTIONS_BLKS, 99), percentile(latencyNs, PACED_TRANSACTIONS_BLKS, 99.9), latencyNs[PACED_TRANSACTIONS_BLKS-1],
+            getCacheStateName(CACHE_STATE));
+    fflush(reportFile);
+
+    //Cleanup
+    free(latencyNs);
+    laminarBarrierDestroy(barrier);
+    for(int i = 0; i<2; i++){
+        laminarFree(args[i]);
+    }
+    laminarFree(readOffsetPtr);
+    laminarFree(writeOffsetPtr);
+    laminarFree(arrayPtr);
+    laminarFree(resizeRequestPtr);
+    laminarFree(resizeAckPtr);
+    laminarFree(consumerStarvationsPtr);
+    laminarFree(scheduledTSC);
+    laminarFree(receivedTSC);
+    laminarFree(stats);
+
+    return achievedBytesPerSec;
+}
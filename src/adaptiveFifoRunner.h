@@ -0,0 +1,27 @@
+#ifndef _ADAPTIVE_FIFO_RUNNER_H
+#define _ADAPTIVE_FIFO_RUNNER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "adaptiveFifo.h"
+
+/**
+ * Runs an adaptive depth FIFO (see adaptiveFifo.h) from serverCPU to clientCPU with blocks released on a paced schedule and appends a
+ * row to reportFile (see writeAdaptiveFifoHeader)
+ * @param level the name of the topology level the CPUs span (reported in each row)
+ * @param targetBytesPerSec the mean rate at which the server releases blocks.  0 releases blocks as fast as the FIFO allows
+ * @param offeredLoad the fraction of link capacity targetBytesPerSec corresponds to (reported in each row)
+ * @param profile PACED_PROFILE_CONSTANT, PACED_PROFILE_POISSON, or PACED_PROFILE_BURST
+ * @param initialLenBlks the depth the FIFO starts with (1 to ADAPTIVE_FIFO_MAX_LEN_BLKS)
+ * @param adaptive if false, the depth is fixed at initialLenBlks
+ * @returns the rate (bytes/s) achieved by the client
+ */
+double runAdaptiveFifoBench(int serverCPU, int clientCPU, const char* level, double targetBytesPerSec, double offeredLoad, int profile,
+                          int initialLenBlks, bool adaptive, FILE* reportFile);
+
+/**
+ * Writes the header for the rows appended by runAdaptiveFifoBench
+ */
+void writeAdaptiveFifoHeader(FILE* reportFile);
+
+#endif
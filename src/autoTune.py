@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+
+## Searches block size, FIFO depth, and copy engine for each topology relation and emits the recommended
+## FIFO parameters for Laminar code generation.
+##
+## Each point in the search re-builds commCharaterize with the auto-tune probe enabled (runAutoTuneProbe in commCharaterize.c)
+## which runs a single FIFO for each topology relation.  Results are written to:
+##   <name>/recommendation.json: machine readable recommendation (and the full set of measured points)
+##   <name>/laminarFifoRecommendation.h: C header of defines for Laminar code generation
+
+import os
+import subprocess
+import typing
+import argparse
+import platform
+import datetime
+import math
+import json
+import csv
+
+TARGET_BYTES: int = 1000000000
+UNIT_SIZE: int = 4*2 #Complex floats (8 bytes) are the unit described in the FIFO structure
+
+RELATIONS: typing.Final[typing.List[str]] = ['intraL3', 'interL3', 'crossSocket']
+
+COPY_ENGINES: typing.Final[typing.Dict[str, int]] = {'memcpyInline': 0, #Must match FIFO_COPY_ENGINE_* in fifoCopy.h
+                                                     'memcpy': 1,
+                                                     'nonTemporal': 2}
+
+#Need block sizes to be in increments of 256 bits (or 32 bytes, or 4 complex floats)
+DEFAULT_BLK_SIZES: typing.Final[typing.List[int]] = [4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048] #These are in UNIT_SIZE
+#The FIFO offsets are int8_t so FIFO_LEN_BLKS must be <= 126
+DEFAULT_FIFO_LENS: typing.Final[typing.List[int]] = [1, 3, 7, 15, 31, 63]
+
+class ProbePoint:
+    def __init__(self, relation: str, blkSize: int, fifoLen: int, copyEngine: str, bytesTx: int, time: float):
+        self.relation = relation
+        self.blkSize = blkSize
+        self.fifoLen = fifoLen
+        self.copyEngine = copyEngine
+        self.bytesTx = bytesTx
+        self.time = time
+
+    def blkSizeBytes(self) -> int:
+        return self.blkSize*UNIT_SIZE
+
+    def rateGbps(self) -> float:
+        return (self.bytesTx/self.time)*8/1.0e9
+
+    # The worst case latency of a block through the FIFO when it is running at the measured rate.
+    # A block can wait behind FIFO_LEN_BLKS full blocks before it is transferred itself
+    def latencyUs(self) -> float:
+        blkTime = self.blkSizeBytes()/(self.bytesTx/self.time)
+        return (self.fifoLen+1)*blkTime*1.0e6
+
+    def toDict(self) -> typing.Dict:
+        return {'relation': self.relation,
+                'blkSizeCplxFloat': self.blkSize,
+                'blkSizeBytes': self.blkSizeBytes(),
+                'fifoLenBlks': self.fifoLen,
+                'copyEngine': self.copyEngine,
+                'rateGbps': self.rateGbps(),
+                'latencyUs': self.latencyUs()}
+
+def runCmd(cmd: str):
+    print('\nRunning: {}\n'.format(cmd))
+    rtn = subprocess.call(cmd, shell=True, executable='/bin/bash')
+    if rtn != 0:
+        raise RuntimeError(f'Laminar FIFO Auto-Tune Failed - CMD: {cmd} RtnCode: {rtn}')
+
+def readProbe(rptFile: str, relation: str, blkSize: int, fifoLen: int, copyEngine: str) -> ProbePoint:
+    with open(rptFile, 'r') as f:
+        reader = csv.DictReader(f)
+        row = next(reader)
+        #The slower of the two sides limits the rate
+        time = max(float(row['ServerTime']), float(row['ClientTime']))
+        return ProbePoint(relation, blkSize, fifoLen, copyEngine, int(row['BytesTx']), time)
+
+def selectPoint(points: typing.List[ProbePoint], latencyBudgetUs: float, throughputGbps: float) -> typing.Tuple[typing.Optional[ProbePoint], bool]:
+    feasible = [p for p in points if p.latencyUs() <= latencyBudgetUs and p.rateGbps() >= throughputGbps]
+    if len(feasible) > 0:
+        #Prefer the lowest latency, then the smallest footprint (which leaves the most L2 for the partition's own state), then the highest rate
+        best = min(feasible, key=lambda p: (p.latencyUs(), p.blkSizeBytes()*(p.fifoLen+1), -p.rateGbps()))
+        return (best, True)
+
+    #Nothing meets both targets, report the highest rate point within the latency budget (or overall if none meet the budget)
+    inBudget = [p for p in points if p.latencyUs() <= latencyBudgetUs]
+    candidates = inBudget if len(inBudget) > 0 else points
+    if len(candidates) == 0:
+        return (None, False)
+    return (max(candidates, key=lambda p: p.rateGbps()), False)
+
+def writeHeader(filename: str, selected: typing.Dict[str, typing.Tuple[typing.Optional[ProbePoint], bool]], hostname: str, latencyBudgetUs: float, throughputGbps: float):
+    with open(filename, 'w') as f:
+        f.write('#ifndef _LAMINAR_FIFO_RECOMMENDATION_H\n')
+        f.write('#define _LAMINAR_FIFO_RECOMMENDATION_H\n\n')
+        f.write(f'//Generated by laminarCommCharacterize autoTune.py\n')
+        f.write(f'//Host: {hostname}\n')
+        f.write(f'//Time: {datetime.datetime.now()}\n')
+        f.write(f'//Latency Budget: {latencyBudgetUs} us, Throughput Target: {throughputGbps} Gbps\n\n')
+        f.write('#define LAMINAR_FIFO_COPY_ENGINE_MEMCPY_INLINE (0)\n')
+        f.write('#define LAMINAR_FIFO_COPY_ENGINE_MEMCPY (1)\n')
+        f.write('#define LAMINAR_FIFO_COPY_ENGINE_NON_TEMPORAL (2)\n\n')
+        for relation, (point, feasible) in selected.items():
+            if point is None:
+                continue
+            prefix = f'LAMINAR_FIFO_{relation.upper()}'
+            f.write(f'//{relation}: {point.rateGbps():.3f} Gbps, {point.latencyUs():.3f} us worst case latency{"" if feasible else " (DOES NOT MEET TARGETS)"}\n')
+            f.write(f'#define {prefix}_MEETS_TARGETS ({1 if feasible else 0})\n')
+            f.write(f'#define {prefix}_BLK_SIZE_CPLX_FLOAT ({point.blkSize})\n')
+            f.write(f'#define {prefix}_BLK_SIZE_BYTES ({point.blkSizeBytes()})\n')
+            f.write(f'#define {prefix}_FIFO_LEN_BLKS ({point.fifoLen})\n')
+            f.write(f'#define {prefix}_COPY_ENGINE (LAMINAR_FIFO_COPY_ENGINE_{"MEMCPY_INLINE" if point.copyEngine == "memcpyInline" else ("MEMCPY" if point.copyEngine == "memcpy" else "NON_TEMPORAL")})\n\n')
+        f.write('#endif\n')
+
+def main():
+    parser = argparse.ArgumentParser(description='Searches FIFO parameters and emits a recommendation for Laminar code generation')
+    parser.add_argument('--name', type=str, required=True, help='The directory in which the results and recommendation will be placed')
+    parser.add_argument('--relations', type=str, nargs='+', default=RELATIONS, choices=RELATIONS, help='The topology relations to tune for')
+    parser.add_argument('--latency-budget-us', type=float, required=True, help='The maximum worst case latency of a block through the FIFO (us)')
+    parser.add_argument('--throughput-gbps', type=float, required=True, help='The minimum throughput of the FIFO (Gbps)')
+    parser.add_argument('--blk-sizes', type=int, nargs='+', default=DEFAULT_BLK_SIZES, help='Block sizes to search (in complex floats, multiples of 4)')
+    parser.add_argument('--fifo-lens', type=int, nargs='+', default=DEFAULT_FIFO_LENS, help='FIFO depths to search (in blocks, <= 126)')
+    parser.add_argument('--copy-engines', type=str, nargs='+', default=list(COPY_ENGINES.keys()), choices=list(COPY_ENGINES.keys()), help='Copy engines to search')
+    args = parser.parse_args()
+    name = args.name
+
+    for blkSize in args.blk_sizes:
+        if blkSize % 4 != 0:
+            raise ValueError(f'Block size {blkSize} is not a multiple of 4 complex floats')
+    for fifoLen in args.fifo_lens:
+        if fifoLen < 1 or fifoLen > 126:
+            raise ValueError(f'FIFO length {fifoLen} must be in [1, 126]')
+
+    hostname = platform.node()
+
+    if os.path.exists(name):
+        raise ValueError(f'File/Directory {name} already exists')
+
+    os.mkdir(name)
+
+    points: typing.Dict[str, typing.List[ProbePoint]] = {relation: [] for relation in args.relations}
+
+    for copyEngine in args.copy_engines:
+        for fifoLen in args.fifo_lens:
+            for blkSize in args.blk_sizes:
+                blkSizeBytes = blkSize*UNIT_SIZE
+                blockTransactions = math.ceil(TARGET_BYTES/float(blkSizeBytes))
+
+                rptDir = os.path.join(name, f'copyEngine{copyEngine}_fifoLen{fifoLen:d}_blkSizeBytes{blkSizeBytes:d}')
+                rptPrefix = os.path.join(rptDir, 'report')
+
+                runCmd(f'FIFO_BLK_SIZE_CPLX_FLOAT={blkSize:d} TRANSACTIONS_BLKS={blockTransactions:d} FIFO_LEN_BLKS={fifoLen:d} FIFO_COPY_ENGINE={COPY_ENGINES[copyEngine]:d} AUTOTUNE_TESTS=1 FIFO_TESTS=0 MEM_TESTS=0 ./build.sh')
+                os.mkdir(rptDir)
+                runCmd(f'./commCharaterize {rptPrefix}')
+
+                for relation in args.relations:
+                    rptFile = f'{rptPrefix}_autoTune_{relation}.csv'
+                    if os.path.isfile(rptFile):
+                        points[relation].append(readProbe(rptFile, relation, blkSize, fifoLen, copyEngine))
+
+    #Collect the build artifacts from the last build
+    runCmd(f'./collectResults.sh {name}')
+
+    selected = {}
+    recommendation = {'host': hostname,
+                      'time': str(datetime.datetime.now()),
+                      'latencyBudgetUs': args.latency_budget_us,
+                      'throughputGbps': args.throughput_gbps,
+                      'relations': {},
+                      'points': []}
+    for relation in args.relations:
+        if len(points[relation]) == 0:
+            print(f'Warning: No results for {relation} (the core map may not include this relation)')
+            continue
+        (point, feasible) = selectPoint(points[relation], args.latency_budget_us, args.throughput_gbps)
+        selected[relation] = (point, feasible)
+        recommendation['relations'][relation] = {'meetsTargets': feasible, **point.toDict()}
+        recommendation['points'].extend([p.toDict() for p in points[relation]])
+        print(f'{relation}: {"Meets Targets" if feasible else "DOES NOT MEET TARGETS"} {point.toDict()}')
+
+    with open(os.path.join(name, 'recommendation.json'), 'w') as f:
+        json.dump(recommendation, f, indent=4)
+
+    writeHeader(os.path.join(name, 'laminarFifoRecommendation.h'), selected, hostname, args.latency_budget_us, args.throughput_gbps)
+
+if __name__ == "__main__":
+    main()
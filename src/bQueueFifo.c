@@ -0,0 +1,194 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include "bQueueFifo.h"
+#include "timeHelpers.h"
+#include "testParams.h"
+#include "bufferArena.h"
+
+static void* b_queue_init(int serverCore, int clientCore){
+    b_queue_fifo_t *fifo = (b_queue_fifo_t*) bufferArenaAlloc(sizeof(b_queue_fifo_t), serverCore);
+    fifo->slots = (b_queue_slot_t*) bufferArenaAlloc(sizeof(b_queue_slot_t)*SPSC_FIFO_SLOTS, serverCore);
+
+    for(int i = 0; i<SPSC_FIFO_SLOTS; i++){
+        atomic_init(&(fifo->slots[i].full), 0);
+    }
+    if(!atomic_is_lock_free(&(fifo->slots[0].full))){
+        printf("Warning: A B-Queue slot flag was expected to be lock free but is not\n");
+    }
+
+    return fifo;
+}
+
+static void b_queue_cleanup(void* fifo_uncast){
+    b_queue_fifo_t *fifo = (b_queue_fifo_t*) fifo_uncast;
+    bufferArenaFree(fifo->slots);
+    bufferArenaFree(fifo);
+}
+
+static int b_queue_get_buffers(void* fifo_uncast, void** buffers, size_t* sizes){
+    b_queue_fifo_t *fifo = (b_queue_fifo_t*) fifo_uncast;
+    buffers[0] = fifo->slots;
+    sizes[0] = sizeof(b_queue_slot_t)*SPSC_FIFO_SLOTS;
+    return 1;
+}
+
+static void *b_queue_server_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    b_queue_fifo_t *fifo = (b_queue_fifo_t*) args_cast->fifo;
+    b_queue_slot_t *slots = fifo->slots;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    int head = 0; //Private to the producer
+    int avail = 0; //Number of slots starting at head known to be empty
+    PartitionCrossingFIFO_t writeTmp;
+    memset(&writeTmp, 0, sizeof(PartitionCrossingFIFO_t));
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "=rm" (writeTmp)
+        : 
+        :);
+
+        //When the known empty slots are used up, probe ahead for a batch of empty slots.
+        //If the consumer has not freed the whole batch yet, backtrack to smaller batches
+        if(avail == 0){
+            int batch = B_QUEUE_BATCH;
+            while(true){
+                int probe = head+batch-1;
+                probe = probe >= SPSC_FIFO_SLOTS ? probe-SPSC_FIFO_SLOTS : probe;
+                if(!atomic_load_explicit(&(slots[probe].full), memory_order_acquire)){
+                    avail = batch;
+                    break;
+                }
+                batch = batch > 1 ? batch/2 : 1;
+            }
+        }
+
+        copyBlkToFifo(&(slots[head].blk), &writeTmp);
+        atomic_store_explicit(&(slots[head].full), 1, memory_order_release);
+
+        head = head >= SPSC_FIFO_SLOTS-1 ? 0 : head+1;
+        avail--;
+    }
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+static void *b_queue_client_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    b_queue_fifo_t *fifo = (b_queue_fifo_t*) args_cast->fifo;
+    b_queue_slot_t *slots = fifo->slots;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    int tail = 0; //Private to the consumer
+    int avail = 0; //Number of slots starting at tail known to be full
+    PartitionCrossingFIFO_t readTmp;
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //When the known full slots are used up, probe ahead for a batch of full slots.
+        //If the producer has not filled the whole batch yet, backtrack to smaller batches
+        if(avail == 0){
+            int batch = B_QUEUE_BATCH;
+            while(true){
+                int probe = tail+batch-1;
+                probe = probe >= SPSC_FIFO_SLOTS ? probe-SPSC_FIFO_SLOTS : probe;
+                if(atomic_load_explicit(&(slots[probe].full), memory_order_acquire)){
+                    avail = batch;
+                    break;
+                }
+                batch = batch > 1 ? batch/2 : 1;
+            }
+        }
+
+        copyBlkFromFifo(&readTmp, &(slots[tail].blk));
+        atomic_store_explicit(&(slots[tail].full), 0, memory_order_release);
+
+        tail = tail >= SPSC_FIFO_SLOTS-1 ? 0 : tail+1;
+        avail--;
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        :
+        : "rm" (readTmp)
+        :);
+    }
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+const spsc_fifo_impl_t B_QUEUE_FIFO_IMPL = {
+    .name = "bQueue",
+    .init = b_queue_init,
+    .cleanup = b_queue_cleanup,
+    .getBuffers = b_queue_get_buffers,
+    .server_thread = b_queue_server_thread,
+    .client_thread = b_queue_client_thread
+};
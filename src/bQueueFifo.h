@@ -0,0 +1,31 @@
+#ifndef _B_QUEUE_FIFO_H
+#define _B_QUEUE_FIFO_H
+
+#include "spscFifoCommon.h"
+#include "testParams.h"
+
+/*
+ * B-Queue (Wang et al., IJPP 2013)
+ * Like FastForward, each slot carries a full flag and there are no shared indices.  Rather than checking the flag of each slot,
+ * each side probes the flag B_QUEUE_BATCH_BLKS slots ahead and, if the whole batch is available, proceeds through it without checking.
+ * If the batch is not available, the probe backtracks to smaller batches.
+ */
+
+#ifndef B_QUEUE_BATCH_BLKS
+    #define B_QUEUE_BATCH_BLKS (8)
+#endif
+
+#define B_QUEUE_BATCH (B_QUEUE_BATCH_BLKS < FIFO_LEN_BLKS ? B_QUEUE_BATCH_BLKS : FIFO_LEN_BLKS)
+
+typedef struct {
+    PartitionCrossingFIFO_t blk;
+    _Atomic int32_t full __attribute__((aligned(VITIS_MEM_ALIGNMENT))); //On its own line after the block
+} b_queue_slot_t;
+
+typedef struct {
+    b_queue_slot_t *slots; //SPSC_FIFO_SLOTS, allocated on the server core
+} b_queue_fifo_t;
+
+extern const spsc_fifo_impl_t B_QUEUE_FIFO_IMPL;
+
+#endif
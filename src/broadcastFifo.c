@@ -0,0 +1,242 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include "broadcastFifo.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
+#include "timeHelpers.h"
+#include "testParams.h"
+#include "bufferArena.h"
+
+//The producer's state for one output ring
+typedef struct {
+    broadcast_ring_t *ring;
+    int8_t writeOffsetCached;
+    int8_t readOffsetCached[BROADCAST_MAX_READERS]; //Only used if BROADCAST_READER_CACHE_PER_READER
+    int freeBlksCached; //Only used if BROADCAST_READER_CACHE_MIN_SPACE
+} broadcast_ring_writer_t;
+
+broadcast_ring_t* initBroadcastRing(int producerCore, int* readerCores, int numReaders){
+    if(numReaders < 1 || numReaders > BROADCAST_MAX_READERS){
+        printf("Broadcast ring must have between 1 and %d readers (BROADCAST_MAX_READERS), got %d ... exiting\n", BROADCAST_MAX_READERS, numReaders);
+        exit(1);
+    }
+
+    broadcast_ring_t *ring = (broadcast_ring_t*) bufferArenaAlloc(sizeof(broadcast_ring_t), producerCore);
+    ring->producerCore = producerCore;
+    ring->numReaders = numReaders;
+    ring->writeOffsetPtr = (_Atomic int8_t*) bufferArenaAlloc(sizeof(_Atomic int8_t), producerCore);
+    ring->array = (PartitionCrossingFIFO_t*) bufferArenaAlloc(sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1), producerCore); //An additional block (for empty/full ambiguity resolution)
+
+    //Init Ptrs (will not have any initial state in the ring)
+    atomic_init(ring->writeOffsetPtr, 1);
+    for(int i = 0; i<numReaders; i++){
+        ring->readOffsetPtrs[i] = (_Atomic int8_t*) bufferArenaAlloc(sizeof(_Atomic int8_t), readerCores[i]);
+        atomic_init(ring->readOffsetPtrs[i], 0);
+    }
+    if(!atomic_is_lock_free(ring->writeOffsetPtr)){
+        printf("Warning: An atomic broadcast ring offset was expected to be lock free but is not\n");
+    }
+
+    return ring;
+}
+
+void cleanupBroadcastRing(broadcast_ring_t* ring){
+    for(int i = 0; i<ring->numReaders; i++){
+        bufferArenaFree(ring->readOffsetPtrs[i]);
+    }
+    bufferArenaFree(ring->writeOffsetPtr);
+    bufferArenaFree(ring->array);
+    bufferArenaFree(ring);
+}
+
+const char* getBroadcastReaderCacheName(){
+    #if BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_NONE
+        return "None";
+    #elif BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_PER_READER
+        return "PerReader";
+    #elif BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_MIN_SPACE
+        return "MinSpace";
+    #else
+        #error Unknown BROADCAST_READER_CACHE
+    #endif
+}
+
+static inline int broadcastFreeBlks(int8_t readOffset, int8_t writeOffset){
+    int freeBlks = readOffset - writeOffset;
+    return freeBlks < 0 ? freeBlks + FIFO_LEN_BLKS+1 : freeBlks;
+}
+
+/**
+ * Checks if every reader has consumed the slot at the write offset, refreshing the producer's view of the reader offsets as needed
+ */
+static inline bool broadcastRingNotFull(broadcast_ring_writer_t *writer){
+    broadcast_ring_t *ring = writer->ring;
+
+    #if BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_NONE
+        for(int r = 0; r<ring->numReaders; r++){
+            if(atomic_load_explicit(ring->readOffsetPtrs[r], memory_order_acquire) == writer->writeOffsetCached){
+                return false;
+            }
+        }
+        return true;
+    #elif BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_PER_READER
+        for(int r = 0; r<ring->numReaders; r++){
+            if(writer->readOffsetCached[r] == writer->writeOffsetCached){
+                writer->readOffsetCached[r] = atomic_load_explicit(ring->readOffsetPtrs[r], memory_order_acquire);
+                if(writer->readOffsetCached[r] == writer->writeOffsetCached){
+                    return false;
+                }
+            }
+        }
+        return true;
+    #elif BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_MIN_SPACE
+        if(writer->freeBlksCached == 0){
+            int minFreeBlks = FIFO_LEN_BLKS;
+            for(int r = 0; r<ring->numReaders; r++){
+                int freeBlks = broadcastFreeBlks(atomic_load_explicit(ring->readOffsetPtrs[r], memory_order_acquire), writer->writeOffsetCached);
+                minFreeBlks = freeBlks < minFreeBlks ? freeBlks : minFreeBlks;
+            }
+            writer->freeBlksCached = minFreeBlks;
+        }
+        return writer->freeBlksCached > 0;
+    #else
+        #error Unknown BROADCAST_READER_CACHE
+    #endif
+}
+
+void *broadcast_fifo_thread(void* args){
+    broadcast_fifo_threadArgs_t *args_cast = (broadcast_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    broadcast_ring_t *inRing = args_cast->inRing;
+    int numOutRings = args_cast->numOutRings;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+
+    //==== Setup Input Ring ====
+    _Atomic int8_t *inReadOffsetPtr = NULL;
+    _Atomic int8_t *inWriteOffsetPtr = NULL;
+    PartitionCrossingFIFO_t *inArray = NULL;
+    int8_t inReadOffsetCached = 0;
+    int8_t inWriteOffsetCached = 0;
+    if(inRing != NULL){
+        inReadOffsetPtr = inRing->readOffsetPtrs[args_cast->inReader];
+        inWriteOffsetPtr = inRing->writeOffsetPtr;
+        inArray = inRing->array;
+        inReadOffsetCached = atomic_load_explicit(inReadOffsetPtr, memory_order_acquire);
+        inWriteOffsetCached = atomic_load_explicit(inWriteOffsetPtr, memory_order_acquire);
+    }
+
+    //==== Setup Output Rings ====
+    broadcast_ring_writer_t writers[BROADCAST_MAX_OUT_RINGS];
+    for(int i = 0; i<numOutRings; i++){
+        writers[i].ring = args_cast->outRings[i];
+        writers[i].writeOffsetCached = atomic_load_explicit(writers[i].ring->writeOffsetPtr, memory_order_acquire);
+        for(int r = 0; r<writers[i].ring->numReaders; r++){
+            writers[i].readOffsetCached[r] = atomic_load_explicit(writers[i].ring->readOffsetPtrs[r], memory_order_acquire);
+        }
+        writers[i].freeBlksCached = 0;
+    }
+
+    //==== Init temps ====
+    PartitionCrossingFIFO_t writeTmp; //Source of the blocks if this thread is the producer
+    memset(&writeTmp, 0, sizeof(PartitionCrossingFIFO_t));
+    PartitionCrossingFIFO_t readTmp; //Destination of the blocks if this thread is a consumer
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        PartitionCrossingFIFO_t *src = &writeTmp;
+
+        if(inRing != NULL){
+            //Wait for the input ring to be ready
+            bool inputReady = false;
+            while(!inputReady){
+                inputReady = !((inWriteOffsetCached - inReadOffsetCached == 1) || (inWriteOffsetCached - inReadOffsetCached == -FIFO_LEN_BLKS));
+                if(!inputReady){
+                    inWriteOffsetCached = atomic_load_explicit(inWriteOffsetPtr, memory_order_acquire);
+                    inputReady = !((inWriteOffsetCached - inReadOffsetCached == 1) || (inWriteOffsetCached - inReadOffsetCached == -FIFO_LEN_BLKS));
+                }
+            }
+
+            //The read offset is not published until the block has been forwarded into all output rings
+            inReadOffsetCached = inReadOffsetCached >= FIFO_LEN_BLKS ? 0 : inReadOffsetCached+1;
+            src = inArray + inReadOffsetCached;
+        }else{
+            //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+            asm volatile(""
+            : "=rm" (writeTmp)
+            :
+            :);
+        }
+
+        //Wait for the output rings to be ready (every reader of each ring has consumed the slot)
+        bool outputsReady = false;
+        while(!outputsReady){
+            outputsReady = true;
+            for(int i = 0; i<numOutRings; i++){
+                outputsReady &= broadcastRingNotFull(writers+i);
+            }
+        }
+
+        //Write output ring(s).  A relay forwards the block directly from its input ring
+        for(int i = 0; i<numOutRings; i++){
+            int8_t writeOffset = writers[i].writeOffsetCached;
+            copyBlkToFifo(writers[i].ring->array + writeOffset, src);
+            fifoProducerHint(writers[i].ring->array + writeOffset);
+            writeOffset = writeOffset >= FIFO_LEN_BLKS ? 0 : writeOffset+1;
+            writers[i].writeOffsetCached = writeOffset;
+            #if BROADCAST_READER_CACHE == BROADCAST_READER_CACHE_MIN_SPACE
+                writers[i].freeBlksCached--;
+            #endif
+            //Update Write Ptr
+            atomic_store_explicit(writers[i].ring->writeOffsetPtr, writeOffset, memory_order_release);
+        }
+
+        if(inRing != NULL){
+            if(numOutRings == 0){
+                copyBlkFromFifo(&readTmp, src);
+            }
+            //Update Read Ptr
+            atomic_store_explicit(inReadOffsetPtr, inReadOffsetCached, memory_order_release);
+
+            //Need to make sure that the memory copy is not optimized out if the content is not checked
+            asm volatile(""
+            :
+            : "rm" (readTmp)
+            :);
+        }
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
@@ -0,0 +1,72 @@
+#ifndef _BROADCAST_FIFO_H
+#define _BROADCAST_FIFO_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * A single producer, multiple consumer broadcast ring.  Every reader receives every block.
+ *
+ * The ring has a single data array (FIFO_LEN_BLKS+1 blocks) and write offset (allocated on the producer core) and one read offset per
+ * reader (each allocated on its reader's core).  The offsets follow the Laminar FIFO convention: the ring is empty for a reader when its
+ * read offset is 1 behind the write offset and is full when any reader's read offset equals the write offset.  The producer therefore
+ * waits for the slowest reader.
+ */
+
+#ifndef BROADCAST_MAX_READERS
+    #define BROADCAST_MAX_READERS (64)
+#endif
+
+#ifndef BROADCAST_MAX_OUT_RINGS
+    #define BROADCAST_MAX_OUT_RINGS (64)
+#endif
+
+//How the producer caches its view of the reader offsets
+#define BROADCAST_READER_CACHE_NONE (0) //Load every reader's offset before each write
+#define BROADCAST_READER_CACHE_PER_READER (1) //Keep a cached copy of each reader's offset.  Only reload the offsets of readers which appear to block the write (as the Laminar FIFO does for its single reader)
+#define BROADCAST_READER_CACHE_MIN_SPACE (2) //Keep a count of the free slots of the slowest reader.  Reload all reader offsets only once the count reaches 0
+
+#ifndef BROADCAST_READER_CACHE
+    #define BROADCAST_READER_CACHE BROADCAST_READER_CACHE_PER_READER
+#endif
+
+_Static_assert(FIFO_LEN_BLKS+1 <= INT8_MAX, "Broadcast ring offsets are int8_t");
+
+typedef struct {
+    int producerCore;
+    int numReaders;
+    _Atomic int8_t *writeOffsetPtr; //Allocated on the producer core
+    _Atomic int8_t *readOffsetPtrs[BROADCAST_MAX_READERS]; //Each allocated on its reader's core
+    PartitionCrossingFIFO_t *array; //FIFO_LEN_BLKS+1 blocks allocated on the producer core
+} broadcast_ring_t;
+
+typedef struct {
+    broadcast_ring_t *inRing; //The ring this thread reads from (NULL for the producer)
+    int inReader; //The index of this thread's read offset in inRing
+    broadcast_ring_t *outRings[BROADCAST_MAX_OUT_RINGS]; //The rings this thread writes each block into.  A relay forwards each block it reads
+    int numOutRings; //0 for a consumer
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+} broadcast_fifo_threadArgs_t;
+
+/**
+ * Allocates a broadcast ring written by producerCore and read by each core in readerCores
+ */
+broadcast_ring_t* initBroadcastRing(int producerCore, int* readerCores, int numReaders);
+
+void cleanupBroadcastRing(broadcast_ring_t* ring);
+
+/**
+ * Producer, relay, or consumer of broadcast rings depending on the rings in the args (broadcast_fifo_threadArgs_t)
+ * @returns a malloc-ed double with the duration
+ */
+void *broadcast_fifo_thread(void* args);
+
+/**
+ * Gets the name of the producer's reader offset cache policy (BROADCAST_READER_CACHE)
+ */
+const char* getBroadcastReaderCacheName();
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "broadcastFifoRunner.h"
+#include "testParams.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "vitisNumaAllocHelpers.h"
+#include "topologyHelpers.h"
+#include "cacheState.h"
+
+static atomic_flag* initReadyFlag(int core){
+    atomic_flag *flag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), core);
+    atomic_signal_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(flag, memory_order_release); //Init since this was malloc-ed
+    atomic_flag_test_and_set_explicit(flag, memory_order_acq_rel);
+    return flag;
+}
+
+static int findOrAddCPU(int *cpus, int *numCPUs, int cpu){
+    for(int i = 0; i<*numCPUs; i++){
+        if(cpus[i] == cpu){
+            return i;
+        }
+    }
+    cpus[*numCPUs] = cpu;
+    (*numCPUs)++;
+    return *numCPUs-1;
+}
+
+static const char* getBroadcastRole(broadcast_fifo_threadArgs_t *args){
+    if(args->inRing == NULL){
+        return "Producer";
+    }
+    return args->numOutRings > 0 ? "Relay" : "Consumer";
+}
+
+void runBroadcastFifoBench(broadcast_ring_desc_t *rings, int numRings, const char* configName, char* reportFilename){
+    //Find the threads (each CPU named in the rings)
+    int maxThreads = numRings*(BROADCAST_MAX_READERS+1);
+    int cpus[maxThreads];
+    int numThreads = 0;
+    for(int i = 0; i<numRings; i++){
+        findOrAddCPU(cpus, &numThreads, rings[i].producerCPU);
+        for(int r = 0; r<rings[i].numReaders; r++){
+            findOrAddCPU(cpus, &numThreads, rings[i].readerCPUs[r]);
+        }
+    }
+
+    //Create rings
+    broadcast_ring_t *ringPtrs[numRings];
+    for(int i = 0; i<numRings; i++){
+        ringPtrs[i] = initBroadcastRing(rings[i].producerCPU, rings[i].readerCPUs, rings[i].numReaders);
+    }
+
+    //Create thread args
+    broadcast_fifo_runner_thread_vars_t *threadVars[numThreads];
+    atomic_flag *readyFlags[numThreads];
+    for(int t = 0; t<numThreads; t++){
+        threadVars[t] = (broadcast_fifo_runner_thread_vars_t*) bufferArenaAlloc(sizeof(broadcast_fifo_runner_thread_vars_t), cpus[t]);
+        threadVars[t]->core = cpus[t];
+        threadVars[t]->args.inRing = NULL;
+        threadVars[t]->args.inReader = 0;
+        threadVars[t]->args.numOutRings = 0;
+        readyFlags[t] = initReadyFlag(cpus[t]);
+        threadVars[t]->args.readyFlag = readyFlags[t];
+    }
+    for(int i = 0; i<numRings; i++){
+        broadcast_fifo_threadArgs_t *producerArgs = &(threadVars[findOrAddCPU(cpus, &numThreads, rings[i].producerCPU)]->args);
+        if(producerArgs->numOutRings >= BROADCAST_MAX_OUT_RINGS){
+            printf("CPU %d writes more than %d broadcast rings (BROADCAST_MAX_OUT_RINGS) ... exiting\n", rings[i].producerCPU, BROADCAST_MAX_OUT_RINGS);
+            exit(1);
+        }
+        producerArgs->outRings[producerArgs->numOutRings] = ringPtrs[i];
+        producerArgs->numOutRings++;
+
+        for(int r = 0; r<rings[i].numReaders; r++){
+            broadcast_fifo_threadArgs_t *readerArgs = &(threadVars[findOrAddCPU(cpus, &numThreads, rings[i].readerCPUs[r])]->args);
+            if(readerArgs->inRing != NULL){
+                printf("CPU %d reads more than 1 broadcast ring ... exiting\n", rings[i].readerCPUs[r]);
+                exit(1);
+            }
+            readerArgs->inRing = ringPtrs[i];
+            readerArgs->inReader = r;
+        }
+    }
+
+    //Set the cache state of the rings (see cacheState.h).  Each reader is a consumer of its ring
+    void* ringBuffers[numRings][BROADCAST_MAX_READERS+2];
+    size_t ringBufferSizes[numRings][BROADCAST_MAX_READERS+2];
+    for(int i = 0; i<numRings; i++){
+        ringBuffers[i][0] = ringPtrs[i]->array;
+        ringBufferSizes[i][0] = sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1);
+        ringBuffers[i][1] = ringPtrs[i]->writeOffsetPtr;
+        ringBufferSizes[i][1] = sizeof(_Atomic int8_t);
+        for(int r = 0; r<ringPtrs[i]->numReaders; r++){
+            ringBuffers[i][r+2] = ringPtrs[i]->readOffsetPtrs[r];
+            ringBufferSizes[i][r+2] = sizeof(_Atomic int8_t);
+        }
+        for(int r = 0; r<ringPtrs[i]->numReaders; r++){
+            cacheStateBeforeStart(ringBuffers[i], ringBufferSizes[i], ringPtrs[i]->numReaders+2, rings[i].producerCPU, rings[i].readerCPUs[r]);
+        }
+    }
+
+    //Create starting trigger
+    _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, false, memory_order_release);
+
+    //Start Threads
+    for(int t = 0; t<numThreads; t++){
+        threadVars[t]->args.startTrigger = startTrigger;
+        workerPoolSubmit(cpus[t], broadcast_fifo_thread, &(threadVars[t]->args));
+    }
+
+    //Wait for all threads ready
+    for(int t = 0; t<numThreads; t++){
+        bool wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(readyFlags[t], memory_order_acq_rel);
+        }
+    }
+
+    for(int i = 0; i<numRings; i++){
+        cacheStateBeforeTrigger(ringBuffers[i], ringBufferSizes[i], ringPtrs[i]->numReaders+2);
+    }
+
+    //Start FIFO transfers
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, true, memory_order_release);
+
+    //Wait for threads to finish
+    double times[numThreads];
+    for(int t = 0; t<numThreads; t++){
+        double *result = (double*) workerPoolJoin(cpus[t]);
+        times[t] = *result;
+        free(result);
+    }
+
+    //Write results
+    FILE *resultsFile = fopen(reportFilename, "w");
+    fprintf(resultsFile, "Config,Role,CPU,UpstreamCPU,OutRings,OutReaders,Time,BytesRx,BytesTx,CacheState,ReaderCache,Level\n");
+    long long int bytesPerRing = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    for(int t = 0; t<numThreads; t++){
+        broadcast_fifo_threadArgs_t *args = &(threadVars[t]->args);
+        int outReaders = 0;
+        for(int i = 0; i<args->numOutRings; i++){
+            outReaders += args->outRings[i]->numReaders;
+        }
+        fprintf(resultsFile, "%s,%s,%d,%d,%d,%d,%e,%lld,%lld,%s,%s,%s\n", configName, getBroadcastRole(args), cpus[t],
+                args->inRing == NULL ? -1 : args->inRing->producerCore, args->numOutRings, outReaders, times[t],
+                args->inRing == NULL ? 0 : bytesPerRing, bytesPerRing*args->numOutRings, getCacheStateName(CACHE_STATE), getBroadcastReaderCacheName(),
+                args->inRing == NULL ? "NA" : getTopologyLevelName(getTopologyLevel(args->inRing->producerCore, cpus[t])));
+    }
+    fclose(resultsFile);
+
+    //Cleanup
+    for(int t = 0; t<numThreads; t++){
+        bufferArenaFree(readyFlags[t]);
+        bufferArenaFree(threadVars[t]);
+    }
+    for(int i = 0; i<numRings; i++){
+        cleanupBroadcastRing(ringPtrs[i]);
+    }
+    free(startTrigger);
+}
@@ -0,0 +1,32 @@
+#ifndef _BROADCAST_FIFO_RUNNER_H
+#define _BROADCAST_FIFO_RUNNER_H
+
+#include "broadcastFifo.h"
+
+typedef struct {
+    int producerCPU;
+    int numReaders;
+    int readerCPUs[BROADCAST_MAX_READERS];
+} broadcast_ring_desc_t;
+
+typedef struct {
+    int core; //The worker pool core the thread runs on
+    broadcast_fifo_threadArgs_t args;
+} broadcast_fifo_runner_thread_vars_t;
+
+/**
+ * Runs a set of broadcast rings with the same harness (pinned worker threads, start trigger) as runLaminarFifoBench.
+ *
+ * A thread is started on each CPU named in the rings.  A CPU may write any number of rings but may read at most one.  A CPU which
+ * reads one ring and writes others is a relay and forwards each block it reads.  Every thread transacts TRANSACTIONS_BLKS blocks.
+ *
+ * Separate FIFOs from 1 producer to N consumers are described as N rings with 1 reader each.
+ *
+ * @param rings the rings to create
+ * @param numRings the number of rings
+ * @param configName the name of the configuration (reported in each row)
+ * @param reportFilename
+ */
+void runBroadcastFifoBench(broadcast_ring_desc_t *rings, int numRings, const char* configName, char* reportFilename);
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sched.h>
+#include <x86intrin.h>
+#include "bufferArena.h"
+#include "workerPool.h"
+#include "testParams.h"
+
+#define CACHE_LINE_SIZE (64)
+
+typedef struct {
+    void* ptr;
+    size_t size;
+    int node;
+    bool inUse;
+} buffer_arena_entry_t;
+
+typedef struct {
+    void* ptr;
+    size_t size;
+} buffer_arena_job_t;
+
+static buffer_arena_entry_t *arenaEntries = NULL;
+static int arenaEntriesLen = 0;
+static int arenaEntriesCapacity = 0;
+
+int getCoreNumaNode(int core){
+    static int coreNodes[CPU_SETSIZE];
+    static bool coreNodesValid[CPU_SETSIZE] = {false};
+
+    if(core < 0 || core >= CPU_SETSIZE){
+        return 0;
+    }
+
+    if(!coreNodesValid[core]){
+        //The NUMA node of a CPU is given by the nodeN link in its sysfs directory
+        int node = 0;
+        char path[80];
+        snprintf(path, 80, "/sys/devices/system/cpu/cpu%d", core);
+        DIR *dir = opendir(path);
+        if(dir != NULL){
+            struct dirent *entry;
+            while((entry = readdir(dir)) != NULL){
+                if(strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9'){
+                    node = atoi(entry->d_name+4);
+                    break;
+                }
+            }
+            closedir(dir);
+        }
+        coreNodes[core] = node;
+        coreNodesValid[core] = true;
+    }
+
+    return coreNodes[core];
+}
+
+static void* buffer_arena_alloc_thread(void* args){
+    buffer_arena_job_t *job = (buffer_arena_job_t*) args;
+    //There is a condition on aligned_alloc that the size must be a multiple of the alignment (size is already rounded)
+    void* ptr = aligned_alloc(VITIS_MEM_ALIGNMENT, job->size);
+    if(ptr != NULL){
+        memset(ptr, 0, job->size); //First touch on this core's node
+    }
+    return ptr;
+}
+
+#if ARENA_COLD_CACHE
+static void* buffer_arena_zero_thread(void* args){
+    buffer_arena_job_t *job = (buffer_arena_job_t*) args;
+    memset(job->ptr, 0, job->size);
+    return job->ptr;
+}
+#endif
+
+void bufferArenaFlush(void* ptr, size_t size){
+    char* ptrChar = (char*) ptr;
+    for(size_t i = 0; i<size; i+=CACHE_LINE_SIZE){
+        _mm_clflush(ptrChar+i);
+    }
+    _mm_mfence();
+}
+
+void* bufferArenaAlloc(size_t size, int core){
+    size_t allocSize = size + (size%VITIS_MEM_ALIGNMENT == 0 ? 0 : VITIS_MEM_ALIGNMENT-(size%VITIS_MEM_ALIGNMENT));
+    int node = getCoreNumaNode(core);
+
+    //Look for a free buffer of the same size on the same node
+    for(int i = 0; i<arenaEntriesLen; i++){
+        buffer_arena_entry_t *entry = arenaEntries+i;
+        if(!entry->inUse && entry->node == node && entry->size == allocSize){
+            entry->inUse = true;
+            #if ARENA_COLD_CACHE
+                buffer_arena_job_t job = {.ptr = entry->ptr, .size = allocSize};
+                workerPoolRun(core, buffer_arena_zero_thread, &job);
+                bufferArenaFlush(entry->ptr, allocSize);
+            #endif
+            return entry->ptr;
+        }
+    }
+
+    //Allocate a new buffer from the core which will use it
+    buffer_arena_job_t job = {.ptr = NULL, .size = allocSize};
+    void* ptr = workerPoolRun(core, buffer_arena_alloc_thread, &job);
+    if(ptr == NULL){
+        printf("Could not allocate %lu bytes in buffer arena ... exiting\n", allocSize);
+        exit(1);
+    }
+    #if ARENA_COLD_CACHE
+        bufferArenaFlush(ptr, allocSize);
+    #endif
+
+    if(arenaEntriesLen >= arenaEntriesCapacity){
+        arenaEntriesCapacity = arenaEntriesCapacity == 0 ? 64 : arenaEntriesCapacity*2;
+        arenaEntries = (buffer_arena_entry_t*) realloc(arenaEntries, arenaEntriesCapacity*sizeof(buffer_arena_entry_t));
+    }
+    buffer_arena_entry_t *entry = arenaEntries+arenaEntriesLen;
+    entry->ptr = ptr;
+    entry->size = allocSize;
+    entry->node = node;
+    entry->inUse = true;
+    arenaEntriesLen++;
+
+    return ptr;
+}
+
+void bufferArenaFree(void* ptr){
+    if(ptr == NULL){
+        return;
+    }
+
+    for(int i = 0; i<arenaEntriesLen; i++){
+        if(arenaEntries[i].ptr == ptr){
+            arenaEntries[i].inUse = false;
+            return;
+        }
+    }
+
+    printf("Warning: Buffer %p was not allocated from the buffer arena\n", ptr);
+}
+
+void bufferArenaShutdown(){
+    for(int i = 0; i<arenaEntriesLen; i++){
+        if(arenaEntries[i].inUse){
+            printf("Warning: Buffer %p still in use when buffer arena was shut down\n", arenaEntries[i].ptr);
+        }
+        free(arenaEntries[i].ptr);
+    }
+    free(arenaEntries);
+    arenaEntries = NULL;
+    arenaEntriesLen = 0;
+    arenaEntriesCapacity = 0;
+}
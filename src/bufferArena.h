@@ -0,0 +1,46 @@
+#ifndef _BUFFER_ARENA_H
+#define _BUFFER_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * An arena of buffers reused between tests.  Buffers are tracked per NUMA node and handed back out
+ * to any core on the same node which requests a buffer of the same size.
+ * 
+ * New buffers are allocated and zeroed by the worker pool thread pinned to the requesting core so that
+ * pages are first touched on that core's node.  Reused buffers are not re-zeroed unless ARENA_COLD_CACHE
+ * is set, in which case they are re-zeroed on the requesting core and then flushed from the cache hierarchy.
+ */
+
+#ifndef ARENA_COLD_CACHE
+    #define ARENA_COLD_CACHE (0)
+#endif
+
+/**
+ * Allocates a buffer of at least size bytes, aligned to VITIS_MEM_ALIGNMENT, on the NUMA node of the given core.
+ * The contents are zero when the buffer is first allocated.
+ */
+void* bufferArenaAlloc(size_t size, int core);
+
+/**
+ * Returns a buffer to the arena for use by subsequent tests.  Does not release the memory.
+ */
+void bufferArenaFree(void* ptr);
+
+/**
+ * Flushes the given buffer from all levels of the cache hierarchy
+ */
+void bufferArenaFlush(void* ptr, size_t size);
+
+/**
+ * Releases all buffers held by the arena.  Buffers should not be in use.
+ */
+void bufferArenaShutdown();
+
+/**
+ * Returns the NUMA node of the given core (0 if it cannot be determined)
+ */
+int getCoreNumaNode(int core);
+
+#endif
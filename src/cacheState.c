@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <x86intrin.h>
+#include "cacheState.h"
+#include "workerPool.h"
+#include "testParams.h"
+
+#define CACHE_LINE_SIZE (64)
+
+typedef struct {
+    void* ptr;
+    size_t size;
+} cache_state_job_t;
+
+const char* getCacheStateName(int cacheState){
+    switch(cacheState){
+        case CACHE_STATE_UNCONTROLLED:
+            return "Uncontrolled";
+        case CACHE_STATE_FLUSH:
+            return "Flush";
+        case CACHE_STATE_WARM_PRODUCER:
+            return "WarmProducer";
+        case CACHE_STATE_WARM_CONSUMER:
+            return "WarmConsumer";
+        case CACHE_STATE_EVICT:
+            return "Evict";
+        default:
+            return "Unknown";
+    }
+}
+
+size_t getLLCSizeBytes(int core){
+    //The highest cache index listed in sysfs is the LLC
+    size_t llcSize = 0;
+    for(int index = 0; ; index++){
+        char path[100];
+        snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/cache/index%d/size", core, index);
+        FILE* sizeFile = fopen(path, "r");
+        if(sizeFile == NULL){
+            break;
+        }
+        size_t size;
+        char unit = '\0';
+        if(fscanf(sizeFile, "%lu%c", &size, &unit) >= 1){
+            if(unit == 'K'){
+                size *= 1024;
+            }else if(unit == 'M'){
+                size *= 1024*1024;
+            }
+            llcSize = size;
+        }
+        fclose(sizeFile);
+    }
+    return llcSize;
+}
+
+#if CACHE_STATE == CACHE_STATE_WARM_PRODUCER || CACHE_STATE == CACHE_STATE_EVICT
+static void* cache_state_write_thread(void* args){
+    cache_state_job_t *job = (cache_state_job_t*) args;
+    volatile char* ptrChar = (volatile char*) job->ptr;
+    for(size_t i = 0; i<job->size; i+=CACHE_LINE_SIZE){
+        ptrChar[i] = ptrChar[i]; //Contents are not changed but the line is taken in a modified state
+    }
+    return NULL;
+}
+#endif
+
+#if CACHE_STATE == CACHE_STATE_WARM_CONSUMER
+static void* cache_state_read_thread(void* args){
+    cache_state_job_t *job = (cache_state_job_t*) args;
+    volatile char* ptrChar = (volatile char*) job->ptr;
+    char sink = 0;
+    for(size_t i = 0; i<job->size; i+=CACHE_LINE_SIZE){
+        sink += ptrChar[i];
+    }
+    asm volatile("" : : "r" (sink) :);
+    return NULL;
+}
+#endif
+
+static void* evictionBuffer = NULL;
+static size_t evictionBufferSize = 0;
+
+#if CACHE_STATE == CACHE_STATE_EVICT
+static void evictCore(int core){
+    size_t size = CACHE_STATE_EVICT_BYTES;
+    if(size == 0){
+        size = 2*getLLCSizeBytes(core);
+        if(size == 0){
+            printf("Warning: Could not determine the LLC size of CPU %d, using a 64 MiB eviction buffer\n", core);
+            size = 64*1024*1024;
+        }
+    }
+    size = size + (size%VITIS_MEM_ALIGNMENT == 0 ? 0 : VITIS_MEM_ALIGNMENT-(size%VITIS_MEM_ALIGNMENT));
+
+    if(evictionBufferSize < size){
+        free(evictionBuffer);
+        evictionBuffer = aligned_alloc(VITIS_MEM_ALIGNMENT, size);
+        if(evictionBuffer == NULL){
+            printf("Could not allocate %lu byte eviction buffer ... exiting\n", size);
+            exit(1);
+        }
+        memset(evictionBuffer, 0, size);
+        evictionBufferSize = size;
+    }
+
+    cache_state_job_t job = {evictionBuffer, size};
+    workerPoolRun(core, cache_state_write_thread, &job);
+}
+#endif
+
+void cacheStateBeforeStart(void** buffers, size_t* sizes, int numBuffers, int producerCore, int consumerCore){
+    #if CACHE_STATE == CACHE_STATE_WARM_PRODUCER
+        for(int i = 0; i<numBuffers; i++){
+            cache_state_job_t job = {buffers[i], sizes[i]};
+            workerPoolRun(producerCore, cache_state_write_thread, &job);
+        }
+    #elif CACHE_STATE == CACHE_STATE_WARM_CONSUMER
+        for(int i = 0; i<numBuffers; i++){
+            cache_state_job_t job = {buffers[i], sizes[i]};
+            workerPoolRun(consumerCore, cache_state_read_thread, &job);
+        }
+    #elif CACHE_STATE == CACHE_STATE_EVICT
+        evictCore(producerCore);
+        if(consumerCore != producerCore){
+            evictCore(consumerCore);
+        }
+    #endif
+}
+
+void cacheStateBeforeTrigger(void** buffers, size_t* sizes, int numBuffers){
+    #if CACHE_STATE == CACHE_STATE_FLUSH
+        for(int i = 0; i<numBuffers; i++){
+            char* ptrChar = (char*) buffers[i];
+            for(size_t j = 0; j<sizes[i]; j+=CACHE_LINE_SIZE){
+                #ifdef __CLFLUSHOPT__
+                    _mm_clflushopt(ptrChar+j);
+                #else
+                    _mm_clflush(ptrChar+j);
+                #endif
+            }
+        }
+        _mm_mfence(); //clflushopt is only ordered by fences
+    #endif
+}
+
+void cacheStateShutdown(){
+    free(evictionBuffer);
+    evictionBuffer = NULL;
+    evictionBufferSize = 0;
+}
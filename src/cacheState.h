@@ -0,0 +1,50 @@
+#ifndef _CACHE_STATE_H
+#define _CACHE_STATE_H
+
+#include <stddef.h>
+
+//The cache state of the FIFO and memory buffers when the start trigger is set.  Applied after setup and recorded in the report.
+//Applied by every FIFO and memory runner except the quick probe (its trials run back to back within a time budget, so only the first
+//would start in the requested state) and the OS noise runner (no buffers are shared)
+#define CACHE_STATE_UNCONTROLLED (0) //No action.  Buffers are in whatever state setup left them in
+#define CACHE_STATE_FLUSH (1) //Buffers are flushed from all levels of the cache hierarchy (clflushopt) after all threads are ready
+#define CACHE_STATE_WARM_PRODUCER (2) //Buffers are written by the producer (FIFO server) core before the threads start
+#define CACHE_STATE_WARM_CONSUMER (3) //Buffers are read by the consumer (FIFO client) core before the threads start
+#define CACHE_STATE_EVICT (4) //An eviction buffer (CACHE_STATE_EVICT_BYTES) is streamed through by each core before the threads start
+
+#ifndef CACHE_STATE
+    #define CACHE_STATE CACHE_STATE_UNCONTROLLED
+#endif
+
+//The size of the eviction buffer.  If 0, twice the size of the LLC of the core is used
+#ifndef CACHE_STATE_EVICT_BYTES
+    #define CACHE_STATE_EVICT_BYTES (0)
+#endif
+
+/**
+ * The name of the given cache state (as recorded in the report)
+ */
+const char* getCacheStateName(int cacheState);
+
+/**
+ * Call after setup, before the threads are started.  Warms the buffers on the producer or consumer core, or evicts the caches of both cores
+ * For memory benchmarks, the producer and consumer are the same core.
+ */
+void cacheStateBeforeStart(void** buffers, size_t* sizes, int numBuffers, int producerCore, int consumerCore);
+
+/**
+ * Call after all threads are ready, before the start trigger.  Flushes the buffers
+ */
+void cacheStateBeforeTrigger(void** buffers, size_t* sizes, int numBuffers);
+
+/**
+ * Releases the eviction buffer
+ */
+void cacheStateShutdown();
+
+/**
+ * Returns the size of the last level cache of the given core in bytes (0 if it cannot be determined)
+ */
+size_t getLLCSizeBytes(int core);
+
+#endif
@@ -0,0 +1,184 @@
+#include "coalescedFifo.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "timeHelpers.h"
+#include "testParams.h"
+
+void *coalesced_fifo_server_thread(void* args){
+    coalesced_fifo_threadArgs_t *args_cast = (coalesced_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int numChannels = args_cast->numChannels;
+    _Atomic int8_t *readOffsetPtr = args_cast->readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr = args_cast->writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr = args_cast->arrayPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+
+    //==== Setup Output FIFO ====
+    int8_t writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+    int64_t offsetReloads = 0;
+
+    //==== Init write temps (one per channel) ====
+    PartitionCrossingFIFO_t writeTmp[COALESCED_MAX_CHANNELS];
+    memset(writeTmp, 0, sizeof(PartitionCrossingFIFO_t)*numChannels);
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmps are modified.  They are not actually modified
+        asm volatile(""
+        : "+m" (writeTmp)
+        :
+        :);
+
+        //Wait for output FIFO to be ready (one check for all channels)
+        bool notFull = (readOffsetCached != writeOffsetCached);
+        while (!notFull)
+        {
+            readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+            offsetReloads++;
+            notFull = (readOffsetCached != writeOffsetCached);
+        }
+
+        //Write each channel's section of the slot
+        int writeOffset = writeOffsetCached;
+        PartitionCrossingFIFO_t *slot = arrayPtr + writeOffset*numChannels;
+        for(int c = 0; c<numChannels; c++){
+            copyBlkToFifo(slot+c, writeTmp+c);
+            fifoProducerHint(slot+c);
+        }
+        if (writeOffset >= FIFO_LEN_BLKS)
+        {
+            writeOffset = 0;
+        }
+        else
+        {
+            writeOffset++;
+        }
+        writeOffsetCached = writeOffset;
+        //Update Write Ptr
+        atomic_store_explicit(writeOffsetPtr, writeOffset, memory_order_release);
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    *(args_cast->offsetReloads) = offsetReloads;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+void *coalesced_fifo_client_thread(void* args){
+    coalesced_fifo_threadArgs_t *args_cast = (coalesced_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int numChannels = args_cast->numChannels;
+    _Atomic int8_t *readOffsetPtr = args_cast->readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr = args_cast->writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr = args_cast->arrayPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+
+    //==== Setup Input FIFO ====
+    int8_t writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+    int64_t offsetReloads = 0;
+    PartitionCrossingFIFO_t readTmp[COALESCED_MAX_CHANNELS];
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        //Wait for input FIFO to be ready (one check for all channels)
+        bool notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -FIFO_LEN_BLKS)));
+        while (!notEmpty)
+        {
+            writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+            offsetReloads++;
+            notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -FIFO_LEN_BLKS)));
+        }
+
+        //Read each channel's section of the slot
+        int readOffset = readOffsetCached;
+        if (readOffset >= FIFO_LEN_BLKS)
+        {
+            readOffset = 0;
+        }
+        else
+        {
+            readOffset++;
+        }
+        fifoConsumerPrefetchSlot(arrayPtr, readOffset, numChannels);
+        PartitionCrossingFIFO_t *slot = arrayPtr + readOffset*numChannels;
+        for(int c = 0; c<numChannels; c++){
+            copyBlkFromFifo(readTmp+c, slot+c);
+        }
+        readOffsetCached = readOffset;
+        //Update Read Ptr
+        atomic_store_explicit(readOffsetPtr, readOffset, memory_order_release);
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        : "+m" (readTmp)
+        :
+        :);
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    *(args_cast->offsetReloads) = offsetReloads;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
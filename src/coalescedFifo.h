@@ -0,0 +1,42 @@
+#ifndef _COALESCED_FIFO_H
+#define _COALESCED_FIFO_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * A Laminar FIFO which carries several logical channels (signals crossing between the same 2 partitions) over one physical ring.
+ * The ring has a single pair of offsets.  Each slot holds one block (PartitionCrossingFIFO_t) for each channel:
+ * slot s is array[s*numChannels .. s*numChannels+numChannels-1].
+ *
+ * The server writes the block of every channel into the slot before publishing the write offset.  The client reads the block of
+ * every channel before publishing the read offset.
+ */
+
+#ifndef COALESCED_MAX_CHANNELS
+    #define COALESCED_MAX_CHANNELS (16)
+#endif
+
+typedef struct {
+    int numChannels;
+    _Atomic int8_t *readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr; //(FIFO_LEN_BLKS+1)*numChannels blocks
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+    int64_t *offsetReloads; //The number of times the other side's offset was loaded.  Written by the thread before it returns
+} coalesced_fifo_threadArgs_t;
+
+/**
+ * Takes coalesced_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *coalesced_fifo_server_thread(void* args);
+
+/**
+ * Takes coalesced_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *coalesced_fifo_client_thread(void* args);
+
+#endif
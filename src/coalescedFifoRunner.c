@@ -0,0 +1,210 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "coalescedFifoRunner.h"
+#include "laminarFifoPartition.h"
+#include "laminarFifoRunner.h"
+#include "laminarFifoInternal.h"
+#include "testParams.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "vitisNumaAllocHelpers.h"
+#include "topologyHelpers.h"
+#include "cacheState.h"
+
+static atomic_flag* initReadyFlag(int core){
+    atomic_flag *flag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), core);
+    atomic_signal_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(flag, memory_order_release); //Init since this was malloc-ed
+    atomic_flag_test_and_set_explicit(flag, memory_order_acq_rel);
+    return flag;
+}
+
+static double joinThread(int core){
+    double *result = (double*) workerPoolJoin(core);
+    double time = *result;
+    free(result);
+    return time;
+}
+
+void writeChannelFifoHeader(FILE* reportFile){
+    fprintf(reportFile, "Mode,ServerCPU,ClientCPU,Channels,ServerTime,ClientTime,BytesTx,BytesRx,ServerOffsetReloads,ClientOffsetReloads,CacheState,Level\n");
+}
+
+void runChannelFifoBench(int serverCPU, int clientCPU, int numChannels, int mode, FILE* reportFile){
+    if(numChannels < 1 || numChannels > COALESCED_MAX_CHANNELS || numChannels > PARTITION_MAX_PORTS){
+        printf("Channel FIFO must have between 1 and %d channels (COALESCED_MAX_CHANNELS, PARTITION_MAX_PORTS) ... exiting\n",
+               COALESCED_MAX_CHANNELS < PARTITION_MAX_PORTS ? COALESCED_MAX_CHANNELS : PARTITION_MAX_PORTS);
+        exit(1);
+    }
+
+    atomic_flag *serverReadyFlag = initReadyFlag(serverCPU);
+    atomic_flag *clientReadyFlag = initReadyFlag(clientCPU);
+    int64_t *serverOffsetReloads = (int64_t*) bufferArenaAlloc(sizeof(int64_t), serverCPU);
+    int64_t *clientOffsetReloads = (int64_t*) bufferArenaAlloc(sizeof(int64_t), clientCPU);
+
+    //Create starting trigger
+    _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, false, memory_order_release);
+
+    //Coalesced state
+    _Atomic int8_t* readOffsetPtr = NULL;
+    _Atomic int8_t* writeOffsetPtr = NULL;
+    PartitionCrossingFIFO_t* arrayPtr = NULL;
+    coalesced_fifo_threadArgs_t *serverArgs = NULL;
+    coalesced_fifo_threadArgs_t *clientArgs = NULL;
+
+    //Independent state (the FIFO side ready flags from initFIFO are unused)
+    _Atomic int8_t* readOffsetPtrs[numChannels];
+    _Atomic int8_t* writeOffsetPtrs[numChannels];
+    PartitionCrossingFIFO_t* arrayPtrs[numChannels];
+    atomic_flag *fifoServerFlags[numChannels];
+    atomic_flag *fifoClientFlags[numChannels];
+    laminar_partition_threadArgs_t *serverPartitionArgs = NULL;
+    laminar_partition_threadArgs_t *clientPartitionArgs = NULL;
+    laminar_partition_stats_t *serverStats = NULL;
+    laminar_partition_stats_t *clientStats = NULL;
+
+    //The buffers whose cache state is set (see cacheState.h)
+    void* fifoBuffers[3*COALESCED_MAX_CHANNELS];
+    size_t fifoBufferSizes[3*COALESCED_MAX_CHANNELS];
+    int numFifoBuffers = 0;
+
+    //Create FIFO(s) and start threads
+    if(mode == CHANNEL_FIFO_MODE_COALESCED){
+        readOffsetPtr = (_Atomic int8_t*) bufferArenaAlloc(sizeof(_Atomic int8_t), clientCPU);
+        writeOffsetPtr = (_Atomic int8_t*) bufferArenaAlloc(sizeof(_Atomic int8_t), serverCPU);
+        arrayPtr = (PartitionCrossingFIFO_t*) bufferArenaAlloc(sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1)*numChannels, serverCPU); //Alloc an additional slot (for empty/full ambiguity resolution)
+        atomic_init(readOffsetPtr, 0);
+        atomic_init(writeOffsetPtr, 1);
+
+        serverArgs = (coalesced_fifo_threadArgs_t*) bufferArenaAlloc(sizeof(coalesced_fifo_threadArgs_t), serverCPU);
+        clientArgs = (coalesced_fifo_threadArgs_t*) bufferArenaAlloc(sizeof(coalesced_fifo_threadArgs_t), clientCPU);
+        coalesced_fifo_threadArgs_t *argsList[2] = {serverArgs, clientArgs};
+        for(int i = 0; i<2; i++){
+            argsList[i]->numChannels = numChannels;
+            argsList[i]->readOffsetPtr = readOffsetPtr;
+            argsList[i]->writeOffsetPtr = writeOffsetPtr;
+            argsList[i]->arrayPtr = arrayPtr;
+            argsList[i]->startTrigger = startTrigger;
+        }
+        serverArgs->readyFlag = serverReadyFlag;
+        serverArgs->offsetReloads = serverOffsetReloads;
+        clientArgs->readyFlag = clientReadyFlag;
+        clientArgs->offsetReloads = clientOffsetReloads;
+
+        fifoBuffers[0] = arrayPtr;
+        fifoBufferSizes[0] = sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1)*numChannels;
+        fifoBuffers[1] = readOffsetPtr;
+        fifoBufferSizes[1] = sizeof(_Atomic int8_t);
+        fifoBuffers[2] = writeOffsetPtr;
+        fifoBufferSizes[2] = sizeof(_Atomic int8_t);
+        numFifoBuffers = 3;
+        cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, numFifoBuffers, serverCPU, clientCPU);
+
+        workerPoolSubmit(serverCPU, coalesced_fifo_server_thread, serverArgs);
+        workerPoolSubmit(clientCPU, coalesced_fifo_client_thread, clientArgs);
+    }else if(mode == CHANNEL_FIFO_MODE_INDEPENDENT){
+        for(int c = 0; c<numChannels; c++){
+            initFIFO(readOffsetPtrs+c, writeOffsetPtrs+c, arrayPtrs+c, fifoServerFlags+c, fifoClientFlags+c, serverCPU, clientCPU);
+            fifoBuffers[numFifoBuffers] = arrayPtrs[c];
+            fifoBufferSizes[numFifoBuffers++] = sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1);
+            fifoBuffers[numFifoBuffers] = readOffsetPtrs[c];
+            fifoBufferSizes[numFifoBuffers++] = sizeof(_Atomic int8_t);
+            fifoBuffers[numFifoBuffers] = writeOffsetPtrs[c];
+            fifoBufferSizes[numFifoBuffers++] = sizeof(_Atomic int8_t);
+        }
+        cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, numFifoBuffers, serverCPU, clientCPU);
+
+        //The server is a partition with only outputs and the client is a partition with only inputs
+        serverPartitionArgs = (laminar_partition_threadArgs_t*) bufferArenaAlloc(sizeof(laminar_partition_threadArgs_t), serverCPU);
+        clientPartitionArgs = (laminar_partition_threadArgs_t*) bufferArenaAlloc(sizeof(laminar_partition_threadArgs_t), clientCPU);
+        serverStats = (laminar_partition_stats_t*) bufferArenaAlloc(sizeof(laminar_partition_stats_t), serverCPU);
+        clientStats = (laminar_partition_stats_t*) bufferArenaAlloc(sizeof(laminar_partition_stats_t), clientCPU);
+
+        serverPartitionArgs->numInputs = 0;
+        serverPartitionArgs->numOutputs = numChannels;
+        clientPartitionArgs->numInputs = numChannels;
+        clientPartitionArgs->numOutputs = 0;
+        for(int c = 0; c<numChannels; c++){
+            serverPartitionArgs->outputReadOffsetPtrs[c] = readOffsetPtrs[c];
+            serverPartitionArgs->outputWriteOffsetPtrs[c] = writeOffsetPtrs[c];
+            serverPartitionArgs->outputArrayPtrs[c] = arrayPtrs[c];
+            clientPartitionArgs->inputReadOffsetPtrs[c] = readOffsetPtrs[c];
+            clientPartitionArgs->inputWriteOffsetPtrs[c] = writeOffsetPtrs[c];
+            clientPartitionArgs->inputArrayPtrs[c] = arrayPtrs[c];
+        }
+        serverPartitionArgs->startTrigger = startTrigger;
+        serverPartitionArgs->readyFlag = serverReadyFlag;
+        serverPartitionArgs->stats = serverStats;
+        clientPartitionArgs->startTrigger = startTrigger;
+        clientPartitionArgs->readyFlag = clientReadyFlag;
+        clientPartitionArgs->stats = clientStats;
+
+        //Untimed so that the independent FIFOs carry no more instrumentation than the coalesced FIFO
+        workerPoolSubmit(serverCPU, fifo_partition_thread_untimed, serverPartitionArgs);
+        workerPoolSubmit(clientCPU, fifo_partition_thread_untimed, clientPartitionArgs);
+    }else{
+        printf("Unknown channel FIFO mode %d ... exiting\n", mode);
+        exit(1);
+    }
+
+    //Wait for all threads ready
+    bool wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(serverReadyFlag, memory_order_acq_rel);
+    }
+    wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(clientReadyFlag, memory_order_acq_rel);
+    }
+
+    cacheStateBeforeTrigger(fifoBuffers, fifoBufferSizes, numFifoBuffers);
+
+    //Start FIFO transfers
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, true, memory_order_release);
+
+    //Wait for threads to finish
+    double serverTime = joinThread(serverCPU);
+    double clientTime = joinThread(clientCPU);
+
+    if(mode == CHANNEL_FIFO_MODE_INDEPENDENT){
+        *serverOffsetReloads = serverStats->outputOffsetReloads;
+        *clientOffsetReloads = clientStats->inputOffsetReloads;
+    }
+
+    //Write results
+    long long int bytes = TRANSACTIONS_BLKS*BLK_SIZE_BYTES*numChannels;
+    fprintf(reportFile, "%s,%d,%d,%d,%e,%e,%lld,%lld,%ld,%ld,%s,%s\n", mode == CHANNEL_FIFO_MODE_COALESCED ? "Coalesced" : "Independent",
+            serverCPU, clientCPU, numChannels, serverTime, clientTime, bytes, bytes, *serverOffsetReloads, *clientOffsetReloads,
+            getCacheStateName(CACHE_STATE), getTopologyLevelName(getTopologyLevel(serverCPU, clientCPU)));
+    fflush(reportFile);
+
+    //Cleanup
+    if(mode == CHANNEL_FIFO_MODE_COALESCED){
+        bufferArenaFree(readOffsetPtr);
+        bufferArenaFree(writeOffsetPtr);
+        bufferArenaFree(arrayPtr);
+        bufferArenaFree(serverArgs);
+        bufferArenaFree(clientArgs);
+    }else{
+        for(int c = 0; c<numChannels; c++){
+            cleanupFIFO(readOffsetPtrs[c], writeOffsetPtrs[c], arrayPtrs[c], fifoServerFlags[c], fifoClientFlags[c]);
+        }
+        bufferArenaFree(serverPartitionArgs);
+        bufferArenaFree(clientPartitionArgs);
+        bufferArenaFree(serverStats);
+        bufferArenaFree(clientStats);
+    }
+    bufferArenaFree(serverReadyFlag);
+    bufferArenaFree(clientReadyFlag);
+    bufferArenaFree(serverOffsetReloads);
+    bufferArenaFree(clientOffsetReloads);
+    free(startTrigger);
+}
@@ -0,0 +1,21 @@
+#ifndef _COALESCED_FIFO_RUNNER_H
+#define _COALESCED_FIFO_RUNNER_H
+
+#include <stdio.h>
+#include "coalescedFifo.h"
+
+#define CHANNEL_FIFO_MODE_COALESCED (0) //All channels share one ring (see coalescedFifo.h)
+#define CHANNEL_FIFO_MODE_INDEPENDENT (1) //Each channel has its own Laminar FIFO.  The server and client check and update each FIFO's offsets (see laminarFifoPartition.h)
+
+/**
+ * Runs numChannels logical channels from serverCPU to clientCPU and appends a row to reportFile (see writeChannelFifoHeader)
+ * @param mode CHANNEL_FIFO_MODE_COALESCED or CHANNEL_FIFO_MODE_INDEPENDENT
+ */
+void runChannelFifoBench(int serverCPU, int clientCPU, int numChannels, int mode, FILE* reportFile);
+
+/**
+ * Writes the header for the rows appended by runChannelFifoBench
+ */
+void writeChannelFifoHeader(FILE* reportFile);
+
+#endif
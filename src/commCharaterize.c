@@ -8,6 +8,27 @@
 #include "memoryRunner.h"
 #include "memoryReader.h"
 #include "memoryWriter.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "spscFifoRunner.h"
+#include "fastForwardFifo.h"
+#include "mcRingBufferFifo.h"
+#include "bQueueFifo.h"
+#include "seqRingFifo.h"
+#include "ipcFifo.h"
+#include "topologyHelpers.h"
+#include "fifoHints.h"
+#include "cacheState.h"
+#include "broadcastFifoRunner.h"
+#include "laminarFifoPartitionRunner.h"
+#include "coalescedFifoRunner.h"
+#include "pacedFifoRunner.h"
+#include "osNoiseRunner.h"
+#include "duplexFifoRunner.h"
+#include "quickProbeRunner.h"
+#include "adaptiveFifoRunner.h"
+#include "recordFifoRunner.h"
+#include "reportHelpers.h"
 
 #define RYZEN_3970_NOSMT_BIOS_UPDATE
 
@@ -16,6 +37,7 @@
     #define L3_S (8)
     #define START_L3 (2)
     #define START_L3_SECONDARY (1)
+    #define L3S_PER_SOCKET (8)
 
     const int CORE_MAP[L3_S][CORES_PER_L3] = {{ 0, 17, 18, 19}, 
                                               { 1,  2,  3,  4}, 
@@ -32,6 +54,7 @@
     #define L3_S (8)
     #define START_L3 (2)
     #define START_L3_SECONDARY (1)
+    #define L3S_PER_SOCKET (8)
 
     const int CORE_MAP[L3_S][CORES_PER_L3] = {{ 0,  1,  2,  3}, 
                                               { 4,  5,  6,  7}, 
@@ -47,6 +70,7 @@
     #define CORES_PER_L3 (4)
     #define L3_S (16)
     #define START_L3 (2)
+    #define L3S_PER_SOCKET (16)
 
     const int CORE_MAP[L3_S][CORES_PER_L3] = {{ 0,  1,  2,  3}, 
                                               { 4,  5,  6,  7}, 
@@ -74,6 +98,147 @@
     #define MEM_TESTS 1
 #endif
 
+#ifndef AUTOTUNE_TESTS
+    #define AUTOTUNE_TESTS 0
+#endif
+
+#ifndef SMT_TESTS
+    #define SMT_TESTS 0
+#endif
+
+#ifndef BROADCAST_TESTS
+    #define BROADCAST_TESTS 0
+#endif
+
+//The number of L3s (after the producer's L3) the broadcast tests fan out to
+#ifndef BROADCAST_REMOTE_L3S
+    #define BROADCAST_REMOTE_L3S (2)
+#endif
+
+#ifndef MULTI_PORT_TESTS
+    #define MULTI_PORT_TESTS 0
+#endif
+
+//The largest number of input or output FIFOs swept by the multi-port partition tests
+#ifndef MULTI_PORT_MAX_PORTS
+    #define MULTI_PORT_MAX_PORTS (16)
+#endif
+
+//Where the peer (input server and output client) threads of the multi-port partition tests are placed
+#define MULTI_PORT_PEER_PLACEMENT_NEAR (0) //The other cores in the partition's L3 first, then the following L3s
+#define MULTI_PORT_PEER_PLACEMENT_FAR (1) //Only cores in the L3s following the partition's L3
+
+#ifndef MULTI_PORT_PEER_PLACEMENT
+    #define MULTI_PORT_PEER_PLACEMENT MULTI_PORT_PEER_PLACEMENT_NEAR
+#endif
+
+#ifndef COALESCED_TESTS
+    #define COALESCED_TESTS 0
+#endif
+
+#ifndef L3S_PER_SOCKET
+    #define L3S_PER_SOCKET L3_S
+#endif
+
+#ifndef PACED_TESTS
+    #define PACED_TESTS 0
+#endif
+
+//The release profile of the paced producer (see pacedFifo.h)
+#ifndef PACED_PROFILE
+    #define PACED_PROFILE PACED_PROFILE_CONSTANT
+#endif
+
+//The offered load is swept from PACED_LOAD_STEP_PCT to PACED_LOAD_MAX_PCT (percent of the saturation rate) in steps of PACED_LOAD_STEP_PCT
+#ifndef PACED_LOAD_STEP_PCT
+    #define PACED_LOAD_STEP_PCT (10)
+#endif
+
+#ifndef PACED_LOAD_MAX_PCT
+    #define PACED_LOAD_MAX_PCT (100)
+#endif
+
+//Write the timestamps and latency of every block of each paced run to its own report
+#ifndef PACED_BLOCK_REPORT
+    #define PACED_BLOCK_REPORT 1
+#endif
+
+#ifndef OS_NOISE_TESTS
+    #define OS_NOISE_TESTS 0
+#endif
+
+//How long the noise probe spins on each core
+#ifndef OS_NOISE_PROBE_SEC
+    #define OS_NOISE_PROBE_SEC (10.0)
+#endif
+
+#ifndef TOPOLOGY_LEVEL_TESTS
+    #define TOPOLOGY_LEVEL_TESTS 0
+#endif
+
+#ifndef SCALING_TESTS
+    #define SCALING_TESTS 0
+#endif
+
+#ifndef DUPLEX_TESTS
+    #define DUPLEX_TESTS 0
+#endif
+
+#if DUPLEX_TESTS != 0 && (DUPLEX_PRELOAD_BLKS < 1 || DUPLEX_PRELOAD_BLKS >= FIFO_LEN_BLKS)
+    #error DUPLEX_TESTS requires 1 <= DUPLEX_PRELOAD_BLKS < FIFO_LEN_BLKS
+#endif
+
+#ifndef QUICK_PROBE_TESTS
+    #define QUICK_PROBE_TESTS 0
+#endif
+
+//The number of pairs of cores the quick probe measures at each topology level
+#ifndef QUICK_PROBE_PAIRS_PER_LEVEL
+    #define QUICK_PROBE_PAIRS_PER_LEVEL (2)
+#endif
+
+//The time the quick probe measurements may take (calibrating the TSC and finding the pairs are not counted).  Measurements which do not
+//fit are skipped
+#ifndef QUICK_PROBE_BUDGET_SEC
+    #define QUICK_PROBE_BUDGET_SEC (1.0)
+#endif
+
+#ifndef ADAPTIVE_FIFO_TESTS
+    #define ADAPTIVE_FIFO_TESTS 0
+#endif
+
+//The depth the adaptive FIFO starts at
+#ifndef ADAPTIVE_FIFO_INITIAL_LEN_BLKS
+    #define ADAPTIVE_FIFO_INITIAL_LEN_BLKS ADAPTIVE_FIFO_MIN_LEN_BLKS
+#endif
+
+//The offered load of the adaptive FIFO comparison is swept from ADAPTIVE_FIFO_LOAD_STEP_PCT to ADAPTIVE_FIFO_LOAD_MAX_PCT
+#ifndef ADAPTIVE_FIFO_LOAD_STEP_PCT
+    #define ADAPTIVE_FIFO_LOAD_STEP_PCT (30)
+#endif
+
+#ifndef ADAPTIVE_FIFO_LOAD_MAX_PCT
+    #define ADAPTIVE_FIFO_LOAD_MAX_PCT (90)
+#endif
+
+#ifndef RECORD_FIFO_TESTS
+    #define RECORD_FIFO_TESTS 0
+#endif
+
+//The latency of the record FIFO is also measured with records released at this percent of the padded FIFO's saturation rate
+#ifndef RECORD_FIFO_LOAD_PCT
+    #define RECORD_FIFO_LOAD_PCT (50)
+#endif
+
+//The order concurrent FIFOs are added in by the scaling sweeps
+#define SCALING_ORDER_SPREAD (0) //Round-robin across the L3s (or L3 pairs) so that each FIFO added lands on the least loaded L3
+#define SCALING_ORDER_PACKED (1) //Fill the cores of an L3 (or L3 pair) before moving on to the next
+#define SCALING_ORDER_BOTH (2)
+
+#ifndef SCALING_ORDER
+    #define SCALING_ORDER SCALING_ORDER_BOTH
+#endif
+
 /**
  * Note: This function allocates a new string which should be freed after use
  */
@@ -269,6 +434,982 @@ void runInterL3OneToMultiple(char* reportPrefix, int fromL3){
     free(reportName);
 }
 
+/**
+ * Adds concurrent FIFOs one at a time, from 1 to numGroups*fifosPerGroup.  The FIFOs are given grouped (ex. all of the FIFOs between a
+ * pair of L3s are in the same group) and are added in the given order (SCALING_ORDER_SPREAD or SCALING_ORDER_PACKED).
+ *
+ * Each step writes the usual report (with the throughput of each FIFO).  A summary with the aggregate throughput of each step is also
+ * written.  The step after which MarginalBytesPerSec drops to ~0 is where the shared path (ex. the IO die) saturates
+ */
+static void runFifoScalingSweep(char* reportPrefix, const char* testName, int startL3, int order, int* packedServerCPUs, int* packedClientCPUs,
+                                int numGroups, int fifosPerGroup){
+    const char* orderName = order == SCALING_ORDER_PACKED ? "packed" : "spread";
+    int maxFifos = numGroups*fifosPerGroup;
+    int serverCPUs[maxFifos];
+    int clientCPUs[maxFifos];
+    for(int i = 0; i<maxFifos; i++){
+        int packedInd = order == SCALING_ORDER_PACKED ? i : (i%numGroups)*fifosPerGroup + i/numGroups;
+        serverCPUs[i] = packedServerCPUs[packedInd];
+        clientCPUs[i] = packedClientCPUs[packedInd];
+    }
+
+    char reportNameSuffix[80];
+    snprintf(reportNameSuffix, 80, "_scaling_%s_%s_startL3-%d.csv", testName, orderName, startL3);
+    char* reportName = genReportName(reportPrefix, reportNameSuffix);
+    FILE* summaryFile = fopen(reportName, "w");
+    fprintf(summaryFile, "Order,NumFifos,AddedServerCPU,AddedClientCPU,AddedLevel,AggregateBytesPerSec,MarginalBytesPerSec,MeanFifoBytesPerSec,MinFifoBytesPerSec,MaxFifoBytesPerSec,ScalingEfficiency\n");
+
+    long long int bytesPerFifo = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    double singleFifoRate = 0;
+    double lastAggregate = 0;
+    double peakAggregate = 0;
+    int peakFifos = 0;
+    for(int numFifos = 1; numFifos<=maxFifos; numFifos++){
+        char stepTag[32];
+        snprintf(stepTag, 32, "_fifos-%d", numFifos);
+        char* stepReportName = genDerivedReportName(reportName, stepTag);
+
+        double clientTimes[numFifos];
+        runLaminarFifoBenchTimes(serverCPUs, clientCPUs, numFifos, stepReportName, NULL, clientTimes);
+        free(stepReportName);
+
+        //The FIFOs are started together so the aggregate is over the slowest
+        double maxTime = 0;
+        double minRate = 0;
+        double maxRate = 0;
+        double rateSum = 0;
+        for(int i = 0; i<numFifos; i++){
+            double rate = bytesPerFifo/clientTimes[i];
+            maxTime = clientTimes[i] > maxTime ? clientTimes[i] : maxTime;
+            minRate = i == 0 || rate < minRate ? rate : minRate;
+            maxRate = rate > maxRate ? rate : maxRate;
+            rateSum += rate;
+        }
+        double aggregate = bytesPerFifo*numFifos/maxTime;
+        if(numFifos == 1){
+            singleFifoRate = aggregate;
+        }
+        if(aggregate > peakAggregate){
+            peakAggregate = aggregate;
+            peakFifos = numFifos;
+        }
+
+        fprintf(summaryFile, "%s,%d,%d,%d,%s,%e,%e,%e,%e,%e,%f\n", orderName, numFifos, serverCPUs[numFifos-1], clientCPUs[numFifos-1],
+                getTopologyLevelName(getTopologyLevel(serverCPUs[numFifos-1], clientCPUs[numFifos-1])), aggregate, aggregate-lastAggregate,
+                rateSum/numFifos, minRate, maxRate, aggregate/(numFifos*singleFifoRate));
+        fflush(summaryFile);
+        lastAggregate = aggregate;
+    }
+
+    printf("Peak aggregate of %e bytes/s (%s) with %d concurrent FIFOs\n", peakAggregate, orderName, peakFifos);
+
+    fclose(summaryFile);
+    free(reportName);
+}
+
+/**
+ * Scaling sweep of the FIFOs in runInterL3AllL3 (all cores in an L3 paired to cores in the next L3, all L3s after startL3 participating)
+ */
+void runInterL3Scaling(char* reportPrefix, int startL3){
+    assert(startL3>=0 && startL3+1<L3_S);
+    printf("=== InterL3Scaling ===\n");
+
+    int numL3Pairs = (L3_S-startL3)/2; //Round Down
+    int numFifos = CORES_PER_L3*numL3Pairs;
+    int serverCPUs[numFifos];
+    int clientCPUs[numFifos];
+
+    for(int l3 = 0; l3<numL3Pairs; l3++){
+        for(int fifo = 0; fifo<CORES_PER_L3; fifo++){
+            int ind = l3*CORES_PER_L3+fifo;
+            serverCPUs[ind] = CORE_MAP[startL3+l3*2  ][fifo];
+            clientCPUs[ind] = CORE_MAP[startL3+l3*2+1][fifo];
+        }
+    }
+
+    for(int order = SCALING_ORDER_SPREAD; order<=SCALING_ORDER_PACKED; order++){
+        if(SCALING_ORDER == SCALING_ORDER_BOTH || SCALING_ORDER == order){
+            runFifoScalingSweep(reportPrefix, "interL3", startL3, order, serverCPUs, clientCPUs, numL3Pairs, CORES_PER_L3);
+        }
+    }
+}
+
+/**
+ * Scaling sweep of the FIFOs in runIntraL3AllL3 (all cores in an L3 paired up, all L3s after startL3 participating)
+ */
+void runIntraL3Scaling(char* reportPrefix, int startL3){
+    static_assert(CORES_PER_L3>1, "Intra-L3 Test Requires >1 Core Per L3");
+    assert(startL3>=0 && startL3<L3_S);
+    printf("=== IntraL3Scaling ===\n");
+
+    int numFifosPer = CORES_PER_L3/2; //Round Down
+    int numL3s = L3_S-startL3;
+    int numFifos = numFifosPer*numL3s;
+    int serverCPUs[numFifos];
+    int clientCPUs[numFifos];
+
+    for(int l3 = 0; l3<numL3s; l3++){
+        for(int l3Fifo = 0; l3Fifo<numFifosPer; l3Fifo++){
+            int ind = l3*numFifosPer+l3Fifo;
+            serverCPUs[ind] = CORE_MAP[startL3+l3][l3Fifo*2];
+            clientCPUs[ind] = CORE_MAP[startL3+l3][l3Fifo*2+1];
+        }
+    }
+
+    for(int order = SCALING_ORDER_SPREAD; order<=SCALING_ORDER_PACKED; order++){
+        if(SCALING_ORDER == SCALING_ORDER_BOTH || SCALING_ORDER == order){
+            runFifoScalingSweep(reportPrefix, "intraL3", startL3, order, serverCPUs, clientCPUs, numL3s, numFifosPer);
+        }
+    }
+}
+
+/**
+ * A single FIFO for each topology relation the auto-tuner (autoTune.py) selects parameters for:
+ *   intraL3: 2 cores in the same L3
+ *   interL3: 2 cores in different L3s on the same socket
+ *   crossSocket: 2 cores on different sockets (only if the core map spans >1 socket)
+ */
+void runAutoTuneProbe(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== AutoTuneProbe ===\n");
+
+    {
+        static_assert(CORES_PER_L3>1, "Intra-L3 Test Requires >1 Core Per L3");
+        char* reportName = genReportName(reportPrefix, "_autoTune_intraL3.csv");
+        int serverCPUs[1] = {CORE_MAP[l3][0]};
+        int clientCPUs[1] = {CORE_MAP[l3][1]};
+        runLaminarFifoBench(serverCPUs, clientCPUs, 1, reportName);
+        free(reportName);
+    }
+
+    if(L3S_PER_SOCKET>1){
+        //Stay on the same socket
+        int socketStartL3 = (l3/L3S_PER_SOCKET)*L3S_PER_SOCKET;
+        int otherL3 = socketStartL3 + ((l3-socketStartL3+1)%L3S_PER_SOCKET);
+        char* reportName = genReportName(reportPrefix, "_autoTune_interL3.csv");
+        int serverCPUs[1] = {CORE_MAP[l3][0]};
+        int clientCPUs[1] = {CORE_MAP[otherL3][0]};
+        runLaminarFifoBench(serverCPUs, clientCPUs, 1, reportName);
+        free(reportName);
+    }
+
+    if(L3_S>L3S_PER_SOCKET){
+        int otherL3 = (l3+L3S_PER_SOCKET)%L3_S;
+        char* reportName = genReportName(reportPrefix, "_autoTune_crossSocket.csv");
+        int serverCPUs[1] = {CORE_MAP[l3][0]};
+        int clientCPUs[1] = {CORE_MAP[otherL3][0]};
+        runLaminarFifoBench(serverCPUs, clientCPUs, 1, reportName);
+        free(reportName);
+    }
+}
+
+/**
+ * Alternative SPSC FIFO algorithms (and the Laminar FIFO as a baseline) for a single pair of cores in an L3
+ * and a single pair of cores in different L3s.  The same cores are used for each algorithm.
+ */
+void runAltFifoSingleFifo(char* reportPrefix, int l3){
+    static_assert(CORES_PER_L3>1, "Intra-L3 Test Requires >1 Core Per L3");
+    static_assert(START_L3+1<L3_S, "Inter-L3 Test Requires >1 L3s to be Tested");
+    assert(l3>=0 && l3+1<L3_S);
+    printf("=== AltFifoSingleFifo ===\n");
+
+    const spsc_fifo_impl_t* impls[] = {&FAST_FORWARD_FIFO_IMPL, &MC_RING_BUFFER_FIFO_IMPL, &B_QUEUE_FIFO_IMPL, &SEQ_RING_FIFO_IMPL};
+    const int numImpls = sizeof(impls)/sizeof(impls[0]);
+
+    int intraServerCPUs[1] = {CORE_MAP[l3][0]};
+    int intraClientCPUs[1] = {CORE_MAP[l3][1]};
+    int interServerCPUs[1] = {CORE_MAP[l3][0]};
+    int interClientCPUs[1] = {CORE_MAP[l3+1][0]};
+
+    //i==-1 is the Laminar FIFO baseline
+    for(int i = -1; i<numImpls; i++){
+        const char* name = i<0 ? "laminar" : impls[i]->name;
+
+        char reportNameSuffix[120];
+        snprintf(reportNameSuffix, 120, "_altFifo_%s_intraL3_L3-%d_L3CPUA-%d_L3CPUB-%d.csv", name, l3, 0, 1);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        if(i<0){
+            runLaminarFifoBench(intraServerCPUs, intraClientCPUs, 1, reportName);
+        }else{
+            runSpscFifoBench(intraServerCPUs, intraClientCPUs, 1, reportName, impls[i]);
+        }
+        free(reportName);
+
+        snprintf(reportNameSuffix, 120, "_altFifo_%s_interL3_L3A-%d_L3B-%d.csv", name, l3, l3+1);
+        reportName = genReportName(reportPrefix, reportNameSuffix);
+        if(i<0){
+            runLaminarFifoBench(interServerCPUs, interClientCPUs, 1, reportName);
+        }else{
+            runSpscFifoBench(interServerCPUs, interClientCPUs, 1, reportName, impls[i]);
+        }
+        free(reportName);
+    }
+}
+
+/**
+ * A single producer core in fromL3 sending the same blocks to every core in the next BROADCAST_REMOTE_L3S L3s.  Compares:
+ *   separate: a separate FIFO from the producer to each consumer (the producer copies each block once per consumer)
+ *   ring: a single broadcast ring read by all consumers
+ *   relayTree: a broadcast ring read by 1 relay core in each remote L3.  Each relay forwards the blocks into a broadcast ring read by the other cores in its L3
+ * 
+ * The same producer and consumer cores are used for each configuration (the relays are also consumers)
+ */
+void runInterL3Broadcast(char* reportPrefix, int fromL3){
+    static_assert(BROADCAST_REMOTE_L3S*CORES_PER_L3<=BROADCAST_MAX_READERS, "Broadcast Test Requires BROADCAST_REMOTE_L3S*CORES_PER_L3 <= BROADCAST_MAX_READERS");
+    assert(fromL3>=0 && fromL3+BROADCAST_REMOTE_L3S<L3_S);
+    printf("=== InterL3Broadcast ===\n");
+
+    int producerCPU = CORE_MAP[fromL3][0];
+    int numConsumers = BROADCAST_REMOTE_L3S*CORES_PER_L3;
+    char reportNameSuffix[120];
+
+    //Separate FIFOs
+    {
+        broadcast_ring_desc_t rings[numConsumers];
+        for(int l3 = 0; l3<BROADCAST_REMOTE_L3S; l3++){
+            for(int i = 0; i<CORES_PER_L3; i++){
+                int ind = l3*CORES_PER_L3+i;
+                rings[ind].producerCPU = producerCPU;
+                rings[ind].numReaders = 1;
+                rings[ind].readerCPUs[0] = CORE_MAP[fromL3+l3+1][i];
+            }
+        }
+
+        snprintf(reportNameSuffix, 120, "_broadcast_separate_fromL3-%d_numL3-%d.csv", fromL3, BROADCAST_REMOTE_L3S);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        runBroadcastFifoBench(rings, numConsumers, "separate", reportName);
+        free(reportName);
+    }
+
+    //Single broadcast ring
+    {
+        broadcast_ring_desc_t rings[1];
+        rings[0].producerCPU = producerCPU;
+        rings[0].numReaders = numConsumers;
+        for(int l3 = 0; l3<BROADCAST_REMOTE_L3S; l3++){
+            for(int i = 0; i<CORES_PER_L3; i++){
+                rings[0].readerCPUs[l3*CORES_PER_L3+i] = CORE_MAP[fromL3+l3+1][i];
+            }
+        }
+
+        snprintf(reportNameSuffix, 120, "_broadcast_ring_fromL3-%d_numL3-%d.csv", fromL3, BROADCAST_REMOTE_L3S);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        runBroadcastFifoBench(rings, 1, "ring", reportName);
+        free(reportName);
+    }
+
+    //Relay tree
+    if(CORES_PER_L3>1){
+        broadcast_ring_desc_t rings[BROADCAST_REMOTE_L3S+1];
+        rings[0].producerCPU = producerCPU;
+        rings[0].numReaders = BROADCAST_REMOTE_L3S;
+        for(int l3 = 0; l3<BROADCAST_REMOTE_L3S; l3++){
+            int relayCPU = CORE_MAP[fromL3+l3+1][0];
+            rings[0].readerCPUs[l3] = relayCPU;
+
+            rings[l3+1].producerCPU = relayCPU;
+            rings[l3+1].numReaders = CORES_PER_L3-1;
+            for(int i = 1; i<CORES_PER_L3; i++){
+                rings[l3+1].readerCPUs[i-1] = CORE_MAP[fromL3+l3+1][i];
+            }
+        }
+
+        snprintf(reportNameSuffix, 120, "_broadcast_relayTree_fromL3-%d_numL3-%d.csv", fromL3, BROADCAST_REMOTE_L3S);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        runBroadcastFifoBench(rings, BROADCAST_REMOTE_L3S+1, "relayTree", reportName);
+        free(reportName);
+    }
+}
+
+/**
+ * A partition thread on the first core of l3 with M input FIFOs and N output FIFOs.  Each input FIFO is fed by a server thread
+ * and each output FIFO is drained by a client thread on its own core (placed according to MULTI_PORT_PEER_PLACEMENT).
+ *
+ * Sweeps combiners (M inputs, 1 output), splitters (1 input, N outputs), and symmetric partitions (M inputs, M outputs) with
+ * port counts that are powers of 2 up to MULTI_PORT_MAX_PORTS.  Configurations with more peers than available cores are skipped.
+ * A summary of the ready check overhead and aggregate throughput of each configuration is written to _multiPort_summary_L3-<l3>.csv
+ */
+void runMultiPortPartition(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== MultiPortPartition ===\n");
+
+    int partitionCPU = CORE_MAP[l3][0];
+
+    //Peers are assigned in this order, alternating between inputs and outputs so that both see similar placements
+    int peerCPUs[L3_S*CORES_PER_L3];
+    int numPeerCPUs = 0;
+    if(MULTI_PORT_PEER_PLACEMENT == MULTI_PORT_PEER_PLACEMENT_NEAR){
+        for(int i = 1; i<CORES_PER_L3; i++){
+            peerCPUs[numPeerCPUs++] = CORE_MAP[l3][i];
+        }
+    }
+    for(int peerL3 = l3+1; peerL3<L3_S; peerL3++){
+        for(int i = 0; i<CORES_PER_L3; i++){
+            peerCPUs[numPeerCPUs++] = CORE_MAP[peerL3][i];
+        }
+    }
+
+    char summarySuffix[80];
+    snprintf(summarySuffix, 80, "_multiPort_summary_L3-%d.csv", l3);
+    char* summaryName = genReportName(reportPrefix, summarySuffix);
+    FILE* summaryFile = fopen(summaryName, "w");
+    writePartitionSummaryHeader(summaryFile);
+
+    //{M, N} configurations: combiners, splitters, then symmetric
+    //Each sweep has at most MULTI_PORT_MAX_PORTS (power of 2) entries
+    int configs[3*MULTI_PORT_MAX_PORTS][2];
+    int numConfigs = 0;
+    for(int ports = 1; ports<=MULTI_PORT_MAX_PORTS; ports*=2){
+        configs[numConfigs][0] = ports;
+        configs[numConfigs][1] = 1;
+        numConfigs++;
+    }
+    for(int ports = 2; ports<=MULTI_PORT_MAX_PORTS; ports*=2){
+        configs[numConfigs][0] = 1;
+        configs[numConfigs][1] = ports;
+        numConfigs++;
+    }
+    for(int ports = 2; ports<=MULTI_PORT_MAX_PORTS; ports*=2){
+        configs[numConfigs][0] = ports;
+        configs[numConfigs][1] = ports;
+        numConfigs++;
+    }
+
+    for(int c = 0; c<numConfigs; c++){
+        int numInputs = configs[c][0];
+        int numOutputs = configs[c][1];
+        if(numInputs+numOutputs > numPeerCPUs){
+            printf("Warning: %d inputs and %d outputs requires more peer cores than are available (%d) ... skipping\n", numInputs, numOutputs, numPeerCPUs);
+            continue;
+        }
+
+        int inputCPUs[numInputs];
+        int outputCPUs[numOutputs];
+        int inputInd = 0;
+        int outputInd = 0;
+        for(int peer = 0; inputInd<numInputs || outputInd<numOutputs; ){
+            if(inputInd<numInputs){
+                inputCPUs[inputInd++] = peerCPUs[peer++];
+            }
+            if(outputInd<numOutputs){
+                outputCPUs[outputInd++] = peerCPUs[peer++];
+            }
+        }
+
+        char reportNameSuffix[120];
+        snprintf(reportNameSuffix, 120, "_multiPort_L3-%d_inputs-%d_outputs-%d.csv", l3, numInputs, numOutputs);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        runLaminarPartitionBench(partitionCPU, inputCPUs, numInputs, outputCPUs, numOutputs, reportName, summaryFile);
+        free(reportName);
+    }
+
+    fclose(summaryFile);
+    free(summaryName);
+}
+
+/**
+ * K logical channels between a pair of cores carried over one coalesced ring and over K independent Laminar FIFOs.
+ * K is swept over powers of 2 up to COALESCED_MAX_CHANNELS for a pair of cores in l3 and a pair of cores in l3 and l3+1.
+ *
+ * Note: the independent FIFOs use the untimed partition thread (fifo_partition_thread_untimed in laminarFifoPartition.h) so that, like
+ * the coalesced FIFO, they do not time their ready checks
+ */
+void runCoalescedFifo(char* reportPrefix, int l3){
+    static_assert(CORES_PER_L3>1, "Intra-L3 Test Requires >1 Core Per L3");
+    assert(l3>=0 && l3+1<L3_S);
+    printf("=== CoalescedFifo ===\n");
+
+    for(int inter = 0; inter<2; inter++){
+        int serverCPU = CORE_MAP[l3][0];
+        int clientCPU = inter ? CORE_MAP[l3+1][0] : CORE_MAP[l3][1];
+
+        char reportNameSuffix[80];
+        if(inter){
+            snprintf(reportNameSuffix, 80, "_coalesced_interL3_L3A-%d_L3B-%d.csv", l3, l3+1);
+        }else{
+            snprintf(reportNameSuffix, 80, "_coalesced_intraL3_L3-%d_L3CPUA-%d_L3CPUB-%d.csv", l3, 0, 1);
+        }
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        FILE* reportFile = fopen(reportName, "w");
+        writeChannelFifoHeader(reportFile);
+
+        for(int channels = 1; channels<=COALESCED_MAX_CHANNELS; channels*=2){
+            runChannelFifoBench(serverCPU, clientCPU, channels, CHANNEL_FIFO_MODE_INDEPENDENT, reportFile);
+            runChannelFifoBench(serverCPU, clientCPU, channels, CHANNEL_FIFO_MODE_COALESCED, reportFile);
+        }
+
+        fclose(reportFile);
+        free(reportName);
+    }
+}
+
+/**
+ * Latency vs. offered load for a paced producer (see pacedFifo.h) at each topology level: a pair of cores in l3, a pair of cores in
+ * l3 and l3+1, and (if there is more than 1 socket) a pair of cores in l3 and the same L3 on the next socket.
+ *
+ * The saturation rate of each pair is measured first (unpaced).  The offered load is then swept as a percentage of that rate.
+ */
+void runPacedLoadSweep(char* reportPrefix, int l3){
+    static_assert(CORES_PER_L3>1, "Intra-L3 Test Requires >1 Core Per L3");
+    assert(l3>=0 && l3+1<L3_S);
+    printf("=== PacedLoadSweep ===\n");
+
+    const char* levels[3] = {"IntraL3", "InterL3", "InterSocket"};
+    int clientCPUs[3] = {CORE_MAP[l3][1], CORE_MAP[l3+1][0], L3_S > L3S_PER_SOCKET ? CORE_MAP[(l3+L3S_PER_SOCKET)%L3_S][0] : -1};
+    int serverCPU = CORE_MAP[l3][0];
+
+    for(int level = 0; level<3; level++){
+        if(clientCPUs[level] < 0){
+            continue;
+        }
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_paced_%s_%s_L3-%d.csv", levels[level], getPacedProfileName(PACED_PROFILE), l3);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        FILE* reportFile = fopen(reportName, "w");
+        writePacedFifoHeader(reportFile);
+
+        double capacity = runPacedFifoBench(serverCPU, clientCPUs[level], levels[level], 0, 0, PACED_PROFILE, reportFile, NULL);
+
+        for(int loadPct = PACED_LOAD_STEP_PCT; loadPct<=PACED_LOAD_MAX_PCT; loadPct+=PACED_LOAD_STEP_PCT){
+            char* blockReportName = NULL;
+            #if PACED_BLOCK_REPORT
+                char blockReportTag[32];
+                snprintf(blockReportTag, 32, "_blocks_load-%d", loadPct);
+                blockReportName = genDerivedReportName(reportName, blockReportTag);
+            #endif
+
+            runPacedFifoBench(serverCPU, clientCPUs[level], levels[level], capacity*loadPct/100.0, loadPct/100.0, PACED_PROFILE, reportFile, blockReportName);
+            free(blockReportName);
+        }
+
+        fclose(reportFile);
+        free(reportName);
+    }
+}
+
+/**
+ * The noise profile (see osNoise.h) of every core in the core map.  A probe which only spins on the TSC is run on each core, first on
+ * all cores at once and then on one core at a time (which excludes noise caused by the other probes, ex. shared power limits)
+ */
+void runOsNoiseScan(char* reportPrefix){
+    printf("=== OsNoiseScan ===\n");
+
+    int cpus[L3_S*CORES_PER_L3];
+    for(int l3 = 0; l3<L3_S; l3++){
+        for(int i = 0; i<CORES_PER_L3; i++){
+            cpus[l3*CORES_PER_L3+i] = CORE_MAP[l3][i];
+        }
+    }
+
+    char* reportName = genReportName(reportPrefix, "_osNoiseScan_allCores.csv");
+    runOsNoiseProbeBench(cpus, L3_S*CORES_PER_L3, OS_NOISE_PROBE_SEC, reportName);
+    free(reportName);
+
+    for(int i = 0; i<L3_S*CORES_PER_L3; i++){
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_osNoiseScan_CPU-%d.csv", cpus[i]);
+        reportName = genReportName(reportPrefix, reportNameSuffix);
+        runOsNoiseProbeBench(cpus+i, 1, OS_NOISE_PROBE_SEC, reportName);
+        free(reportName);
+    }
+}
+
+//====== Topology Level Tests ========
+//The level (see topologyHelpers.h) of each pair of cores is read from sysfs at runtime rather than derived from the core map so that the
+//tests follow the NUMA (NPS) mode and the number of sockets.  Levels which no pair of cores in the core map are at are skipped
+
+/**
+ * Reads the location (see topologyHelpers.h) of each core in the core map
+ */
+static void readCoreMapLocations(topology_location_t locations[L3_S][CORES_PER_L3]){
+    for(int l3 = 0; l3<L3_S; l3++){
+        for(int i = 0; i<CORES_PER_L3; i++){
+            getTopologyLocation(CORE_MAP[l3][i], &(locations[l3][i]));
+        }
+    }
+}
+
+/**
+ * Pairs cores in the core map which are at the given topology level using the locations from readCoreMapLocations.  Cores are taken in
+ * core map order starting from startL3 and each core is paired with the first unpaired core after it which is at the level.  Each core
+ * is used at most once
+ * @returns the number of pairs
+ */
+static int pairCoreMapLocationsAtLevel(topology_location_t locations[L3_S][CORES_PER_L3], int level, int startL3, int maxPairs, int* serverCPUs, int* clientCPUs){
+    topology_location_t* cpus[L3_S*CORES_PER_L3];
+    for(int l3 = 0; l3<L3_S; l3++){
+        for(int i = 0; i<CORES_PER_L3; i++){
+            cpus[l3*CORES_PER_L3+i] = &(locations[(startL3+l3)%L3_S][i]);
+        }
+    }
+
+    bool used[L3_S*CORES_PER_L3] = {false};
+    int numPairs = 0;
+    for(int a = 0; a<L3_S*CORES_PER_L3 && numPairs<maxPairs; a++){
+        if(used[a]){
+            continue;
+        }
+        for(int b = a+1; b<L3_S*CORES_PER_L3; b++){
+            if(!used[b] && getTopologyLevelOfLocations(cpus[a], cpus[b]) == level){
+                used[a] = true;
+                used[b] = true;
+                serverCPUs[numPairs] = cpus[a]->cpu;
+                clientCPUs[numPairs] = cpus[b]->cpu;
+                numPairs++;
+                break;
+            }
+        }
+    }
+
+    return numPairs;
+}
+
+/**
+ * Pairs cores in the core map which are at the given topology level (see pairCoreMapLocationsAtLevel)
+ * @returns the number of pairs
+ */
+static int pairCoresAtLevel(int level, int startL3, int maxPairs, int* serverCPUs, int* clientCPUs){
+    topology_location_t locations[L3_S][CORES_PER_L3];
+    readCoreMapLocations(locations);
+    return pairCoreMapLocationsAtLevel(locations, level, startL3, maxPairs, serverCPUs, clientCPUs);
+}
+
+/**
+ * Pairs each core in fromL3 with a core at the given topology level.  The clients are spread over as many L3s as possible
+ * @returns the number of pairs
+ */
+static int pairOneToManyAtLevel(int level, int fromL3, int* serverCPUs, int* clientCPUs){
+    bool used[L3_S][CORES_PER_L3] = {{false}};
+    bool l3HasClient[L3_S] = {false};
+    int numPairs = 0;
+
+    for(int i = 0; i<CORES_PER_L3; i++){
+        if(used[fromL3][i]){
+            continue;
+        }
+        int server = CORE_MAP[fromL3][i];
+
+        int clientL3 = -1;
+        int clientIdx = -1;
+        for(int pass = 0; pass<2 && clientL3<0; pass++){ //Only L3s which do not have a client yet on the first pass
+            for(int l3Offset = 0; l3Offset<L3_S && clientL3<0; l3Offset++){
+                int l3 = (fromL3+l3Offset)%L3_S;
+                if(pass == 0 && l3HasClient[l3]){
+                    continue;
+                }
+                for(int j = 0; j<CORES_PER_L3; j++){
+                    if(!used[l3][j] && !(l3 == fromL3 && j == i) && getTopologyLevel(server, CORE_MAP[l3][j]) == level){
+                        clientL3 = l3;
+                        clientIdx = j;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if(clientL3 < 0){
+            continue;
+        }
+        used[fromL3][i] = true;
+        used[clientL3][clientIdx] = true;
+        l3HasClient[clientL3] = true;
+        serverCPUs[numPairs] = server;
+        clientCPUs[numPairs] = CORE_MAP[clientL3][clientIdx];
+        numPairs++;
+    }
+
+    return numPairs;
+}
+
+/**
+ * FIFOs between cores at the given topology level (TOPOLOGY_LEVEL_L3 to TOPOLOGY_LEVEL_CROSS_SOCKET):
+ *   singlePair: a single FIFO from the first core in l3
+ *   allPairs: as many FIFOs at the level as the core map allows, all running concurrently
+ *   oneToMany: each core in l3 to a core at the level (in different L3s where possible), all running concurrently
+ */
+void runTopologyLevelFifo(char* reportPrefix, int level, int l3){
+    assert(level>=TOPOLOGY_LEVEL_L3 && level<TOPOLOGY_LEVELS);
+    assert(l3>=0 && l3<L3_S);
+    printf("=== TopologyLevelFifo (%s) ===\n", getTopologyLevelName(level));
+
+    int serverCPUs[L3_S*CORES_PER_L3];
+    int clientCPUs[L3_S*CORES_PER_L3];
+    const char* scenarios[3] = {"singlePair", "allPairs", "oneToMany"};
+
+    for(int scenario = 0; scenario<3; scenario++){
+        int numFifos;
+        if(scenario == 2){
+            numFifos = pairOneToManyAtLevel(level, l3, serverCPUs, clientCPUs);
+        }else{
+            numFifos = pairCoresAtLevel(level, l3, scenario == 0 ? 1 : L3_S*CORES_PER_L3, serverCPUs, clientCPUs);
+        }
+        if(numFifos == 0){
+            printf("Warning: No cores in the core map are at level %s from L3 %d ... skipping\n", getTopologyLevelName(level), l3);
+            return;
+        }
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_topoLevel-%s_fifo_%s_L3-%d.csv", getTopologyLevelName(level), scenarios[scenario], l3);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        runLaminarFifoBench(serverCPUs, clientCPUs, numFifos, reportName);
+        free(reportName);
+    }
+}
+
+/**
+ * Memory readers or writers whose buffers are placed on (allocated and first touched by) a core at the given topology level
+ * (TOPOLOGY_LEVEL_L3 to TOPOLOGY_LEVEL_CROSS_SOCKET).  The scenarios are the same as runTopologyLevelFifo with the FIFO server
+ * running the memory thread and the FIFO client hosting its buffer
+ */
+void runTopologyLevelMemory(char* reportPrefix, int level, int l3, const char* memoryName, void* (*memory_thread_fun)(void*)){
+    assert(level>=TOPOLOGY_LEVEL_L3 && level<TOPOLOGY_LEVELS);
+    assert(l3>=0 && l3<L3_S);
+    printf("=== TopologyLevelMemory %s (%s) ===\n", memoryName, getTopologyLevelName(level));
+
+    int cpus[L3_S*CORES_PER_L3];
+    int bufferCPUs[L3_S*CORES_PER_L3];
+    const char* scenarios[3] = {"singlePair", "allPairs", "oneToMany"};
+
+    for(int scenario = 0; scenario<3; scenario++){
+        int numThreads;
+        if(scenario == 2){
+            numThreads = pairOneToManyAtLevel(level, l3, cpus, bufferCPUs);
+        }else{
+            numThreads = pairCoresAtLevel(level, l3, scenario == 0 ? 1 : L3_S*CORES_PER_L3, cpus, bufferCPUs);
+        }
+        if(numThreads == 0){
+            printf("Warning: No cores in the core map are at level %s from L3 %d ... skipping\n", getTopologyLevelName(level), l3);
+            return;
+        }
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_topoLevel-%s_%s_%s_L3-%d.csv", getTopologyLevelName(level), memoryName, scenarios[scenario], l3);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        runMemoryBenchPlaced(cpus, bufferCPUs, numThreads, reportName, memory_thread_fun);
+        free(reportName);
+    }
+}
+
+/**
+ * A duplex FIFO pair (see duplexFifoRunner.h) between a pair of cores at each topology level.  A single (unidirectional) FIFO between
+ * the same cores is run first as the baseline
+ */
+void runDuplexFifo(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== DuplexFifo ===\n");
+
+    char reportNameSuffix[80];
+    snprintf(reportNameSuffix, 80, "_duplex_L3-%d.csv", l3);
+    char* reportName = genReportName(reportPrefix, reportNameSuffix);
+    FILE* reportFile = fopen(reportName, "w");
+    writeDuplexFifoHeader(reportFile);
+
+    for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+        int serverCPU, clientCPU;
+        if(pairCoresAtLevel(level, l3, 1, &serverCPU, &clientCPU) == 0){
+            printf("Warning: No cores in the core map are at level %s from L3 %d ... skipping\n", getTopologyLevelName(level), l3);
+            continue;
+        }
+
+        snprintf(reportNameSuffix, 80, "_duplex_unidirectional_%s_L3-%d.csv", getTopologyLevelName(level), l3);
+        char* unidirectionalReportName = genReportName(reportPrefix, reportNameSuffix);
+        double clientTime;
+        runLaminarFifoBenchTimes(&serverCPU, &clientCPU, 1, unidirectionalReportName, NULL, &clientTime);
+        free(unidirectionalReportName);
+
+        runDuplexFifoBench(serverCPU, clientCPU, ((double) TRANSACTIONS_BLKS)*BLK_SIZE_BYTES/clientTime, reportFile);
+    }
+
+    fclose(reportFile);
+    free(reportName);
+}
+
+/**
+ * The adaptive depth FIFO (see adaptiveFifo.h) against FIFOs of fixed depths (powers of 2 from ADAPTIVE_FIFO_MIN_LEN_BLKS to
+ * ADAPTIVE_FIFO_MAX_LEN_BLKS) between a pair of cores at each topology level.  Each release profile (constant, Poisson, and burst) is
+ * run at each offered load.  The capacity the loads are relative to is the unpaced rate of a fixed FIFO of depth FIFO_LEN_BLKS
+ * (or ADAPTIVE_FIFO_MAX_LEN_BLKS if smaller)
+ */
+void runAdaptiveFifo(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== AdaptiveFifo ===\n");
+
+    int profiles[3] = {PACED_PROFILE_CONSTANT, PACED_PROFILE_POISSON, PACED_PROFILE_BURST};
+    int capacityLenBlks = FIFO_LEN_BLKS < ADAPTIVE_FIFO_MAX_LEN_BLKS ? FIFO_LEN_BLKS : ADAPTIVE_FIFO_MAX_LEN_BLKS;
+
+    for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+        int serverCPU, clientCPU;
+        if(pairCoresAtLevel(level, l3, 1, &serverCPU, &clientCPU) == 0){
+            printf("Warning: No cores in the core map are at level %s from L3 %d ... skipping\n", getTopologyLevelName(level), l3);
+            continue;
+        }
+        const char* levelName = getTopologyLevelName(level);
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_adaptiveFifo_%s_L3-%d.csv", levelName, l3);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        FILE* reportFile = fopen(reportName, "w");
+        writeAdaptiveFifoHeader(reportFile);
+
+        double capacity = runAdaptiveFifoBench(serverCPU, clientCPU, levelName, 0, 0, PACED_PROFILE_CONSTANT, capacityLenBlks, false, reportFile);
+
+        for(int profile = 0; profile<3; profile++){
+            for(int loadPct = ADAPTIVE_FIFO_LOAD_STEP_PCT; loadPct<=ADAPTIVE_FIFO_LOAD_MAX_PCT; loadPct+=ADAPTIVE_FIFO_LOAD_STEP_PCT){
+                double targetBytesPerSec = capacity*loadPct/100.0;
+                for(int lenBlks = ADAPTIVE_FIFO_MIN_LEN_BLKS; lenBlks<=ADAPTIVE_FIFO_MAX_LEN_BLKS; lenBlks*=2){
+                    runAdaptiveFifoBench(serverCPU, clientCPU, levelName, targetBytesPerSec, loadPct/100.0, profiles[profile], lenBlks, false, reportFile);
+                }
+                runAdaptiveFifoBench(serverCPU, clientCPU, levelName, targetBytesPerSec, loadPct/100.0, profiles[profile], ADAPTIVE_FIFO_INITIAL_LEN_BLKS, true, reportFile);
+            }
+        }
+
+        fclose(reportFile);
+        free(reportName);
+    }
+}
+
+/**
+ * The variable length record FIFO (see recordFifo.h) against padding every record to RECORD_FIFO_MAX_BYTES between a pair of cores at
+ * each topology level, for each size distribution.  Each is run at saturation and with records released at RECORD_FIFO_LOAD_PCT of the
+ * padded FIFO's saturation rate (the same record rate for both)
+ */
+void runRecordFifo(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== RecordFifo ===\n");
+
+    int dists[3] = {RECORD_FIFO_DIST_UNIFORM, RECORD_FIFO_DIST_BIMODAL, RECORD_FIFO_DIST_FIXED};
+
+    for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+        int serverCPU, clientCPU;
+        if(pairCoresAtLevel(level, l3, 1, &serverCPU, &clientCPU) == 0){
+            printf("Warning: No cores in the core map are at level %s from L3 %d ... skipping\n", getTopologyLevelName(level), l3);
+            continue;
+        }
+        const char* levelName = getTopologyLevelName(level);
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_recordFifo_%s_L3-%d.csv", levelName, l3);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+        FILE* reportFile = fopen(reportName, "w");
+        writeRecordFifoHeader(reportFile);
+
+        for(int dist = 0; dist<3; dist++){
+            double paddedCapacity = runRecordFifoBench(serverCPU, clientCPU, levelName, dists[dist], true, 0, 0, reportFile);
+            runRecordFifoBench(serverCPU, clientCPU, levelName, dists[dist], false, 0, 0, reportFile);
+
+            double targetRecordsPerSec = paddedCapacity*RECORD_FIFO_LOAD_PCT/100.0;
+            runRecordFifoBench(serverCPU, clientCPU, levelName, dists[dist], true, targetRecordsPerSec, RECORD_FIFO_LOAD_PCT/100.0, reportFile);
+            runRecordFifoBench(serverCPU, clientCPU, levelName, dists[dist], false, targetRecordsPerSec, RECORD_FIFO_LOAD_PCT/100.0, reportFile);
+        }
+
+        fclose(reportFile);
+        free(reportName);
+    }
+}
+
+/**
+ * The quick probe (see quickProbeRunner.h).  QUICK_PROBE_PAIRS_PER_LEVEL pairs of cores are taken at each topology level, each found
+ * starting from a different L3 (beginning with l3) so that the pairs are spread over the core map.  Each pass measures 1 pair at every
+ * level so that the cost table covers every level even if the budget (QUICK_PROBE_BUDGET_SEC) runs out.  The budget starts once the
+ * pairs have been found.
+ *
+ * Writes the cost table and the result of each pair (_pairs)
+ * @returns the number of measurements which timed out or were skipped because the budget ran out
+ */
+int runQuickProbe(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== QuickProbe ===\n");
+
+    double tscFreqHz = getTSCFreqHz(); //Calibrate before the budget starts
+    uint64_t discoveryStartTSC = readTSC();
+
+    //Find the pairs.  The location of each core is read once (the sysfs reads dominate on large core maps)
+    topology_location_t locations[L3_S][CORES_PER_L3];
+    readCoreMapLocations(locations);
+    int serverCPUs[TOPOLOGY_LEVELS][QUICK_PROBE_PAIRS_PER_LEVEL];
+    int clientCPUs[TOPOLOGY_LEVELS][QUICK_PROBE_PAIRS_PER_LEVEL];
+    int numPairs[TOPOLOGY_LEVELS] = {0};
+    for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+        for(int p = 0; p<QUICK_PROBE_PAIRS_PER_LEVEL; p++){
+            int startL3 = (l3 + p*L3_S/QUICK_PROBE_PAIRS_PER_LEVEL)%L3_S;
+            int serverCPU, clientCPU;
+            if(pairCoreMapLocationsAtLevel(locations, level, startL3, 1, &serverCPU, &clientCPU) == 0){
+                break;
+            }
+            bool duplicate = false;
+            for(int q = 0; q<numPairs[level]; q++){
+                duplicate |= serverCPUs[level][q] == serverCPU && clientCPUs[level][q] == clientCPU;
+            }
+            if(!duplicate){
+                serverCPUs[level][numPairs[level]] = serverCPU;
+                clientCPUs[level][numPairs[level]] = clientCPU;
+                numPairs[level]++;
+            }
+        }
+    }
+
+    //The budget only covers the measurements (pair discovery is reported separately)
+    uint64_t startTSC = readTSC();
+    uint64_t deadlineTSC = startTSC + (uint64_t) (QUICK_PROBE_BUDGET_SEC*tscFreqHz);
+    double discoveryTime = (startTSC - discoveryStartTSC)/tscFreqHz;
+
+    //Measure.  Each measurement gets an equal share of the remaining budget so that a stalled pair cannot use up the whole budget
+    int measurementsLeft = 0;
+    for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+        measurementsLeft += numPairs[level]*QUICK_PROBE_SIZES;
+    }
+    quick_probe_result_t *results = (quick_probe_result_t*) malloc(sizeof(quick_probe_result_t)*TOPOLOGY_LEVELS*QUICK_PROBE_SIZES*QUICK_PROBE_PAIRS_PER_LEVEL);
+    int numResults[TOPOLOGY_LEVELS][QUICK_PROBE_SIZES] = {{0}};
+    int incomplete = 0;
+    for(int p = 0; p<QUICK_PROBE_PAIRS_PER_LEVEL; p++){
+        for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+            if(p >= numPairs[level]){
+                continue;
+            }
+            for(int sizeIdx = 0; sizeIdx<QUICK_PROBE_SIZES; sizeIdx++){
+                uint64_t nowTSC = readTSC();
+                if(nowTSC >= deadlineTSC){
+                    incomplete++;
+                    measurementsLeft--;
+                    continue;
+                }
+                uint64_t measurementDeadlineTSC = nowTSC + (deadlineTSC-nowTSC)/measurementsLeft;
+                measurementsLeft--;
+
+                quick_probe_result_t *result = results + (level*QUICK_PROBE_SIZES+sizeIdx)*QUICK_PROBE_PAIRS_PER_LEVEL + numResults[level][sizeIdx];
+                runQuickProbePair(serverCPUs[level][p], clientCPUs[level][p], level, getQuickProbeTransferBlks(sizeIdx), measurementDeadlineTSC, result);
+                numResults[level][sizeIdx]++;
+                incomplete += result->timedOut ? 1 : 0;
+            }
+        }
+    }
+    double elapsed = (readTSC() - startTSC)/tscFreqHz;
+
+    //Write the reports
+    char* reportName = genReportName(reportPrefix, "_quickProbe.csv");
+    char* pairReportName = genDerivedReportName(reportName, "_pairs");
+    FILE* reportFile = fopen(reportName, "w");
+    FILE* pairReportFile = fopen(pairReportName, "w");
+    writeQuickProbeCostHeader(reportFile);
+    writeQuickProbePairHeader(pairReportFile);
+    for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+        if(numPairs[level] == 0){
+            printf("Warning: No cores in the core map are at level %s ... skipping\n", getTopologyLevelName(level));
+            continue;
+        }
+        for(int sizeIdx = 0; sizeIdx<QUICK_PROBE_SIZES; sizeIdx++){
+            quick_probe_result_t *levelResults = results + (level*QUICK_PROBE_SIZES+sizeIdx)*QUICK_PROBE_PAIRS_PER_LEVEL;
+            writeQuickProbeCostRow(reportFile, level, getQuickProbeTransferBlks(sizeIdx), levelResults, numResults[level][sizeIdx]);
+            for(int i = 0; i<numResults[level][sizeIdx]; i++){
+                writeQuickProbePairRow(pairReportFile, levelResults+i);
+            }
+        }
+    }
+    fclose(reportFile);
+    fclose(pairReportFile);
+
+    printf("Quick probe measurements took %f s (budget %f s, not counting %f s finding the pairs), %d measurements timed out or were skipped\n",
+           elapsed, (double) QUICK_PROBE_BUDGET_SEC, discoveryTime, incomplete);
+
+    free(reportName);
+    free(pairReportName);
+    free(results);
+    return incomplete;
+}
+
+//====== SMT Tests ========
+//The core maps only list 1 thread per physical core.  SMT siblings are found from thread_siblings_list at runtime
+//and tests are skipped (with a warning) if SMT is disabled
+
+/**
+ * Single FIFO between a core and its SMT sibling
+ *
+ * Trying each core in the L3 (indevidual runs).  Compare to runIntraL3SingleFifo for 2 cores in the same L3
+ */
+void runSmtSiblingSingleFifo(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== SmtSiblingSingleFifo ===\n");
+
+    for(int i = 0; i<CORES_PER_L3; i++){
+        int sibling = getFirstSmtSibling(CORE_MAP[l3][i]);
+        if(sibling < 0){
+            printf("Warning: CPU %d has no SMT sibling ... skipping\n", CORE_MAP[l3][i]);
+            continue;
+        }
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_smt_siblingFifo_L3-%d_L3CPU-%d.csv", l3, i);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+
+        int serverCPUs[1] = {CORE_MAP[l3][i]};
+        int clientCPUs[1] = {sibling};
+        runLaminarFifoBench(serverCPUs, clientCPUs, 1, reportName);
+        free(reportName);
+    }
+}
+
+/**
+ * Each core in a single L3 paired with its SMT sibling.  All FIFOs compete for the L3
+ */
+void runSmtSiblingSingleL3(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== SmtSiblingSingleL3 ===\n");
+
+    int serverCPUs[CORES_PER_L3];
+    int clientCPUs[CORES_PER_L3];
+    int numFifos = 0;
+
+    for(int i = 0; i<CORES_PER_L3; i++){
+        int sibling = getFirstSmtSibling(CORE_MAP[l3][i]);
+        if(sibling < 0){
+            printf("Warning: CPU %d has no SMT sibling ... skipping\n", CORE_MAP[l3][i]);
+            continue;
+        }
+        serverCPUs[numFifos] = CORE_MAP[l3][i];
+        clientCPUs[numFifos] = sibling;
+        numFifos++;
+    }
+
+    if(numFifos == 0){
+        return;
+    }
+
+    char reportNameSuffix[80];
+    snprintf(reportNameSuffix, 80, "_smt_siblingFifo_singleL3_L3-%d.csv", l3);
+    char* reportName = genReportName(reportPrefix, reportNameSuffix);
+
+    runLaminarFifoBench(serverCPUs, clientCPUs, numFifos, reportName);
+
+    free(reportName);
+}
+
+/**
+ * Memory readers on a core and its SMT sibling
+ *
+ * Trying each core in the L3 (indevidual runs).  Compare to runSingleMemoryReader
+ */
+void runSmtSiblingMemoryReader(char* reportPrefix, int l3){
+    assert(l3>=0 && l3<L3_S);
+    printf("=== SmtSiblingMemoryReader ===\n");
+
+    for(int i = 0; i<CORES_PER_L3; i++){
+        int sibling = getFirstSmtSibling(CORE_MAP[l3][i]);
+        if(sibling < 0){
+            printf("Warning: CPU %d has no SMT sibling ... skipping\n", CORE_MAP[l3][i]);
+            continue;
+        }
+
+        char reportNameSuffix[80];
+        snprintf(reportNameSuffix, 80, "_smt_siblingMemoryReader_L3-%d_L3CPU-%d.csv", l3, i);
+        char* reportName = genReportName(reportPrefix, reportNameSuffix);
+
+        int cpus[2] = {CORE_MAP[l3][i], sibling};
+        runMemoryBench(cpus, 2, reportName, memory_reader_thread);
+        free(reportName);
+    }
+}
+
 //====== DRAM Tests ========
 /**
  * Single core in an L3 
@@ -461,6 +1602,45 @@ void runMultipleMemoryWriterMultipleL3(char* reportPrefix, int startL3, int numL
 }
 
 int main(int argc, char *argv[]){
+
+    checkFifoHintSupport();
+
+    //Inter-process FIFO (see ipcFifo.h and runIpcFifo.sh)
+    if(argc >= 2 && strcmp(argv[1], "--ipc-server") == 0){
+        if(argc != 5){
+            fprintf(stderr, "Error: Usage: --ipc-server <shmName> <serverCPU> <reportFilename>\n");
+            return 1;
+        }
+        runIpcFifoServer(argv[2], atoi(argv[3]), argv[4]);
+        cacheStateShutdown();
+        bufferArenaShutdown();
+        workerPoolShutdown();
+        return 0;
+    }
+    if(argc >= 2 && strcmp(argv[1], "--ipc-client") == 0){
+        if(argc != 4){
+            fprintf(stderr, "Error: Usage: --ipc-client <shmName> <clientCPU>\n");
+            return 1;
+        }
+        runIpcFifoClient(argv[2], atoi(argv[3]));
+        cacheStateShutdown();
+        bufferArenaShutdown();
+        workerPoolShutdown();
+        return 0;
+    }
+
+    //Quick probe only (see quickProbeRunner.h).  Exits with 2 if any measurement timed out or did not fit in the budget
+    if(argc >= 2 && strcmp(argv[1], "--quick-probe") == 0){
+        if(argc != 3){
+            fprintf(stderr, "Error: Usage: --quick-probe <reportPrefix>\n");
+            return 1;
+        }
+        int incomplete = runQuickProbe(argv[2], START_L3);
+        cacheStateShutdown();
+        bufferArenaShutdown();
+        workerPoolShutdown();
+        return incomplete > 0 ? 2 : 0;
+    }
     
     if(argc != 2){
         fprintf(stderr, "Error: Supply a filename prefix for the report files\n");
@@ -490,6 +1670,83 @@ int main(int argc, char *argv[]){
         runInterL3OneToMultiple(filenamePrefix, START_L3_SECONDARY);
     #endif
 
+    //Run the concurrency scaling sweeps
+    #if SCALING_TESTS != 0
+        runInterL3Scaling(filenamePrefix, START_L3);
+        runIntraL3Scaling(filenamePrefix, START_L3);
+    #endif
+
+    //Run the auto-tune probe (see autoTune.py)
+    #if AUTOTUNE_TESTS != 0
+        runAutoTuneProbe(filenamePrefix, START_L3);
+    #endif
+
+    //Run the alternative SPSC FIFO algorithm comparison
+    #if ALT_FIFO_TESTS != 0
+        runAltFifoSingleFifo(filenamePrefix, START_L3);
+    #endif
+
+    //Run the broadcast (one producer to many consumers) comparison
+    #if BROADCAST_TESTS != 0
+        runInterL3Broadcast(filenamePrefix, START_L3);
+    #endif
+
+    //Run the multi-port partition (M input FIFOs, N output FIFOs) sweep
+    #if MULTI_PORT_TESTS != 0
+        runMultiPortPartition(filenamePrefix, START_L3);
+    #endif
+
+    //Run the coalesced (K channels over 1 ring) vs independent FIFO comparison
+    #if COALESCED_TESTS != 0
+        runCoalescedFifo(filenamePrefix, START_L3);
+    #endif
+
+    //Run the paced producer latency vs. offered load sweep
+    #if PACED_TESTS != 0
+        runPacedLoadSweep(filenamePrefix, START_L3);
+    #endif
+
+    //Run the per-core noise probe
+    #if OS_NOISE_TESTS != 0
+        runOsNoiseScan(filenamePrefix);
+    #endif
+
+    //Run the full-duplex FIFO pairs
+    #if DUPLEX_TESTS != 0
+        runDuplexFifo(filenamePrefix, START_L3);
+    #endif
+
+    //Run the quick probe
+    #if QUICK_PROBE_TESTS != 0
+        runQuickProbe(filenamePrefix, START_L3);
+    #endif
+
+    //Run the adaptive depth FIFO against fixed depths
+    #if ADAPTIVE_FIFO_TESTS != 0
+        runAdaptiveFifo(filenamePrefix, START_L3);
+    #endif
+
+    //Run the variable length record FIFO against padding to fixed blocks
+    #if RECORD_FIFO_TESTS != 0
+        runRecordFifo(filenamePrefix, START_L3);
+    #endif
+
+    //Run the FIFO and memory tests at each topology level
+    #if TOPOLOGY_LEVEL_TESTS != 0
+        for(int level = TOPOLOGY_LEVEL_L3; level<TOPOLOGY_LEVELS; level++){
+            runTopologyLevelFifo(filenamePrefix, level, START_L3);
+            runTopologyLevelMemory(filenamePrefix, level, START_L3, "memoryReader", memory_reader_thread);
+            runTopologyLevelMemory(filenamePrefix, level, START_L3, "memoryWriter", memory_writer_thread);
+        }
+    #endif
+
+    //Run SMT sibling tests
+    #if SMT_TESTS != 0
+        runSmtSiblingSingleFifo(filenamePrefix, START_L3);
+        runSmtSiblingSingleL3(filenamePrefix, START_L3);
+        runSmtSiblingMemoryReader(filenamePrefix, START_L3);
+    #endif
+
     //Run DRAM Tests
     #if MEM_TESTS != 0
         //Reading
@@ -513,5 +1770,9 @@ int main(int argc, char *argv[]){
         runMultipleMemoryWriterMultipleL3(filenamePrefix, START_L3_SECONDARY, 2);
     #endif
 
+    cacheStateShutdown();
+    bufferArenaShutdown();
+    workerPoolShutdown();
+
     return 0;
 }
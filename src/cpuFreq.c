@@ -0,0 +1,176 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "cpuFreq.h"
+#include "bufferArena.h"
+#include "timeHelpers.h"
+
+cpu_freq_sample_t* initCpuFreq(int core){
+    cpu_freq_sample_t* sample = (cpu_freq_sample_t*) bufferArenaAlloc(sizeof(cpu_freq_sample_t), core);
+    sample->source = CPU_FREQ_SOURCE_NONE;
+    sample->fd = -1;
+    sample->aperfStart = 0;
+    sample->aperfStop = 0;
+    sample->mperfStart = 0;
+    sample->mperfStop = 0;
+    return sample;
+}
+
+static int openPerfCycles(){
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    //The calling thread on any CPU (it is pinned)
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+void cpuFreqOpen(cpu_freq_sample_t* sample){
+    if(sample == NULL){
+        return;
+    }
+
+    char path[80];
+    snprintf(path, 80, "/dev/cpu/%d/msr", sched_getcpu());
+    int fd = open(path, O_RDONLY);
+    if(fd >= 0){
+        uint64_t val;
+        if(pread(fd, &val, sizeof(val), CPU_FREQ_MSR_APERF) == sizeof(val)){
+            sample->source = CPU_FREQ_SOURCE_MSR;
+            sample->fd = fd;
+            return;
+        }
+        close(fd);
+    }
+
+    fd = openPerfCycles();
+    if(fd >= 0){
+        sample->source = CPU_FREQ_SOURCE_PERF;
+        sample->fd = fd;
+        return;
+    }
+
+    sample->source = CPU_FREQ_SOURCE_NONE;
+    sample->fd = -1;
+}
+
+static void cpuFreqRead(cpu_freq_sample_t* sample, uint64_t* aperf, uint64_t* mperf){
+    if(sample->source == CPU_FREQ_SOURCE_MSR){
+        if(pread(sample->fd, aperf, sizeof(uint64_t), CPU_FREQ_MSR_APERF) != sizeof(uint64_t) ||
+           pread(sample->fd, mperf, sizeof(uint64_t), CPU_FREQ_MSR_MPERF) != sizeof(uint64_t)){
+            *aperf = 0;
+            *mperf = 0;
+        }
+    }else if(sample->source == CPU_FREQ_SOURCE_PERF){
+        if(read(sample->fd, aperf, sizeof(uint64_t)) != sizeof(uint64_t)){
+            *aperf = 0;
+        }
+        *mperf = 0;
+    }
+}
+
+void cpuFreqStart(cpu_freq_sample_t* sample){
+    if(sample == NULL){
+        return;
+    }
+    cpuFreqRead(sample, &(sample->aperfStart), &(sample->mperfStart));
+}
+
+void cpuFreqStop(cpu_freq_sample_t* sample){
+    if(sample == NULL){
+        return;
+    }
+    cpuFreqRead(sample, &(sample->aperfStop), &(sample->mperfStop));
+}
+
+void cpuFreqClose(cpu_freq_sample_t* sample){
+    if(sample == NULL){
+        return;
+    }
+    if(sample->fd >= 0){
+        close(sample->fd);
+    }
+    sample->fd = -1;
+}
+
+uint64_t cpuFreqCycles(cpu_freq_sample_t* sample){
+    if(sample == NULL || sample->source == CPU_FREQ_SOURCE_NONE){
+        return 0;
+    }
+    return sample->aperfStop - sample->aperfStart;
+}
+
+double cpuFreqEffectiveGHz(cpu_freq_sample_t* sample, double durationSec){
+    if(sample == NULL){
+        return 0;
+    }
+    if(sample->source == CPU_FREQ_SOURCE_MSR){
+        uint64_t mperf = sample->mperfStop - sample->mperfStart;
+        if(mperf == 0){
+            return 0;
+        }
+        //MPERF counts at the TSC frequency while the core is in C0
+        return getTSCFreqHz()*((double) cpuFreqCycles(sample))/((double) mperf)/1.0e9;
+    }else if(sample->source == CPU_FREQ_SOURCE_PERF){
+        return durationSec > 0 ? ((double) cpuFreqCycles(sample))/durationSec/1.0e9 : 0;
+    }
+    return 0;
+}
+
+const char* getCpuFreqSourceName(cpu_freq_sample_t* sample){
+    if(sample == NULL){
+        return "None";
+    }
+    switch(sample->source){
+        case CPU_FREQ_SOURCE_MSR:
+            return "APERF/MPERF";
+        case CPU_FREQ_SOURCE_PERF:
+            return "PerfCycles";
+        default:
+            return "None";
+    }
+}
+
+static bool readSysfsString(const char* path, char* str, int strLen){
+    FILE* sysfsFile = fopen(path, "r");
+    if(sysfsFile == NULL){
+        return false;
+    }
+    bool success = fgets(str, strLen, sysfsFile) != NULL;
+    fclose(sysfsFile);
+    if(success){
+        str[strcspn(str, "\n")] = '\0';
+    }
+    return success;
+}
+
+void readCpuFreqSettings(int core, cpu_freq_settings_t* settings){
+    char path[100];
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", core);
+    if(!readSysfsString(path, settings->governor, sizeof(settings->governor))){
+        strcpy(settings->governor, "NA");
+    }
+
+    //acpi-cpufreq (ex. AMD) exposes boost.  intel_pstate exposes the inverse as no_turbo
+    char val[16];
+    if(readSysfsString("/sys/devices/system/cpu/cpufreq/boost", val, sizeof(val))){
+        strcpy(settings->boost, atoi(val) ? "On" : "Off");
+    }else if(readSysfsString("/sys/devices/system/cpu/intel_pstate/no_turbo", val, sizeof(val))){
+        strcpy(settings->boost, atoi(val) ? "Off" : "On");
+    }else{
+        strcpy(settings->boost, "NA");
+    }
+}
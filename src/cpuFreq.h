@@ -0,0 +1,78 @@
+#ifndef _CPU_FREQ_H
+#define _CPU_FREQ_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//Samples the effective frequency of each benchmark thread over the timed region.
+//APERF/MPERF are read from /dev/cpu/N/msr (requires the msr module and root).  If the MSRs are not readable, perf cycles are used.
+//The files are opened before the thread signals ready and read just outside of the timed region.
+//Disabled by default so that the benchmark threads are unchanged unless sampling is requested
+#ifndef CPU_FREQ_EN
+    #define CPU_FREQ_EN (0)
+#endif
+
+#define CPU_FREQ_SOURCE_NONE (0)
+#define CPU_FREQ_SOURCE_MSR (1)
+#define CPU_FREQ_SOURCE_PERF (2)
+
+#define CPU_FREQ_MSR_MPERF (0xE7)
+#define CPU_FREQ_MSR_APERF (0xE8)
+
+typedef struct {
+    int source;
+    int fd; //The MSR or perf file descriptor (-1 if not open)
+    uint64_t aperfStart;
+    uint64_t aperfStop;
+    uint64_t mperfStart;
+    uint64_t mperfStop;
+} cpu_freq_sample_t;
+
+//The cpufreq settings of a core when a test was started
+typedef struct {
+    char governor[32];
+    char boost[16];
+} cpu_freq_settings_t;
+
+/**
+ * Allocates the sample on the given core.  Free with bufferArenaFree() after calling cpuFreqClose()
+ */
+cpu_freq_sample_t* initCpuFreq(int core);
+
+/**
+ * Opens the MSR (or perf) file for the calling thread's core.  Call from the benchmark thread before signalling ready.
+ * The cpu_freq_sample_t* may be NULL, in which case nothing is sampled.
+ */
+void cpuFreqOpen(cpu_freq_sample_t* sample);
+
+/**
+ * Call just before the timed region
+ */
+void cpuFreqStart(cpu_freq_sample_t* sample);
+
+/**
+ * Call just after the timed region
+ */
+void cpuFreqStop(cpu_freq_sample_t* sample);
+
+void cpuFreqClose(cpu_freq_sample_t* sample);
+
+/**
+ * Core cycles durring the sampled region (0 if not sampled)
+ */
+uint64_t cpuFreqCycles(cpu_freq_sample_t* sample);
+
+/**
+ * Effective frequency durring the sampled region in GHz.  For MSR samples, this is the TSC frequency scaled by APERF/MPERF.
+ * For perf samples, this is cycles/duration.  Returns 0 if not sampled.
+ */
+double cpuFreqEffectiveGHz(cpu_freq_sample_t* sample, double durationSec);
+
+const char* getCpuFreqSourceName(cpu_freq_sample_t* sample);
+
+/**
+ * Reads the cpufreq governor and boost state of the given core from sysfs.  Fields are "NA" if they cannot be read
+ */
+void readCpuFreqSettings(int core, cpu_freq_settings_t* settings);
+
+#endif
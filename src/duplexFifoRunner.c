@@ -0,0 +1,98 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "duplexFifoRunner.h"
+#include "laminarFifo.h"
+#include "testParams.h"
+#include "topologyHelpers.h"
+#include "cacheState.h"
+
+void writeDuplexFifoHeader(FILE* reportFile){
+    fprintf(reportFile, "Level,CPUA,CPUB,PreloadBlks,ATime,BTime,BytesAtoB,BytesBtoA,AtoBBytesPerSec,BtoABytesPerSec,CombinedBytesPerSec,UnidirectionalBytesPerSec,PerDirectionRatio,CombinedRatio,AInputOffsetReloads,AOutputOffsetReloads,BInputOffsetReloads,BOutputOffsetReloads,CacheState\n");
+}
+
+double runDuplexFifoBench(int cpuA, int cpuB, double unidirectionalBytesPerSec, FILE* reportFile){
+    //Create FIFOs.  FIFO i is from cpus[i] to the other core and is preloaded (the initial conditions of the loop)
+    int cpus[2] = {cpuA, cpuB};
+    laminar_fifo_t *fifos[2];
+    for(int i = 0; i<2; i++){
+        fifos[i] = laminarFifoCreate(cpus[i], cpus[1-i]);
+        laminarFifoPreload(fifos[i], DUPLEX_PRELOAD_BLKS);
+    }
+
+    //Set the cache state of the FIFOs (see cacheState.h).  The preloaded blocks are not changed
+    void* fifoBuffers[2][3];
+    size_t fifoBufferSizes[3] = {sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1), sizeof(_Atomic int8_t), sizeof(_Atomic int8_t)};
+    for(int i = 0; i<2; i++){
+        fifoBuffers[i][0] = fifos[i]->arrayPtr;
+        fifoBuffers[i][1] = fifos[i]->readOffsetPtr;
+        fifoBuffers[i][2] = fifos[i]->writeOffsetPtr;
+        cacheStateBeforeStart(fifoBuffers[i], fifoBufferSizes, 3, cpus[i], cpus[1-i]);
+    }
+
+    laminar_start_barrier_t *barrier = laminarBarrierCreate(cpus, 2);
+
+    //Start Threads
+    laminar_partition_threadArgs_t *args[2];
+    laminar_partition_stats_t *stats[2];
+    for(int i = 0; i<2; i++){
+        args[i] = (laminar_partition_threadArgs_t*) laminarAlloc(sizeof(laminar_partition_threadArgs_t), cpus[i]);
+        stats[i] = (laminar_partition_stats_t*) laminarAlloc(sizeof(laminar_partition_stats_t), cpus[i]);
+        args[i]->numInputs = 1;
+        args[i]->inputReadOffsetPtrs[0] = fifos[1-i]->readOffsetPtr;
+        args[i]->inputWriteOffsetPtrs[0] = fifos[1-i]->writeOffsetPtr;
+        args[i]->inputArrayPtrs[0] = fifos[1-i]->arrayPtr;
+        args[i]->numOutputs = 1;
+        args[i]->outputReadOffsetPtrs[0] = fifos[i]->readOffsetPtr;
+        args[i]->outputWriteOffsetPtrs[0] = fifos[i]->writeOffsetPtr;
+        args[i]->outputArrayPtrs[0] = fifos[i]->arrayPtr;
+        args[i]->startTrigger = barrier->startTrigger;
+        args[i]->readyFlag = barrier->readyFlags[i];
+        args[i]->stats = stats[i];
+    }
+    //Untimed so that, like the unidirectional baseline, the ready checks carry no instrumentation
+    for(int i = 0; i<2; i++){
+        laminarThreadStart(cpus[i], fifo_partition_thread_untimed, args[i]);
+    }
+
+    //Start FIFO transfers once all threads are ready
+    laminarBarrierWaitAllReady(barrier);
+    for(int i = 0; i<2; i++){
+        cacheStateBeforeTrigger(fifoBuffers[i], fifoBufferSizes, 3);
+    }
+    laminarBarrierRelease(barrier);
+
+    //Wait for threads to finish
+    double times[2];
+    for(int i = 0; i<2; i++){
+        double *result = (double*) laminarThreadJoin(cpus[i]);
+        times[i] = *result;
+        free(result);
+    }
+
+    //Write results.  Each direction is timed by its consumer
+    long long int bytesPerDirection = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    double aToBRate = bytesPerDirection/times[1];
+    double bToARate = bytesPerDirection/times[0];
+    double combinedRate = 2*bytesPerDirection/(times[0] > times[1] ? times[0] : times[1]);
+    fprintf(reportFile, "%s,%d,%d,%d,%e,%e,%lld,%lld,%e,%e,%e,%e,%f,%f,%ld,%ld,%ld,%ld,%s\n", getTopologyLevelName(getTopologyLevel(cpuA, cpuB)),
+            cpuA, cpuB, DUPLEX_PRELOAD_BLKS, times[0], times[1], bytesPerDirection, bytesPerDirection, aToBRate, bToARate, combinedRate,
+            unidirectionalBytesPerSec, (aToBRate+bToARate)/2/unidirectionalBytesPerSec, combinedRate/unidirectionalBytesPerSec,
+            stats[0]->inputOffsetReloads, stats[0]->outputOffsetReloads, stats[1]->inputOffsetReloads, stats[1]->outputOffsetReloads,
+            getCacheStateName(CACHE_STATE));
+    fflush(reportFile);
+
+    //Cleanup
+    for(int i = 0; i<2; i++){
+        laminarFifoDestroy(fifos[i]);
+        laminarFree(args[i]);
+        laminarFree(stats[i]);
+    }
+    laminarBarrierDestroy(barrier);
+
+    return combinedRate;
+}
@@ -0,0 +1,33 @@
+#ifndef _DUPLEX_FIFO_RUNNER_H
+#define _DUPLEX_FIFO_RUNNER_H
+
+#include <stdio.h>
+#include "laminarFifoPartition.h"
+
+/*
+ * A full-duplex pair of Laminar FIFOs between 2 cores.  Each core runs an untimed partition (fifo_partition_thread_untimed, see
+ * laminarFifoPartition.h) with 1 input FIFO (from the other core) and 1 output FIFO (to the other core) so the producer and consumer
+ * work of both directions is interleaved in one loop, as Laminar emits it for a feedback loop.
+ *
+ * Like a Laminar feedback loop, the FIFOs need initial blocks (the loop would deadlock with both partitions waiting on an empty input).
+ * Each FIFO is preloaded with DUPLEX_PRELOAD_BLKS blocks.  They also need a free slot (the loop would deadlock with both partitions
+ * waiting on a full output), so 1 <= DUPLEX_PRELOAD_BLKS < FIFO_LEN_BLKS (checked at build time when DUPLEX_TESTS is set)
+ */
+
+#ifndef DUPLEX_PRELOAD_BLKS
+    #define DUPLEX_PRELOAD_BLKS (FIFO_LEN_BLKS/2)
+#endif
+
+/**
+ * Runs a duplex FIFO pair between cpuA and cpuB and appends a row to reportFile (see writeDuplexFifoHeader)
+ * @param unidirectionalBytesPerSec the rate of a single (unidirectional) Laminar FIFO between the same cores, used as the baseline
+ * @returns the combined rate (bytes/s) of both directions
+ */
+double runDuplexFifoBench(int cpuA, int cpuB, double unidirectionalBytesPerSec, FILE* reportFile);
+
+/**
+ * Writes the header for the rows appended by runDuplexFifoBench
+ */
+void writeDuplexFifoHeader(FILE* reportFile);
+
+#endif
@@ -0,0 +1,166 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include "fastForwardFifo.h"
+#include "timeHelpers.h"
+#include "testParams.h"
+#include "bufferArena.h"
+
+static void* fast_forward_init(int serverCore, int clientCore){
+    fast_forward_fifo_t *fifo = (fast_forward_fifo_t*) bufferArenaAlloc(sizeof(fast_forward_fifo_t), serverCore);
+    fifo->slots = (fast_forward_slot_t*) bufferArenaAlloc(sizeof(fast_forward_slot_t)*SPSC_FIFO_SLOTS, serverCore);
+
+    for(int i = 0; i<SPSC_FIFO_SLOTS; i++){
+        atomic_init(&(fifo->slots[i].full), 0);
+    }
+    if(!atomic_is_lock_free(&(fifo->slots[0].full))){
+        printf("Warning: A FastForward slot flag was expected to be lock free but is not\n");
+    }
+
+    return fifo;
+}
+
+static void fast_forward_cleanup(void* fifo_uncast){
+    fast_forward_fifo_t *fifo = (fast_forward_fifo_t*) fifo_uncast;
+    bufferArenaFree(fifo->slots);
+    bufferArenaFree(fifo);
+}
+
+static int fast_forward_get_buffers(void* fifo_uncast, void** buffers, size_t* sizes){
+    fast_forward_fifo_t *fifo = (fast_forward_fifo_t*) fifo_uncast;
+    buffers[0] = fifo->slots;
+    sizes[0] = sizeof(fast_forward_slot_t)*SPSC_FIFO_SLOTS;
+    return 1;
+}
+
+static void *fast_forward_server_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    fast_forward_fifo_t *fifo = (fast_forward_fifo_t*) args_cast->fifo;
+    fast_forward_slot_t *slots = fifo->slots;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    int head = 0; //Private to the producer
+    PartitionCrossingFIFO_t writeTmp;
+    memset(&writeTmp, 0, sizeof(PartitionCrossingFIFO_t));
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "=rm" (writeTmp)
+        : 
+        :);
+
+        //Wait for the slot to be emptied by the consumer
+        while(atomic_load_explicit(&(slots[head].full), memory_order_acquire)){}
+
+        copyBlkToFifo(&(slots[head].blk), &writeTmp);
+        atomic_store_explicit(&(slots[head].full), 1, memory_order_release);
+
+        head = head >= SPSC_FIFO_SLOTS-1 ? 0 : head+1;
+    }
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+static void *fast_forward_client_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    fast_forward_fifo_t *fifo = (fast_forward_fifo_t*) args_cast->fifo;
+    fast_forward_slot_t *slots = fifo->slots;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    int tail = 0; //Private to the consumer
+    PartitionCrossingFIFO_t readTmp;
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //Wait for the slot to be filled by the producer
+        while(!atomic_load_explicit(&(slots[tail].full), memory_order_acquire)){}
+
+        copyBlkFromFifo(&readTmp, &(slots[tail].blk));
+        atomic_store_explicit(&(slots[tail].full), 0, memory_order_release);
+
+        tail = tail >= SPSC_FIFO_SLOTS-1 ? 0 : tail+1;
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        :
+        : "rm" (readTmp)
+        :);
+    }
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+const spsc_fifo_impl_t FAST_FORWARD_FIFO_IMPL = {
+    .name = "fastForward",
+    .init = fast_forward_init,
+    .cleanup = fast_forward_cleanup,
+    .getBuffers = fast_forward_get_buffers,
+    .server_thread = fast_forward_server_thread,
+    .client_thread = fast_forward_client_thread
+};
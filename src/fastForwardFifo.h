@@ -0,0 +1,24 @@
+#ifndef _FAST_FORWARD_FIFO_H
+#define _FAST_FORWARD_FIFO_H
+
+#include "spscFifoCommon.h"
+#include "testParams.h"
+
+/*
+ * FastForward (Giacomoni et al., PPoPP 2008)
+ * Each slot carries a full flag.  There are no shared head/tail indices, the producer and consumer
+ * only communicate through the flags in the slots.
+ */
+
+typedef struct {
+    PartitionCrossingFIFO_t blk;
+    _Atomic int32_t full __attribute__((aligned(VITIS_MEM_ALIGNMENT))); //On its own line after the block
+} fast_forward_slot_t;
+
+typedef struct {
+    fast_forward_slot_t *slots; //SPSC_FIFO_SLOTS, allocated on the server core
+} fast_forward_fifo_t;
+
+extern const spsc_fifo_impl_t FAST_FORWARD_FIFO_IMPL;
+
+#endif
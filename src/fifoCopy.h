@@ -0,0 +1,63 @@
+#ifndef _FIFO_COPY_H
+#define _FIFO_COPY_H
+
+#include <string.h>
+#include <immintrin.h>
+#include "laminarFifoCommon.h"
+
+//The method used to copy blocks into and out of the FIFO array
+#define FIFO_COPY_ENGINE_MEMCPY_INLINE (0) //__builtin_memcpy_inline (what Laminar emits)
+#define FIFO_COPY_ENGINE_MEMCPY (1) //libc memcpy
+#define FIFO_COPY_ENGINE_NON_TEMPORAL (2) //Non-temporal (streaming) stores into the FIFO, __builtin_memcpy_inline out of the FIFO
+
+#ifndef FIFO_COPY_ENGINE
+    #define FIFO_COPY_ENGINE FIFO_COPY_ENGINE_MEMCPY_INLINE
+#endif
+
+#if FIFO_COPY_ENGINE == FIFO_COPY_ENGINE_NON_TEMPORAL
+    #ifdef __AVX__
+        #define FIFO_COPY_NT_VEC_BYTES (32)
+    #else
+        #define FIFO_COPY_NT_VEC_BYTES (16)
+    #endif
+    _Static_assert(sizeof(PartitionCrossingFIFO_t)%FIFO_COPY_NT_VEC_BYTES == 0, "Non-temporal copy engine requires the block size to be a multiple of the vector size");
+#endif
+
+/**
+ * Copies a block into the FIFO array.  Any required store fence is issued before returning so that
+ * the write offset can be published with a release store afterwards
+ */
+static inline void copyBlkToFifo(PartitionCrossingFIFO_t* dst, PartitionCrossingFIFO_t* src){
+    #if FIFO_COPY_ENGINE == FIFO_COPY_ENGINE_MEMCPY_INLINE
+        __builtin_memcpy_inline(dst, src, sizeof(PartitionCrossingFIFO_t));
+    #elif FIFO_COPY_ENGINE == FIFO_COPY_ENGINE_MEMCPY
+        memcpy(dst, src, sizeof(PartitionCrossingFIFO_t));
+    #elif FIFO_COPY_ENGINE == FIFO_COPY_ENGINE_NON_TEMPORAL
+        char* dstChar = (char*) dst;
+        char* srcChar = (char*) src;
+        for(size_t i = 0; i<sizeof(PartitionCrossingFIFO_t); i+=FIFO_COPY_NT_VEC_BYTES){
+            #ifdef __AVX__
+                _mm256_stream_si256((__m256i*) (dstChar+i), _mm256_loadu_si256((__m256i*) (srcChar+i)));
+            #else
+                _mm_stream_si128((__m128i*) (dstChar+i), _mm_loadu_si128((__m128i*) (srcChar+i)));
+            #endif
+        }
+        //Non-temporal stores are not ordered by the release store of the write offset
+        _mm_sfence();
+    #else
+        #error Unknown FIFO_COPY_ENGINE
+    #endif
+}
+
+/**
+ * Copies a block out of the FIFO array
+ */
+static inline void copyBlkFromFifo(PartitionCrossingFIFO_t* dst, PartitionCrossingFIFO_t* src){
+    #if FIFO_COPY_ENGINE == FIFO_COPY_ENGINE_MEMCPY
+        memcpy(dst, src, sizeof(PartitionCrossingFIFO_t));
+    #else
+        __builtin_memcpy_inline(dst, src, sizeof(PartitionCrossingFIFO_t));
+    #endif
+}
+
+#endif
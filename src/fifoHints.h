@@ -0,0 +1,99 @@
+#ifndef _FIFO_HINTS_H
+#define _FIFO_HINTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <cpuid.h>
+#include "laminarFifoCommon.h"
+
+//Cache hints issued by the FIFO server (producer) and client (consumer)
+
+//The client prefetches the slot FIFO_CONSUMER_PREFETCH_DIST_BLKS ahead of the slot it is reading (0 disables prefetching)
+#ifndef FIFO_CONSUMER_PREFETCH_DIST_BLKS
+    #define FIFO_CONSUMER_PREFETCH_DIST_BLKS (0)
+#endif
+
+#define FIFO_CONSUMER_PREFETCH_HINT_READ (0) //prefetcht0
+#define FIFO_CONSUMER_PREFETCH_HINT_WRITE (1) //prefetchw (requests the line in an exclusive state)
+
+#ifndef FIFO_CONSUMER_PREFETCH_HINT
+    #define FIFO_CONSUMER_PREFETCH_HINT FIFO_CONSUMER_PREFETCH_HINT_READ
+#endif
+
+//The hint issued by the server on each line of a block after it is written into the FIFO
+#define FIFO_PRODUCER_HINT_NONE (0)
+#define FIFO_PRODUCER_HINT_CLDEMOTE (1) //Demote the line to a shared cache level (executes as a NOP if not supported)
+#define FIFO_PRODUCER_HINT_CLWB (2) //Write back the line without invalidating it
+
+#ifndef FIFO_PRODUCER_HINT
+    #define FIFO_PRODUCER_HINT FIFO_PRODUCER_HINT_NONE
+#endif
+
+#define FIFO_HINT_LINE_BYTES (64)
+
+_Static_assert(FIFO_CONSUMER_PREFETCH_DIST_BLKS >= 0 && FIFO_CONSUMER_PREFETCH_DIST_BLKS <= FIFO_LEN_BLKS, "FIFO_CONSUMER_PREFETCH_DIST_BLKS must be in [0, FIFO_LEN_BLKS]");
+
+/**
+ * Prefetches the slot FIFO_CONSUMER_PREFETCH_DIST_BLKS after readOffset in a FIFO whose slots are blksPerSlot blocks (ex. a coalesced FIFO).
+ * Call before copying the slot at readOffset out of the FIFO
+ */
+static inline void fifoConsumerPrefetchSlot(PartitionCrossingFIFO_t* array, int readOffset, int blksPerSlot){
+    #if FIFO_CONSUMER_PREFETCH_DIST_BLKS > 0
+        int prefetchOffset = readOffset + FIFO_CONSUMER_PREFETCH_DIST_BLKS;
+        if(prefetchOffset > FIFO_LEN_BLKS){
+            prefetchOffset -= FIFO_LEN_BLKS+1;
+        }
+        char* slot = (char*) (array + prefetchOffset*blksPerSlot);
+        for(size_t i = 0; i<sizeof(PartitionCrossingFIFO_t)*blksPerSlot; i+=FIFO_HINT_LINE_BYTES){
+            __builtin_prefetch(slot+i, FIFO_CONSUMER_PREFETCH_HINT == FIFO_CONSUMER_PREFETCH_HINT_WRITE, 3);
+        }
+    #endif
+}
+
+/**
+ * Prefetches the slot FIFO_CONSUMER_PREFETCH_DIST_BLKS after readOffset.  Call before copying the block at readOffset out of the FIFO
+ */
+static inline void fifoConsumerPrefetch(PartitionCrossingFIFO_t* array, int readOffset){
+    fifoConsumerPrefetchSlot(array, readOffset, 1);
+}
+
+/**
+ * Issues FIFO_PRODUCER_HINT on each line of a block just written into the FIFO.  Call before the write offset is published
+ */
+static inline void fifoProducerHint(PartitionCrossingFIFO_t* blk){
+    #if FIFO_PRODUCER_HINT != FIFO_PRODUCER_HINT_NONE
+        char* blkChar = (char*) blk;
+        for(size_t i = 0; i<sizeof(PartitionCrossingFIFO_t); i+=FIFO_HINT_LINE_BYTES){
+            #if FIFO_PRODUCER_HINT == FIFO_PRODUCER_HINT_CLDEMOTE
+                asm volatile("cldemote %0" : : "m" (*(blkChar+i)));
+            #elif FIFO_PRODUCER_HINT == FIFO_PRODUCER_HINT_CLWB
+                asm volatile("clwb %0" : "+m" (*(blkChar+i)));
+            #else
+                #error Unknown FIFO_PRODUCER_HINT
+            #endif
+        }
+    #endif
+}
+
+/**
+ * Checks that the CPU supports the selected producer hint.  Exits if the hint would fault.
+ */
+static inline void checkFifoHintSupport(){
+    #if FIFO_PRODUCER_HINT != FIFO_PRODUCER_HINT_NONE
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx);
+        #if FIFO_PRODUCER_HINT == FIFO_PRODUCER_HINT_CLDEMOTE
+            if(!(ecx & (1 << 25))){
+                printf("Warning: CPU does not support cldemote.  The FIFO producer hint will execute as a NOP\n");
+            }
+        #elif FIFO_PRODUCER_HINT == FIFO_PRODUCER_HINT_CLWB
+            if(!(ebx & (1 << 24))){
+                printf("CPU does not support clwb (FIFO_PRODUCER_HINT) ... exiting\n");
+                exit(1);
+            }
+        #endif
+    #endif
+}
+
+#endif
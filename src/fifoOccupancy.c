@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fifoOccupancy.h"
+#include "bufferArena.h"
+
+fifo_occupancy_t* initFifoOccupancy(int core){
+    //The arena touches the histogram and ring when they are first allocated so that page faults do not occur durring the timed region
+    fifo_occupancy_t* occupancy = (fifo_occupancy_t*) bufferArenaAlloc(sizeof(fifo_occupancy_t), core);
+    memset(occupancy->hist, 0, sizeof(occupancy->hist));
+    occupancy->numSamples = 0;
+    occupancy->numPoints = 0;
+    occupancy->current.occupancySum = 0;
+    occupancy->current.numSamples = 0;
+    return occupancy;
+}
+
+/**
+ * The smallest occupancy which at least pct percent of the samples are at or below
+ */
+static int fifoOccupancyPercentile(fifo_occupancy_t *occupancy, double pct){
+    int64_t rank = (int64_t) ceil(pct/100.0*occupancy->numSamples);
+    int64_t count = 0;
+    for(int blks = 0; blks<=FIFO_LEN_BLKS; blks++){
+        count += occupancy->hist[blks];
+        if(count >= rank){
+            return blks;
+        }
+    }
+    return FIFO_LEN_BLKS;
+}
+
+void writeFifoOccupancyHeader(FILE* summaryFile, FILE* histFile, FILE* seriesFile){
+    fprintf(summaryFile, "Role,ServerCPU,ClientCPU,FifoLenBlks,SampleBlks,Samples,MeanOccupancyBlks,P50OccupancyBlks,P99OccupancyBlks,MaxOccupancyBlks,EmptySamples,FullSamples,NoStallLenBlksLowerBound\n");
+    fprintf(histFile, "Role,ServerCPU,ClientCPU,FifoLenBlks,OccupancyBlks,Samples,Fraction\n");
+    fprintf(seriesFile, "Role,ServerCPU,ClientCPU,Point,EndBlk,TSC,Samples,MinOccupancyBlks,MaxOccupancyBlks,MeanOccupancyBlks\n");
+}
+
+void writeFifoOccupancy(FILE* summaryFile, FILE* histFile, FILE* seriesFile, const char* role, int serverCPU, int clientCPU, fifo_occupancy_t *occupancy){
+    int64_t occupancySum = 0;
+    int maxOccupancy = 0;
+    for(int blks = 0; blks<=FIFO_LEN_BLKS; blks++){
+        occupancySum += blks*occupancy->hist[blks];
+        if(occupancy->hist[blks] > 0){
+            maxOccupancy = blks;
+        }
+        fprintf(histFile, "%s,%d,%d,%d,%d,%ld,%e\n", role, serverCPU, clientCPU, FIFO_LEN_BLKS, blks, occupancy->hist[blks],
+                occupancy->numSamples > 0 ? ((double) occupancy->hist[blks])/occupancy->numSamples : NAN);
+    }
+
+    fprintf(summaryFile, "%s,%d,%d,%d,%ld,%ld,", role, serverCPU, clientCPU, FIFO_LEN_BLKS, FIFO_OCCUPANCY_SAMPLE_BLKS, occupancy->numSamples);
+    if(occupancy->numSamples > 0){
+        fprintf(summaryFile, "%e,%d,%d,%d,", ((double) occupancySum)/occupancy->numSamples, fifoOccupancyPercentile(occupancy, 50),
+                fifoOccupancyPercentile(occupancy, 99), maxOccupancy);
+    }else{
+        fprintf(summaryFile, "NA,NA,NA,NA,");
+    }
+    fprintf(summaryFile, "%ld,%ld,", occupancy->hist[0], occupancy->hist[FIFO_LEN_BLKS]);
+    //The server needs 1 free slot to write the block after the occupancy it observed.  If it found the FIFO full, the FIFO was too
+    //shallow for this run and a deeper FIFO is needed to find the depth which avoids stalls.  Only 1 in FIFO_OCCUPANCY_SAMPLE_BLKS blocks
+    //is sampled so a peak (or stall) on an unsampled block is missed: this is a lower bound on the depth which avoids stalls
+    if(strcmp(role, "Server") == 0 && occupancy->numSamples > 0 && occupancy->hist[FIFO_LEN_BLKS] == 0){
+        fprintf(summaryFile, "%d\n", maxOccupancy+1);
+    }else{
+        fprintf(summaryFile, "NA\n");
+    }
+
+    //The ring may have wrapped, only the last FIFO_OCCUPANCY_MAX_POINTS are available
+    int64_t firstPoint = occupancy->numPoints > FIFO_OCCUPANCY_MAX_POINTS ? occupancy->numPoints - FIFO_OCCUPANCY_MAX_POINTS : 0;
+    for(int64_t point = firstPoint; point<occupancy->numPoints; point++){
+        fifo_occupancy_point_t *p = occupancy->points + (point & (FIFO_OCCUPANCY_MAX_POINTS-1));
+        fprintf(seriesFile, "%s,%d,%d,%ld,%ld,%lu,%ld,%d,%d,%e\n", role, serverCPU, clientCPU, point, p->endBlk, p->tsc, p->numSamples,
+                p->minOccupancy, p->maxOccupancy, ((double) p->occupancySum)/p->numSamples);
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef _FIFO_OCCUPANCY_H
+#define _FIFO_OCCUPANCY_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "timeHelpers.h"
+#include "laminarFifoParams.h"
+
+//Records the occupancy of the FIFO (the number of blocks in it) as seen by each side, into a histogram and a decimated time series.
+//The occupancy is computed from the offsets the thread already has, so no additional loads of the other side's offset are made.
+//If the cached offsets show the FIFO full (server) or empty (client), the sample is taken right after the wait loop's first reload
+//of the other side's offset.  Otherwise the cached offsets are used.  The other side's offset may still be stale so the server's view
+//is an upper bound of the true occupancy and the client's view is a lower bound.  An occupancy of FIFO_LEN_BLKS (server) or 0 (client)
+//means the FIFO was still full (empty) after the reload and the thread stalled
+#ifndef FIFO_OCCUPANCY_EN
+    #define FIFO_OCCUPANCY_EN (0)
+#endif
+
+//The occupancy is sampled every 2^FIFO_OCCUPANCY_SAMPLE_LOG2_BLKS blocks
+#ifndef FIFO_OCCUPANCY_SAMPLE_LOG2_BLKS
+    #define FIFO_OCCUPANCY_SAMPLE_LOG2_BLKS (2)
+#endif
+
+//A time series point (min, max, and mean occupancy) is recorded every 2^FIFO_OCCUPANCY_DECIMATION_LOG2 samples
+#ifndef FIFO_OCCUPANCY_DECIMATION_LOG2
+    #define FIFO_OCCUPANCY_DECIMATION_LOG2 (8)
+#endif
+
+//Must be a power of 2.  If more points are recorded, the oldest points are overwritten
+#ifndef FIFO_OCCUPANCY_MAX_POINTS
+    #define FIFO_OCCUPANCY_MAX_POINTS (8192)
+#endif
+
+#define FIFO_OCCUPANCY_SAMPLE_BLKS (((int64_t) 1) << FIFO_OCCUPANCY_SAMPLE_LOG2_BLKS)
+#define FIFO_OCCUPANCY_DECIMATION (((int64_t) 1) << FIFO_OCCUPANCY_DECIMATION_LOG2)
+
+_Static_assert((FIFO_OCCUPANCY_MAX_POINTS & (FIFO_OCCUPANCY_MAX_POINTS-1)) == 0, "FIFO_OCCUPANCY_MAX_POINTS must be a power of 2");
+
+typedef struct {
+    uint64_t tsc; //TSC when the last sample of the point was taken
+    int64_t endBlk; //The block the last sample of the point was taken before
+    int32_t minOccupancy;
+    int32_t maxOccupancy;
+    int64_t occupancySum; //Over the samples in the point
+    int64_t numSamples;
+} fifo_occupancy_point_t;
+
+typedef struct {
+    int64_t hist[FIFO_LEN_BLKS+1]; //Samples with each occupancy (0 is empty, FIFO_LEN_BLKS is full)
+    int64_t numSamples;
+
+    fifo_occupancy_point_t points[FIFO_OCCUPANCY_MAX_POINTS]; //Ring of decimated points
+    int64_t numPoints; //Total number of points recorded (may be > FIFO_OCCUPANCY_MAX_POINTS if the ring wrapped)
+    fifo_occupancy_point_t current; //The point being accumulated
+} fifo_occupancy_t;
+
+/**
+ * Allocates the histogram and ring on the given core.  Free with bufferArenaFree()
+ */
+fifo_occupancy_t* initFifoOccupancy(int core);
+
+/**
+ * The number of blocks in the FIFO given a write and read offset (see laminarFifoCommon.h for the offset convention)
+ */
+static inline int fifoOccupancyBlks(int8_t writeOffset, int8_t readOffset){
+    int occupancy = writeOffset - readOffset - 1;
+    return occupancy < 0 ? occupancy + FIFO_LEN_BLKS + 1 : occupancy;
+}
+
+/**
+ * Call once for each block itteration (after the start trigger) with the thread's offsets: after the first reload of the other side's
+ * offset in the wait loop, or after the wait loop if no reload was needed
+ */
+static inline void fifoOccupancyRecord(fifo_occupancy_t *occupancy, int64_t blksTransfered, int8_t writeOffsetCached, int8_t readOffsetCached){
+    if((blksTransfered & (FIFO_OCCUPANCY_SAMPLE_BLKS-1)) == 0){
+        int blks = fifoOccupancyBlks(writeOffsetCached, readOffsetCached);
+        occupancy->hist[blks]++;
+        occupancy->numSamples++;
+
+        fifo_occupancy_point_t *current = &(occupancy->current);
+        current->minOccupancy = current->numSamples == 0 || blks < current->minOccupancy ? blks : current->minOccupancy;
+        current->maxOccupancy = current->numSamples == 0 || blks > current->maxOccupancy ? blks : current->maxOccupancy;
+        current->occupancySum += blks;
+        current->numSamples++;
+
+        if(current->numSamples == FIFO_OCCUPANCY_DECIMATION){
+            current->tsc = readTSC();
+            current->endBlk = blksTransfered;
+            occupancy->points[occupancy->numPoints & (FIFO_OCCUPANCY_MAX_POINTS-1)] = *current;
+            occupancy->numPoints++;
+            current->occupancySum = 0;
+            current->numSamples = 0;
+        }
+    }
+}
+
+/**
+ * Call after the last block was transfered.  Records the partial point (if any)
+ */
+static inline void fifoOccupancyRecordFinal(fifo_occupancy_t *occupancy, int64_t blksTransfered){
+    fifo_occupancy_point_t *current = &(occupancy->current);
+    if(current->numSamples > 0){
+        current->tsc = readTSC();
+        current->endBlk = blksTransfered;
+        occupancy->points[occupancy->numPoints & (FIFO_OCCUPANCY_MAX_POINTS-1)] = *current;
+        occupancy->numPoints++;
+        current->occupancySum = 0;
+        current->numSamples = 0;
+    }
+}
+
+void writeFifoOccupancyHeader(FILE* summaryFile, FILE* histFile, FILE* seriesFile);
+
+/**
+ * Writes the occupancy of a single thread.  The summary includes the smallest depth which would have held every occupancy the server
+ * sampled (only reported if no sample found the FIFO full).  Since only 1 in FIFO_OCCUPANCY_SAMPLE_BLKS blocks is sampled, this is a
+ * lower bound on the depth which avoids stalls (see the stall counters, FIFO_STALL_STATS_EN, for whether the server stalled)
+ * @param role a label for the thread (ex. Server, Client)
+ */
+void writeFifoOccupancy(FILE* summaryFile, FILE* histFile, FILE* seriesFile, const char* role, int serverCPU, int clientCPU, fifo_occupancy_t *occupancy);
+
+#endif
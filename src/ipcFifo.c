@@ -0,0 +1,342 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include "ipcFifo.h"
+#include "bufferArena.h"
+#include "laminarFifoServer.h"
+#include "laminarFifoClient.h"
+#include "laminarFifoRunner.h"
+#include "workerPool.h"
+#include "reportHelpers.h"
+#include "topologyHelpers.h"
+#include "cacheState.h"
+
+#define IPC_FIFO_POLL_US (1000)
+
+typedef struct {
+    void* ptr;
+    size_t size;
+} ipc_fifo_init_job_t;
+
+/**
+ * Lists the FIFO buffers in the mapping so the cache state can be set (see cacheState.h)
+ */
+static int ipcFifoBuffers(ipc_fifo_shared_t* shared, void** buffers, size_t* sizes){
+    buffers[0] = shared->array;
+    sizes[0] = sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1);
+    buffers[1] = &(shared->readOffset);
+    sizes[1] = sizeof(_Atomic int8_t);
+    buffers[2] = &(shared->writeOffset);
+    sizes[2] = sizeof(_Atomic int8_t);
+    return 3;
+}
+
+static size_t ipcFifoPageSize(){
+    #if IPC_FIFO_HUGE_PAGES
+        return IPC_FIFO_HUGE_PAGE_BYTES;
+    #else
+        return sysconf(_SC_PAGESIZE);
+    #endif
+}
+
+static size_t ipcFifoMappingSize(){
+    size_t pageSize = ipcFifoPageSize();
+    return ((sizeof(ipc_fifo_shared_t)+pageSize-1)/pageSize)*pageSize;
+}
+
+static void ipcFifoPath(const char* shmName, char* path, int pathLen){
+    #if IPC_FIFO_HUGE_PAGES
+        snprintf(path, pathLen, "%s/%s", IPC_FIFO_HUGETLBFS_DIR, shmName);
+    #else
+        snprintf(path, pathLen, "/%s", shmName);
+    #endif
+}
+
+static int ipcFifoOpen(const char* path, bool create){
+    #if IPC_FIFO_HUGE_PAGES
+        return create ? open(path, O_RDWR | O_CREAT | O_EXCL, 0600) : open(path, O_RDWR);
+    #else
+        return create ? shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0600) : shm_open(path, O_RDWR, 0);
+    #endif
+}
+
+static void ipcFifoUnlink(const char* path){
+    #if IPC_FIFO_HUGE_PAGES
+        unlink(path);
+    #else
+        shm_unlink(path);
+    #endif
+}
+
+static ipc_fifo_shared_t* ipcFifoMap(int fd, size_t mappingSize, bool populate){
+    int flags = MAP_SHARED;
+    if(populate){
+        flags |= MAP_POPULATE;
+    }
+    void* ptr = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if(ptr == MAP_FAILED){
+        printf("Unable to map IPC FIFO shared memory: %s\n", strerror(errno));
+        perror(NULL);
+        exit(1);
+    }
+    return (ipc_fifo_shared_t*) ptr;
+}
+
+static void getPageFaults(long *minorFaults, long *majorFaults){
+    //Includes the worker threads
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    *minorFaults = usage.ru_minflt;
+    *majorFaults = usage.ru_majflt;
+}
+
+static void* ipc_fifo_init_thread(void* args){
+    //Touch every page of the mapping on the server core
+    ipc_fifo_init_job_t *job = (ipc_fifo_init_job_t*) args;
+    memset(job->ptr, 0, job->size);
+    return NULL;
+}
+
+void runIpcFifoServer(const char* shmName, int serverCPU, char* reportFilename){
+    char path[256];
+    ipcFifoPath(shmName, path, 256);
+    size_t mappingSize = ipcFifoMappingSize();
+
+    //Remove any mapping left behind by a previous run
+    ipcFifoUnlink(path);
+    int fd = ipcFifoOpen(path, true);
+    if(fd < 0){
+        printf("Unable to create IPC FIFO shared memory %s: %s\n", path, strerror(errno));
+        perror(NULL);
+        exit(1);
+    }
+    if(ftruncate(fd, mappingSize) != 0){
+        printf("Unable to size IPC FIFO shared memory %s: %s\n", path, strerror(errno));
+        perror(NULL);
+        exit(1);
+    }
+    ipc_fifo_shared_t* shared = ipcFifoMap(fd, mappingSize, false);
+    close(fd);
+
+    //Zero the mapping on the server core so that its pages are first touched there and the server does not fault durring the timed region
+    ipc_fifo_init_job_t initJob = {shared, mappingSize};
+    workerPoolRun(serverCPU, ipc_fifo_init_thread, &initJob);
+
+    //Init Flags
+    atomic_signal_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(&(shared->serverReady), memory_order_release);
+    atomic_flag_clear_explicit(&(shared->clientReady), memory_order_release);
+    atomic_flag_test_and_set_explicit(&(shared->serverReady), memory_order_acq_rel);
+    atomic_flag_test_and_set_explicit(&(shared->clientReady), memory_order_acq_rel);
+    atomic_store_explicit(&(shared->startTrigger), false, memory_order_release);
+    atomic_store_explicit(&(shared->clientDone), false, memory_order_release);
+    atomic_store_explicit(&(shared->clientCPU), -1, memory_order_release);
+
+    //Init Ptrs (will not have any initial state in the FIFO)
+    atomic_init(&(shared->readOffset), 0);
+    atomic_init(&(shared->writeOffset), 1);
+    if(!atomic_is_lock_free(&(shared->readOffset))){
+        printf("Warning: An atomic FIFO offset (readOffset) was expected to be lock free but is not.  It may not work between processes\n");
+    }
+
+    //The client will not use the mapping until the magic number is set
+    atomic_store_explicit(&(shared->magic), IPC_FIFO_MAGIC, memory_order_release);
+    printf("=== IpcFifo: Waiting for client on %s ===\n", path);
+
+    //Set the cache state of the FIFO.  Each process prepares its own core since the client core is in the other process.  The buffers are flushed by the server once both threads are ready
+    void* fifoBuffers[3];
+    size_t fifoBufferSizes[3];
+    int numFifoBuffers = ipcFifoBuffers(shared, fifoBuffers, fifoBufferSizes);
+    #if CACHE_STATE != CACHE_STATE_WARM_CONSUMER
+        cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, numFifoBuffers, serverCPU, serverCPU);
+    #endif
+
+    laminar_fifo_threadArgs_t args;
+    args.PartitionCrossingFIFO_readOffsetPtr_re = &(shared->readOffset);
+    args.PartitionCrossingFIFO_writeOffsetPtr_re = &(shared->writeOffset);
+    args.PartitionCrossingFIFO_arrayPtr_re = shared->array;
+    args.startTrigger = &(shared->startTrigger);
+    args.readyFlag = &(shared->serverReady);
+    args.timeSeries = &(shared->serverTimeSeries);
+    args.cpuFreq = NULL; //Not sampled for the inter-process FIFO
+    //The noise log, stall counters, and occupancy are only allocated so that the FIFO threads can be built with them enabled.  They are not reported
+    fifo_stall_stats_t stallStats;
+    args.stallStats = &stallStats;
+    #if OS_NOISE_EN
+        args.osNoise = initOsNoise(serverCPU);
+    #else
+        args.osNoise = NULL;
+    #endif
+    #if FIFO_OCCUPANCY_EN
+        args.occupancy = initFifoOccupancy(serverCPU);
+    #else
+        args.occupancy = NULL;
+    #endif
+    workerPoolSubmit(serverCPU, fifo_server_thread, &args);
+
+    //Wait for both threads ready
+    bool wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(&(shared->serverReady), memory_order_acq_rel);
+    }
+    wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(&(shared->clientReady), memory_order_acq_rel);
+    }
+
+    cacheStateBeforeTrigger(fifoBuffers, fifoBufferSizes, numFifoBuffers);
+
+    long serverMinorFaultsStart, serverMajorFaultsStart;
+    getPageFaults(&serverMinorFaultsStart, &serverMajorFaultsStart);
+
+    //Start FIFO transfers
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(&(shared->startTrigger), true, memory_order_release);
+
+    void *serverResult = workerPoolJoin(serverCPU);
+    bufferArenaFree(args.osNoise);
+    bufferArenaFree(args.occupancy);
+    double serverTime = *((double*) serverResult);
+    free(serverResult);
+
+    long serverMinorFaultsStop, serverMajorFaultsStop;
+    getPageFaults(&serverMinorFaultsStop, &serverMajorFaultsStop);
+
+    //Wait for the client to report its results
+    bool clientDone = false;
+    while(!clientDone){
+        clientDone = atomic_load_explicit(&(shared->clientDone), memory_order_acquire);
+    }
+    int clientCPU = atomic_load_explicit(&(shared->clientCPU), memory_order_acquire);
+
+    //Write results
+    FILE *resultsFile = fopen(reportFilename, "w");
+    fprintf(resultsFile, "ServerCPU,ClientCPU,ServerTime,ClientTime,BytesTx,BytesRx,HugePages,PageSizeBytes,MappingBytes,ServerMinorFaults,ServerMajorFaults,ClientMinorFaults,ClientMajorFaults,Level,CacheState\n");
+    long long int bytesSent = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    fprintf(resultsFile, "%d,%d,%e,%e,%lld,%lld,%d,%lu,%lu,%ld,%ld,%ld,%ld,%s,%s\n", serverCPU, clientCPU, serverTime, shared->clientTime, bytesSent, bytesSent,
+            IPC_FIFO_HUGE_PAGES, ipcFifoPageSize(), mappingSize,
+            serverMinorFaultsStop-serverMinorFaultsStart, serverMajorFaultsStop-serverMajorFaultsStart, shared->clientMinorFaults, shared->clientMajorFaults,
+            getTopologyLevelName(getTopologyLevel(serverCPU, clientCPU)), getCacheStateName(CACHE_STATE));
+    fclose(resultsFile);
+
+    int serverCPUs[1] = {serverCPU};
+    int clientCPUs[1] = {clientCPU};
+    #if TIME_SERIES_EN
+        time_series_t *serverTimeSeries[1] = {&(shared->serverTimeSeries)};
+        time_series_t *clientTimeSeries[1] = {&(shared->clientTimeSeries)};
+        writeTimeSeriesResults(serverTimeSeries, clientTimeSeries, serverCPUs, clientCPUs, 1, reportFilename);
+    #endif
+
+    munmap(shared, mappingSize);
+    ipcFifoUnlink(path);
+
+    //Run the same cores in-process for comparison
+    printf("=== IpcFifo: In-Process Comparison ===\n");
+    char* inProcessFilename = genDerivedReportName(reportFilename, "_inProcess");
+    runLaminarFifoBench(serverCPUs, clientCPUs, 1, inProcessFilename);
+    free(inProcessFilename);
+}
+
+void runIpcFifoClient(const char* shmName, int clientCPU){
+    char path[256];
+    ipcFifoPath(shmName, path, 256);
+    size_t mappingSize = ipcFifoMappingSize();
+
+    //Wait for the server to create and size the mapping
+    printf("=== IpcFifo: Waiting for server on %s ===\n", path);
+    int fd;
+    while((fd = ipcFifoOpen(path, false)) < 0){
+        if(errno != ENOENT){
+            printf("Unable to open IPC FIFO shared memory %s: %s\n", path, strerror(errno));
+            perror(NULL);
+            exit(1);
+        }
+        usleep(IPC_FIFO_POLL_US);
+    }
+    struct stat fdStat;
+    do{
+        if(fstat(fd, &fdStat) != 0){
+            printf("Unable to stat IPC FIFO shared memory %s: %s\n", path, strerror(errno));
+            perror(NULL);
+            exit(1);
+        }
+        if(fdStat.st_size < (off_t) mappingSize){
+            usleep(IPC_FIFO_POLL_US);
+        }
+    }while(fdStat.st_size < (off_t) mappingSize);
+    ipc_fifo_shared_t* shared = ipcFifoMap(fd, mappingSize, IPC_FIFO_POPULATE);
+    close(fd);
+
+    //Wait for the server to initialize the mapping
+    while(atomic_load_explicit(&(shared->magic), memory_order_acquire) != IPC_FIFO_MAGIC){
+        usleep(IPC_FIFO_POLL_US);
+    }
+    atomic_store_explicit(&(shared->clientCPU), clientCPU, memory_order_release);
+
+    //Set the cache state of the FIFO on the client core (see runIpcFifoServer)
+    #if CACHE_STATE != CACHE_STATE_WARM_PRODUCER
+        void* fifoBuffers[3];
+        size_t fifoBufferSizes[3];
+        int numFifoBuffers = ipcFifoBuffers(shared, fifoBuffers, fifoBufferSizes);
+        cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, numFifoBuffers, clientCPU, clientCPU);
+    #endif
+
+    laminar_fifo_threadArgs_t args;
+    args.PartitionCrossingFIFO_readOffsetPtr_re = &(shared->readOffset);
+    args.PartitionCrossingFIFO_writeOffsetPtr_re = &(shared->writeOffset);
+    args.PartitionCrossingFIFO_arrayPtr_re = shared->array;
+    args.startTrigger = &(shared->startTrigger);
+    args.readyFlag = &(shared->clientReady);
+    args.timeSeries = &(shared->clientTimeSeries);
+    args.cpuFreq = NULL; //Not sampled for the inter-process FIFO
+    //The noise log, stall counters, and occupancy are only allocated so that the FIFO threads can be built with them enabled.  They are not reported
+    fifo_stall_stats_t stallStats;
+    args.stallStats = &stallStats;
+    #if OS_NOISE_EN
+        args.osNoise = initOsNoise(clientCPU);
+    #else
+        args.osNoise = NULL;
+    #endif
+    #if FIFO_OCCUPANCY_EN
+        args.occupancy = initFifoOccupancy(clientCPU);
+    #else
+        args.occupancy = NULL;
+    #endif
+    workerPoolSubmit(clientCPU, fifo_client_thread, &args);
+
+    //Only count faults from the timed region
+    bool go = false;
+    while(!go){
+        go = atomic_load_explicit(&(shared->startTrigger), memory_order_acquire);
+    }
+    long clientMinorFaultsStart, clientMajorFaultsStart;
+    getPageFaults(&clientMinorFaultsStart, &clientMajorFaultsStart);
+
+    void *clientResult = workerPoolJoin(clientCPU);
+    bufferArenaFree(args.osNoise);
+    bufferArenaFree(args.occupancy);
+    double clientTime = *((double*) clientResult);
+    free(clientResult);
+
+    long clientMinorFaultsStop, clientMajorFaultsStop;
+    getPageFaults(&clientMinorFaultsStop, &clientMajorFaultsStop);
+
+    //Report results to the server
+    shared->clientTime = clientTime;
+    shared->clientMinorFaults = clientMinorFaultsStop-clientMinorFaultsStart;
+    shared->clientMajorFaults = clientMajorFaultsStop-clientMajorFaultsStart;
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(&(shared->clientDone), true, memory_order_release);
+
+    munmap(shared, mappingSize);
+}
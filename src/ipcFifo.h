@@ -0,0 +1,77 @@
+#ifndef _IPC_FIFO_H
+#define _IPC_FIFO_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+#include "laminarFifoParams.h"
+#include "testParams.h"
+#include "timeSeries.h"
+
+/*
+ * A Laminar FIFO shared between 2 separately launched commCharaterize processes (see runIpcFifo.sh).
+ *
+ * The server process creates a named shared memory mapping containing the FIFO control block (offsets, ready flags, start trigger)
+ * and the FIFO array.  The client process maps it by name.  The same server and client kernels as the in-process benchmark are run
+ * on pinned workers in each process and are started through the start trigger in the shared mapping.
+ *
+ * The server process writes the report and then re-runs the same cores with the in-process FIFO for comparison.
+ */
+
+//Back the shared mapping with a file on hugetlbfs rather than a POSIX shared memory object
+#ifndef IPC_FIFO_HUGE_PAGES
+    #define IPC_FIFO_HUGE_PAGES (0)
+#endif
+
+#ifndef IPC_FIFO_HUGETLBFS_DIR
+    #define IPC_FIFO_HUGETLBFS_DIR "/dev/hugepages"
+#endif
+
+#ifndef IPC_FIFO_HUGE_PAGE_BYTES
+    #define IPC_FIFO_HUGE_PAGE_BYTES (2*1024*1024)
+#endif
+
+//Pre-fault the mapping in the client process (MAP_POPULATE).  When 0, the client's page faults for the FIFO array occur durring the timed region
+#ifndef IPC_FIFO_POPULATE
+    #define IPC_FIFO_POPULATE (0)
+#endif
+
+#define IPC_FIFO_MAGIC (0x4C4D4E52)
+
+typedef struct {
+    _Atomic uint32_t magic; //Set to IPC_FIFO_MAGIC by the server once the rest of the mapping is initialized
+
+    //Each shared variable is on its own cache line (as it would be if allocated seperately in the in-process benchmark)
+    _Alignas(VITIS_MEM_ALIGNMENT) _Atomic int8_t readOffset;
+    _Alignas(VITIS_MEM_ALIGNMENT) _Atomic int8_t writeOffset;
+    _Alignas(VITIS_MEM_ALIGNMENT) atomic_flag serverReady;
+    _Alignas(VITIS_MEM_ALIGNMENT) atomic_flag clientReady;
+    _Alignas(VITIS_MEM_ALIGNMENT) _Atomic bool startTrigger;
+
+    //Client results (valid once clientDone is set)
+    _Alignas(VITIS_MEM_ALIGNMENT) _Atomic bool clientDone;
+    _Atomic int clientCPU; //Set by the client before it signals ready
+    double clientTime;
+    long clientMinorFaults;
+    long clientMajorFaults;
+
+    _Alignas(VITIS_MEM_ALIGNMENT) time_series_t serverTimeSeries; //Only used if TIME_SERIES_EN
+    _Alignas(VITIS_MEM_ALIGNMENT) time_series_t clientTimeSeries; //Only used if TIME_SERIES_EN
+
+    _Alignas(VITIS_MEM_ALIGNMENT) PartitionCrossingFIFO_t array[FIFO_LEN_BLKS+1]; //An additional block (for empty/full ambiguity resolution)
+} ipc_fifo_shared_t;
+
+/**
+ * Creates the shared mapping, runs the server side of the FIFO on serverCPU, and writes the report once the client finishes.
+ * Also writes <report>_inProcess.csv with the in-process FIFO run on the same cores.
+ * @param shmName the name of the shared mapping (without a leading '/').  Must match the name given to the client.
+ */
+void runIpcFifoServer(const char* shmName, int serverCPU, char* reportFilename);
+
+/**
+ * Maps the shared mapping created by the server (waiting for it to be created if needed) and runs the client side of the FIFO on clientCPU
+ */
+void runIpcFifoClient(const char* shmName, int clientCPU);
+
+#endif
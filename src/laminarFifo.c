@@ -0,0 +1,183 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "laminarFifo.h"
+#include "laminarFifoInternal.h"
+#include "testParams.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "vitisNumaAllocHelpers.h"
+
+/**
+ * Allocates and initializes the offsets and array of an empty FIFO
+ */
+static void allocFifo(_Atomic int8_t** readOffsetPtr, _Atomic int8_t** writeOffsetPtr, PartitionCrossingFIFO_t** arrayPtr,
+                      int serverCore, int clientCore){
+    //Buffers come from the arena and are reused between tests.  The array is zeroed when first allocated (and re-zeroed if ARENA_COLD_CACHE)
+    *readOffsetPtr = (_Atomic int8_t*) bufferArenaAlloc(sizeof(_Atomic int8_t), clientCore);
+    *writeOffsetPtr = (_Atomic int8_t*) bufferArenaAlloc(sizeof(_Atomic int8_t), serverCore);
+    *arrayPtr = (PartitionCrossingFIFO_t*) bufferArenaAlloc(sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1), serverCore); //Alloc an additional block (for empty/full ambiguity resolution)
+
+    //Init Ptrs (will not have any initial state in the FIFO)
+    atomic_init(*readOffsetPtr, 0);
+    if(!atomic_is_lock_free(*readOffsetPtr)){
+        printf("Warning: An atomic FIFO offset (PartitionCrossingFIFO_readOffsetPtr_re) was expected to be lock free but is not\n");
+    }
+    atomic_init(*writeOffsetPtr, 1);
+    if(!atomic_is_lock_free(*writeOffsetPtr)){
+        printf("Warning: An atomic FIFO offset (PartitionCrossingFIFO_writeOffsetPtr_re) was expected to be lock free but is not\n");
+    }
+}
+
+/**
+ * Allocates a ready flag on the given core.  The flag starts set (not ready)
+ */
+static atomic_flag* allocReadyFlag(int core){
+    atomic_flag *flag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), core);
+    atomic_signal_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(flag, memory_order_release); //Init since this was malloc-ed
+    atomic_flag_test_and_set_explicit(flag, memory_order_acq_rel);
+    return flag;
+}
+
+void initFIFO(_Atomic int8_t** PartitionCrossingFIFO_readOffsetPtr_re,
+              _Atomic int8_t** PartitionCrossingFIFO_writeOffsetPtr_re,
+              PartitionCrossingFIFO_t** PartitionCrossingFIFO_arrayPtr_re,
+              atomic_flag **serverFlag, atomic_flag **clientFlag,
+              int serverCore, int clientCore){
+    allocFifo(PartitionCrossingFIFO_readOffsetPtr_re, PartitionCrossingFIFO_writeOffsetPtr_re, PartitionCrossingFIFO_arrayPtr_re, serverCore, clientCore);
+    *serverFlag = allocReadyFlag(serverCore);
+    *clientFlag = allocReadyFlag(clientCore);
+}
+
+void cleanupFIFO(_Atomic int8_t* PartitionCrossingFIFO_readOffsetPtr_re,
+                 _Atomic int8_t* PartitionCrossingFIFO_writeOffsetPtr_re,
+                 PartitionCrossingFIFO_t* PartitionCrossingFIFO_arrayPtr_re,
+                 atomic_flag *serverFlag, atomic_flag *clientFlag){
+    bufferArenaFree(PartitionCrossingFIFO_readOffsetPtr_re);
+    bufferArenaFree(PartitionCrossingFIFO_writeOffsetPtr_re);
+    bufferArenaFree(PartitionCrossingFIFO_arrayPtr_re);
+    bufferArenaFree(serverFlag);
+    bufferArenaFree(clientFlag);
+}
+
+laminar_fifo_t* laminarFifoCreate(int serverCore, int clientCore){
+    //Only used by the controller thread
+    laminar_fifo_t* fifo = (laminar_fifo_t*) malloc(sizeof(laminar_fifo_t));
+    allocFifo(&(fifo->readOffsetPtr), &(fifo->writeOffsetPtr), &(fifo->arrayPtr), serverCore, clientCore);
+    fifo->serverCore = serverCore;
+    fifo->clientCore = clientCore;
+    return fifo;
+}
+
+void laminarFifoDestroy(laminar_fifo_t* fifo){
+    if(fifo == NULL){
+        return;
+    }
+    bufferArenaFree(fifo->readOffsetPtr);
+    bufferArenaFree(fifo->writeOffsetPtr);
+    bufferArenaFree(fifo->arrayPtr);
+    free(fifo);
+}
+
+void laminarFifoPreload(laminar_fifo_t* fifo, int numBlks){
+    if(numBlks < 0 || numBlks >= FIFO_LEN_BLKS){
+        printf("Cannot preload %d blocks into a FIFO of length %d (at most %d) ... exiting\n", numBlks, FIFO_LEN_BLKS, FIFO_LEN_BLKS-1);
+        exit(1);
+    }
+    //The write offset is the next slot to write.  An empty FIFO has it 1 ahead of the read offset
+    int8_t readOffset = atomic_load_explicit(fifo->readOffsetPtr, memory_order_acquire);
+    atomic_store_explicit(fifo->writeOffsetPtr, (readOffset+1+numBlks)%(FIFO_LEN_BLKS+1), memory_order_release);
+}
+
+size_t laminarFifoBlkSizeBytes(){
+    return BLK_SIZE_BYTES;
+}
+
+int laminarFifoLenBlks(){
+    return FIFO_LEN_BLKS;
+}
+
+laminar_start_barrier_t* laminarBarrierCreate(int* cores, int numThreads){
+    if(numThreads < 1 || numThreads > LAMINAR_BARRIER_MAX_THREADS){
+        printf("A start barrier must have between 1 and %d threads (LAMINAR_BARRIER_MAX_THREADS) ... exiting\n", LAMINAR_BARRIER_MAX_THREADS);
+        exit(1);
+    }
+
+    //Only used by the controller thread
+    laminar_start_barrier_t* barrier = (laminar_start_barrier_t*) malloc(sizeof(laminar_start_barrier_t));
+    barrier->numThreads = numThreads;
+    for(int i = 0; i<numThreads; i++){
+        barrier->cores[i] = cores[i];
+        barrier->readyFlags[i] = allocReadyFlag(cores[i]);
+    }
+
+    barrier->startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(barrier->startTrigger, false, memory_order_release);
+
+    return barrier;
+}
+
+void laminarBarrierDestroy(laminar_start_barrier_t* barrier){
+    if(barrier == NULL){
+        return;
+    }
+    for(int i = 0; i<barrier->numThreads; i++){
+        bufferArenaFree(barrier->readyFlags[i]);
+    }
+    free(barrier->startTrigger);
+    free(barrier);
+}
+
+void laminarBarrierWaitAllReady(laminar_start_barrier_t* barrier){
+    for(int i = 0; i<barrier->numThreads; i++){
+        bool wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(barrier->readyFlags[i], memory_order_acq_rel);
+        }
+    }
+}
+
+bool laminarBarrierWaitAllReadyUntil(laminar_start_barrier_t* barrier, uint64_t deadlineTSC){
+    for(int i = 0; i<barrier->numThreads; i++){
+        bool wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(barrier->readyFlags[i], memory_order_acq_rel);
+            if(wait && readTSC() > deadlineTSC){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void laminarBarrierRelease(laminar_start_barrier_t* barrier){
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(barrier->startTrigger, true, memory_order_release);
+}
+
+void laminarThreadStart(int core, void* (*fun)(void*), void* args){
+    workerPoolSubmit(core, fun, args);
+}
+
+void* laminarThreadJoin(int core){
+    return workerPoolJoin(core);
+}
+
+void* laminarAlloc(size_t size, int core){
+    return bufferArenaAlloc(size, core);
+}
+
+void laminarFree(void* ptr){
+    bufferArenaFree(ptr);
+}
+
+void laminarShutdown(){
+    bufferArenaShutdown();
+    workerPoolShutdown();
+}
@@ -0,0 +1,158 @@
+#ifndef _LAMINAR_FIFO_H
+#define _LAMINAR_FIFO_H
+
+/*
+ * liblaminarfifo: the FIFO and placement primitives used by the benchmarks, packaged so that a runtime can use the exact code which was
+ * benchmarked.  commCharaterize is built against this library.
+ *
+ * The block type (PartitionCrossingFIFO_t) and the FIFO length are fixed at compile time (see laminarFifoParams.h and
+ * laminarFifoCommon.h).  A client must be compiled with the same parameters as the library it links against.  Use
+ * laminarFifoBlkSizeBytes() and laminarFifoLenBlks() to check at startup.
+ *
+ * Typical use (controller thread):
+ *   laminar_fifo_t *fifo = laminarFifoCreate(serverCore, clientCore);
+ *   int cores[2] = {serverCore, clientCore};
+ *   laminar_start_barrier_t *barrier = laminarBarrierCreate(cores, 2);
+ *   //Fill in the thread arguments with the FIFO offsets/array, barrier->startTrigger, and barrier->readyFlags[i]
+ *   laminarThreadStart(serverCore, fifo_server_thread, serverArgs);
+ *   laminarThreadStart(clientCore, fifo_client_thread, clientArgs);
+ *   laminarBarrierWaitAllReady(barrier);
+ *   laminarBarrierRelease(barrier);
+ *   laminarThreadJoin(serverCore); laminarThreadJoin(clientCore);
+ *   laminarBarrierDestroy(barrier);
+ *   laminarFifoDestroy(fifo);
+ *   laminarShutdown();
+ *
+ * Inside each thread: laminarBarrierSignalReady(readyFlag) once set up, then laminarBarrierWaitForTrigger(startTrigger)
+ *
+ * Timing: readTSC(), getTSCFreqHz(), and difftimespec() from timeHelpers.h
+ */
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+#include "laminarFifoServer.h"
+#include "laminarFifoClient.h"
+#include "timeHelpers.h"
+
+//Incremented when the API changes
+#define LAMINAR_FIFO_API_VERSION (3)
+
+#ifndef LAMINAR_BARRIER_MAX_THREADS
+    #define LAMINAR_BARRIER_MAX_THREADS (256)
+#endif
+
+//==== FIFOs ====
+
+typedef struct {
+    _Atomic int8_t *readOffsetPtr; //On the client core
+    _Atomic int8_t *writeOffsetPtr; //On the server core
+    PartitionCrossingFIFO_t *arrayPtr; //FIFO_LEN_BLKS+1 blocks on the server core
+    int serverCore;
+    int clientCore;
+} laminar_fifo_t;
+
+/**
+ * Creates an empty FIFO from serverCore (the producer) to clientCore (the consumer).  The write offset and array are placed on the
+ * NUMA node of serverCore and the read offset on the node of clientCore (each is first touched by the worker pinned to that core).
+ * Must not be called from a thread started with laminarThreadStart
+ */
+laminar_fifo_t* laminarFifoCreate(int serverCore, int clientCore);
+
+/**
+ * Releases a FIFO.  The FIFO must not be in use
+ */
+void laminarFifoDestroy(laminar_fifo_t* fifo);
+
+/**
+ * Marks numBlks blocks (0 to FIFO_LEN_BLKS-1) as already written.  Used for the initial conditions of feedback loops.  A free slot is
+ * always left so that the producer of a loop is not blocked on a full FIFO before it starts.  Call before the threads using the FIFO
+ * are started
+ */
+void laminarFifoPreload(laminar_fifo_t* fifo, int numBlks);
+
+size_t laminarFifoBlkSizeBytes();
+
+int laminarFifoLenBlks();
+
+//==== Start Barrier ====
+//Each thread signals when it is set up (ready) then spins until the controller releases all threads at once (trigger)
+
+typedef struct {
+    _Atomic bool *startTrigger; //Shared by all threads
+    int numThreads;
+    int cores[LAMINAR_BARRIER_MAX_THREADS];
+    atomic_flag *readyFlags[LAMINAR_BARRIER_MAX_THREADS]; //Unique to each thread, placed on its core.  Set until the thread is ready
+} laminar_start_barrier_t;
+
+/**
+ * Creates a barrier for numThreads threads (at most LAMINAR_BARRIER_MAX_THREADS), thread i runs on cores[i]
+ */
+laminar_start_barrier_t* laminarBarrierCreate(int* cores, int numThreads);
+
+void laminarBarrierDestroy(laminar_start_barrier_t* barrier);
+
+/**
+ * Called by the controller.  Waits for every thread to call laminarBarrierSignalReady
+ */
+void laminarBarrierWaitAllReady(laminar_start_barrier_t* barrier);
+
+/**
+ * Like laminarBarrierWaitAllReady but gives up once the TSC passes deadlineTSC
+ * @returns false if a thread was not ready by deadlineTSC
+ */
+bool laminarBarrierWaitAllReadyUntil(laminar_start_barrier_t* barrier, uint64_t deadlineTSC);
+
+/**
+ * Called by the controller.  Releases all threads waiting in laminarBarrierWaitForTrigger
+ */
+void laminarBarrierRelease(laminar_start_barrier_t* barrier);
+
+/**
+ * Called by a thread once it is set up
+ */
+static inline void laminarBarrierSignalReady(atomic_flag *readyFlag){
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+}
+
+/**
+ * Called by a thread after laminarBarrierSignalReady.  Spins until the controller calls laminarBarrierRelease
+ */
+static inline void laminarBarrierWaitForTrigger(_Atomic bool *startTrigger){
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+}
+
+//==== Pinned Threads (see workerPool.h) ====
+
+/**
+ * Starts fun(args) on the persistent SCHED_FIFO worker pinned to core.  Only 1 thread may be outstanding on a core
+ */
+void laminarThreadStart(int core, void* (*fun)(void*), void* args);
+
+/**
+ * Waits for the thread on core to finish and returns the value it returned
+ */
+void* laminarThreadJoin(int core);
+
+//==== Placement (see bufferArena.h) ====
+
+/**
+ * Allocates a zeroed buffer, aligned to VITIS_MEM_ALIGNMENT, on the NUMA node of core (first touched by the worker pinned to core)
+ */
+void* laminarAlloc(size_t size, int core);
+
+void laminarFree(void* ptr);
+
+/**
+ * Releases the buffers and stops the pinned workers.  Call once when done
+ */
+void laminarShutdown();
+
+#endif
@@ -1,4 +1,6 @@
 #include "laminarFifoCommon.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
 #include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -17,6 +19,11 @@ void *fifo_client_thread(void* args){
     PartitionCrossingFIFO_t *PartitionCrossingFIFO_arrayPtr_re = args_cast->PartitionCrossingFIFO_arrayPtr_re;
     _Atomic bool *startTrigger = args_cast->startTrigger;
     atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+    cpu_freq_sample_t *cpuFreq = args_cast->cpuFreq;
+    os_noise_t *osNoise = args_cast->osNoise;
+    fifo_stall_stats_t *stallStats = args_cast->stallStats;
+    fifo_occupancy_t *occupancy = args_cast->occupancy;
 
     //==== Setup Input FIFOs ====
     int8_t PartitionCrossingFIFO_writeOffsetCached_re;
@@ -24,6 +31,13 @@ void *fifo_client_thread(void* args){
     PartitionCrossingFIFO_writeOffsetCached_re = atomic_load_explicit(PartitionCrossingFIFO_writeOffsetPtr_re, memory_order_acquire);
     PartitionCrossingFIFO_readOffsetCached_re = atomic_load_explicit(PartitionCrossingFIFO_readOffsetPtr_re, memory_order_acquire);
     PartitionCrossingFIFO_t PartitionCrossingFIFO_N2_TO_1_0_readTmp;
+    #if FIFO_BLK_CONSUME
+        fifo_sample_acc_t consumeAcc = 0;
+    #endif
+
+    #if CPU_FREQ_EN
+        cpuFreqOpen(cpuFreq);
+    #endif
 
     //==== Signal Ready ====
     atomic_thread_fence(memory_order_acquire);
@@ -37,31 +51,83 @@ void *fifo_client_thread(void* args){
     }
 
     //==== Start Test ====
+    #if CPU_FREQ_EN
+        cpuFreqStart(cpuFreq);
+    #endif
+
     //Start timer
     timespec_t startTime;
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
     clock_gettime(CLOCK_MONOTONIC, &startTime);
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
 
+    #if OS_NOISE_EN
+        osNoiseStart(osNoise);
+    #endif
+
+    #if FIFO_STALL_STATS_EN
+        fifo_stall_stats_t stalls = {0, 0, 0, 0, 0};
+        uint64_t stallLastTSC = readTSC();
+    #endif
+
     //Run for specified number of itterations
     for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        #if FIFO_OCCUPANCY_EN
+            bool occupancyRecorded = false;
+        #endif
+
+        #if OS_NOISE_EN
+            osNoiseCheck(osNoise);
+        #endif
+
         //Wait for input FIFO(s) to be ready
         //  --- Pulled from generated Laminar code (bool changed from vitisBool_t to bool)
         bool inputFIFOsReady = false;
         while (!inputFIFOsReady)
         {
+            #if OS_NOISE_EN
+                osNoiseCheck(osNoise);
+            #endif
             inputFIFOsReady = true;
             {
                 bool PartitionCrossingFIFO_notEmpty_re = (!((PartitionCrossingFIFO_writeOffsetCached_re - PartitionCrossingFIFO_readOffsetCached_re == 1) || (PartitionCrossingFIFO_writeOffsetCached_re - PartitionCrossingFIFO_readOffsetCached_re == -FIFO_LEN_BLKS)));
                 if (!(PartitionCrossingFIFO_notEmpty_re))
                 {
                     PartitionCrossingFIFO_writeOffsetCached_re = atomic_load_explicit(PartitionCrossingFIFO_writeOffsetPtr_re, memory_order_acquire);
+                    #if FIFO_STALL_STATS_EN
+                        stalls.offsetReloads++;
+                    #endif
+                    #if FIFO_OCCUPANCY_EN
+                        //Sample with the refreshed offset rather than the stale cached one
+                        if(!occupancyRecorded){
+                            fifoOccupancyRecord(occupancy, blksTransfered, PartitionCrossingFIFO_writeOffsetCached_re, PartitionCrossingFIFO_readOffsetCached_re);
+                            occupancyRecorded = true;
+                        }
+                    #endif
                     PartitionCrossingFIFO_notEmpty_re = (!((PartitionCrossingFIFO_writeOffsetCached_re - PartitionCrossingFIFO_readOffsetCached_re == 1) || (PartitionCrossingFIFO_writeOffsetCached_re - PartitionCrossingFIFO_readOffsetCached_re == -FIFO_LEN_BLKS)));
                 }
                 inputFIFOsReady &= PartitionCrossingFIFO_notEmpty_re;
             }
+            #if FIFO_STALL_STATS_EN
+                stalls.waitIters += !inputFIFOsReady;
+            #endif
         }
 
+        #if FIFO_OCCUPANCY_EN
+            //The cached offsets did not need to be refreshed
+            if(!occupancyRecorded){
+                fifoOccupancyRecord(occupancy, blksTransfered, PartitionCrossingFIFO_writeOffsetCached_re, PartitionCrossingFIFO_readOffsetCached_re);
+            }
+        #endif
+
+        #if FIFO_STALL_STATS_EN
+            fifoStallAccount(&stallLastTSC, &stalls.waitCycles);
+        #endif
+
         //Read input FIFO(s)
         //  --- Pulled from generated Laminar code (bool changed from vitisBool_t to bool)
         {  //Begin Scope for PartitionCrossingFIFO FIFO Read
@@ -76,12 +142,26 @@ void *fifo_client_thread(void* args){
             }
 
             //Read from array
-            __builtin_memcpy_inline(&PartitionCrossingFIFO_N2_TO_1_0_readTmp, PartitionCrossingFIFO_arrayPtr_re + PartitionCrossingFIFO_readOffsetPtr_re_local, sizeof(PartitionCrossingFIFO_t));
+            fifoConsumerPrefetch(PartitionCrossingFIFO_arrayPtr_re, PartitionCrossingFIFO_readOffsetPtr_re_local);
+            copyBlkFromFifo(&PartitionCrossingFIFO_N2_TO_1_0_readTmp, PartitionCrossingFIFO_arrayPtr_re + PartitionCrossingFIFO_readOffsetPtr_re_local);
+            #if FIFO_STALL_STATS_EN
+                fifoStallAccount(&stallLastTSC, &stalls.copyCycles);
+            #endif
             PartitionCrossingFIFO_readOffsetCached_re = PartitionCrossingFIFO_readOffsetPtr_re_local;
             //Update Read Ptr
             atomic_store_explicit(PartitionCrossingFIFO_readOffsetPtr_re, PartitionCrossingFIFO_readOffsetPtr_re_local, memory_order_release);
+            #if FIFO_STALL_STATS_EN
+                fifoStallAccount(&stallLastTSC, &stalls.publishCycles);
+            #endif
         } //End Scope for PartitionCrossingFIFO_N2_TO_1_0 FIFO Read
 
+        #if FIFO_BLK_CONSUME
+            consumeAcc += consumeFifoBlk(&PartitionCrossingFIFO_N2_TO_1_0_readTmp);
+            #if FIFO_STALL_STATS_EN
+                fifoStallAccount(&stallLastTSC, &stalls.copyCycles);
+            #endif
+        #endif
+
         //Need to make sure that the memory copy is not optimized out if the content is not checked
         asm volatile(""
         :
@@ -89,11 +169,39 @@ void *fifo_client_thread(void* args){
         :);
     }
 
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    #if FIFO_OCCUPANCY_EN
+        fifoOccupancyRecordFinal(occupancy, TRANSACTIONS_BLKS);
+    #endif
+
+    #if OS_NOISE_EN
+        osNoiseStop(osNoise);
+    #endif
+
+    #if FIFO_STALL_STATS_EN
+        *stallStats = stalls;
+    #endif
+
+    #if FIFO_BLK_CONSUME
+        //Need to make sure that the consumer is not optimized out
+        asm volatile(""
+        :
+        : "rm" (consumeAcc)
+        :);
+    #endif
+
     timespec_t stopTime;
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
     clock_gettime(CLOCK_MONOTONIC, &stopTime);
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
 
+    #if CPU_FREQ_EN
+        cpuFreqStop(cpuFreq);
+    #endif
+
     //Return results
     double* duration = malloc(sizeof(double));
     *duration = difftimespec(&stopTime, &startTime);
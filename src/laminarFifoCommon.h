@@ -3,21 +3,229 @@
 
 #include <stdatomic.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "laminarFifoParams.h"
+#include "timeSeries.h"
+#include "cpuFreq.h"
+#include "osNoise.h"
+#include "fifoOccupancy.h"
+
+//==== Block Layout ====
+//The block is generated from the layout parameters below (and the sample type and port count in laminarFifoParams.h), mirroring the
+//struct Laminar emits for a FIFO carrying FIFO_BLK_PORTS ports.  FIFO_BLK_SIZE_CPLX_FLOAT is the number of complex samples per port.
+//The default (1 planar float port, no padding) is the original block.
+
+#define FIFO_BLK_LAYOUT_PLANAR (0) //portN_real[] followed by portN_imag[]
+#define FIFO_BLK_LAYOUT_INTERLEAVED (1) //portN[] of {real, imag} pairs
+
+#ifndef FIFO_BLK_LAYOUT
+    #define FIFO_BLK_LAYOUT FIFO_BLK_LAYOUT_PLANAR
+#endif
+
+//Start each port on a cache line boundary (padding the end of the previous port)
+#ifndef FIFO_BLK_PORT_PAD
+    #define FIFO_BLK_PORT_PAD (0)
+#endif
+
+#define FIFO_BLK_PORT_PAD_BYTES (64)
+
+//The block is consumed (the power of each port is accumulated) by the FIFO client and memory reader after each read.
+//Used to compare how SIMD friendly each layout is for a downstream consumer
+#ifndef FIFO_BLK_CONSUME
+    #define FIFO_BLK_CONSUME (0)
+#endif
+
+_Static_assert(FIFO_BLK_PORTS >= 1 && FIFO_BLK_PORTS <= 8, "FIFO_BLK_PORTS must be in [1, 8]");
+
+#if FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_FLOAT
+    typedef float fifo_sample_t;
+    typedef float fifo_sample_acc_t; //The accumulator used when consuming blocks
+#elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_INT8
+    typedef int8_t fifo_sample_t;
+    typedef int32_t fifo_sample_acc_t;
+#elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_INT16
+    typedef int16_t fifo_sample_t;
+    typedef int32_t fifo_sample_acc_t;
+#elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_DOUBLE
+    typedef double fifo_sample_t;
+    typedef double fifo_sample_acc_t;
+#endif
+
+_Static_assert(sizeof(fifo_sample_t) == FIFO_BLK_SAMPLE_BYTES, "FIFO_BLK_SAMPLE_BYTES does not match fifo_sample_t");
+
+typedef struct {
+    fifo_sample_t real;
+    fifo_sample_t imag;
+} fifo_cplx_t;
+
+#if FIFO_BLK_PORT_PAD
+    #define FIFO_BLK_PORT_ALIGN _Alignas(FIFO_BLK_PORT_PAD_BYTES)
+#else
+    #define FIFO_BLK_PORT_ALIGN
+#endif
+
+#if FIFO_BLK_LAYOUT == FIFO_BLK_LAYOUT_PLANAR
+    #define FIFO_BLK_PORT_FIELDS(n) \
+        FIFO_BLK_PORT_ALIGN fifo_sample_t port##n##_real[FIFO_BLK_SIZE_CPLX_FLOAT]; \
+        fifo_sample_t port##n##_imag[FIFO_BLK_SIZE_CPLX_FLOAT];
+#elif FIFO_BLK_LAYOUT == FIFO_BLK_LAYOUT_INTERLEAVED
+    #define FIFO_BLK_PORT_FIELDS(n) \
+        FIFO_BLK_PORT_ALIGN fifo_cplx_t port##n[FIFO_BLK_SIZE_CPLX_FLOAT];
+#else
+    #error Unknown FIFO_BLK_LAYOUT
+#endif
+
+//Expands X(n) for each port n
+#define FIFO_BLK_PORT_IF(n, X) FIFO_BLK_PORT_IF_##n(X)
+#define FIFO_BLK_PORT_IF_1(X) X(1)
+#define FIFO_BLK_PORT_IF_2(X) X(2)
+#define FIFO_BLK_PORT_IF_3(X) X(3)
+#define FIFO_BLK_PORT_IF_4(X) X(4)
+#define FIFO_BLK_PORT_IF_5(X) X(5)
+#define FIFO_BLK_PORT_IF_6(X) X(6)
+#define FIFO_BLK_PORT_IF_7(X) X(7)
+#if FIFO_BLK_PORTS <= 1
+    #undef FIFO_BLK_PORT_IF_1
+    #define FIFO_BLK_PORT_IF_1(X)
+#endif
+#if FIFO_BLK_PORTS <= 2
+    #undef FIFO_BLK_PORT_IF_2
+    #define FIFO_BLK_PORT_IF_2(X)
+#endif
+#if FIFO_BLK_PORTS <= 3
+    #undef FIFO_BLK_PORT_IF_3
+    #define FIFO_BLK_PORT_IF_3(X)
+#endif
+#if FIFO_BLK_PORTS <= 4
+    #undef FIFO_BLK_PORT_IF_4
+    #define FIFO_BLK_PORT_IF_4(X)
+#endif
+#if FIFO_BLK_PORTS <= 5
+    #undef FIFO_BLK_PORT_IF_5
+    #define FIFO_BLK_PORT_IF_5(X)
+#endif
+#if FIFO_BLK_PORTS <= 6
+    #undef FIFO_BLK_PORT_IF_6
+    #define FIFO_BLK_PORT_IF_6(X)
+#endif
+#if FIFO_BLK_PORTS <= 7
+    #undef FIFO_BLK_PORT_IF_7
+    #define FIFO_BLK_PORT_IF_7(X)
+#endif
+#define FIFO_BLK_FOR_EACH_PORT(X) X(0) FIFO_BLK_PORT_IF(1, X) FIFO_BLK_PORT_IF(2, X) FIFO_BLK_PORT_IF(3, X) FIFO_BLK_PORT_IF(4, X) FIFO_BLK_PORT_IF(5, X) FIFO_BLK_PORT_IF(6, X) FIFO_BLK_PORT_IF(7, X)
 
 typedef struct {
-    float port0_real[FIFO_BLK_SIZE_CPLX_FLOAT];
-    float port0_imag[FIFO_BLK_SIZE_CPLX_FLOAT];
+    FIFO_BLK_FOR_EACH_PORT(FIFO_BLK_PORT_FIELDS)
 } PartitionCrossingFIFO_t;
 
+//Counts where the server and client spend each block: waiting for the FIFO (full for the server, empty for the client), copying the
+//block, and publishing the new offset.  Adds 3 TSC reads to each block.  The cycles are TSC ticks
+#ifndef FIFO_STALL_STATS_EN
+    #define FIFO_STALL_STATS_EN (0)
+#endif
+
+typedef struct {
+    int64_t waitIters; //Passes through the wait loop which found the FIFO still not ready (after reloading the other side's offset)
+    int64_t offsetReloads; //The number of times the other side's offset was loaded
+    uint64_t waitCycles;
+    uint64_t copyCycles; //Includes consuming the block if FIFO_BLK_CONSUME
+    uint64_t publishCycles;
+} fifo_stall_stats_t;
+
+/**
+ * Adds the TSC ticks since lastTSC to counter and advances lastTSC
+ */
+static inline void fifoStallAccount(uint64_t *lastTSC, uint64_t *counter){
+    uint64_t now = readTSC();
+    *counter += now - *lastTSC;
+    *lastTSC = now;
+}
+
 typedef struct {
     _Atomic int8_t *PartitionCrossingFIFO_readOffsetPtr_re;
     _Atomic int8_t *PartitionCrossingFIFO_writeOffsetPtr_re;
     PartitionCrossingFIFO_t *PartitionCrossingFIFO_arrayPtr_re;
     _Atomic bool *startTrigger; //This is shared by all threads
     atomic_flag *readyFlag; //This is unique to each thread
+    time_series_t *timeSeries; //This is unique to each thread.  Only used if TIME_SERIES_EN
+    cpu_freq_sample_t *cpuFreq; //This is unique to each thread.  Only used if CPU_FREQ_EN (may be NULL)
+    os_noise_t *osNoise; //This is unique to each thread.  Only used if OS_NOISE_EN
+    fifo_stall_stats_t *stallStats; //This is unique to each thread.  Only used if FIFO_STALL_STATS_EN.  Written by the thread before it returns
+    fifo_occupancy_t *occupancy; //This is unique to each thread.  Only used if FIFO_OCCUPANCY_EN
 } laminar_fifo_threadArgs_t;
 
 #define BLK_SIZE_BYTES (sizeof(PartitionCrossingFIFO_t))
+#define BLK_PAYLOAD_BYTES (FIFO_BLK_PORTS*FIFO_BLK_SIZE_CPLX_FLOAT*sizeof(fifo_cplx_t)) //Excludes any port padding
+#define BLK_SAMPLES (FIFO_BLK_PORTS*FIFO_BLK_SIZE_CPLX_FLOAT) //Complex samples in each block (all ports)
+
+/**
+ * Zeros the samples of every port in the block
+ */
+static inline void initFifoBlk(PartitionCrossingFIFO_t* blk){
+    #if FIFO_BLK_LAYOUT == FIFO_BLK_LAYOUT_PLANAR
+        #define FIFO_BLK_INIT_PORT(n) \
+            for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){ \
+                blk->port##n##_real[i] = 0; \
+            } \
+            for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){ \
+                blk->port##n##_imag[i] = 0; \
+            }
+    #else
+        #define FIFO_BLK_INIT_PORT(n) \
+            for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){ \
+                blk->port##n[i].real = 0; \
+                blk->port##n[i].imag = 0; \
+            }
+    #endif
+    FIFO_BLK_FOR_EACH_PORT(FIFO_BLK_INIT_PORT)
+    #undef FIFO_BLK_INIT_PORT
+}
+
+/**
+ * Accumulates the power (real^2 + imag^2) of every sample of every port in the block.  Stands in for a downstream SIMD consumer (see FIFO_BLK_CONSUME)
+ */
+static inline fifo_sample_acc_t consumeFifoBlk(PartitionCrossingFIFO_t* blk){
+    fifo_sample_acc_t acc = 0;
+    #if FIFO_BLK_LAYOUT == FIFO_BLK_LAYOUT_PLANAR
+        #define FIFO_BLK_CONSUME_PORT(n) \
+            for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){ \
+                acc += (fifo_sample_acc_t) blk->port##n##_real[i]*blk->port##n##_real[i] + (fifo_sample_acc_t) blk->port##n##_imag[i]*blk->port##n##_imag[i]; \
+            }
+    #else
+        #define FIFO_BLK_CONSUME_PORT(n) \
+            for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){ \
+                acc += (fifo_sample_acc_t) blk->port##n[i].real*blk->port##n[i].real + (fifo_sample_acc_t) blk->port##n[i].imag*blk->port##n[i].imag; \
+            }
+    #endif
+    FIFO_BLK_FOR_EACH_PORT(FIFO_BLK_CONSUME_PORT)
+    #undef FIFO_BLK_CONSUME_PORT
+    return acc;
+}
+
+/**
+ * Gets the name of the sample type (ex. Float, Int16)
+ */
+static inline const char* getFifoBlkSampleTypeName(){
+    #if FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_FLOAT
+        return "Float";
+    #elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_INT8
+        return "Int8";
+    #elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_INT16
+        return "Int16";
+    #else
+        return "Double";
+    #endif
+}
+
+/**
+ * Gets the name of the block layout (ex. Planar, InterleavedPadded)
+ */
+static inline const char* getFifoBlkLayoutName(){
+    #if FIFO_BLK_LAYOUT == FIFO_BLK_LAYOUT_PLANAR
+        return FIFO_BLK_PORT_PAD ? "PlanarPadded" : "Planar";
+    #else
+        return FIFO_BLK_PORT_PAD ? "InterleavedPadded" : "Interleaved";
+    #endif
+}
 
 #endif
\ No newline at end of file
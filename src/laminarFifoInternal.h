@@ -0,0 +1,29 @@
+#ifndef _LAMINAR_FIFO_INTERNAL_H
+#define _LAMINAR_FIFO_INTERNAL_H
+
+/*
+ * The positional FIFO allocation used by the benchmark runners.  Not part of the liblaminarfifo API (see laminarFifo.h)
+ */
+
+#include <stdatomic.h>
+#include "laminarFifoCommon.h"
+
+/**
+ * Allocates a FIFO's offsets and array (see laminarFifoCreate) and the ready flags of its server and client threads.
+ * This is the form used by the benchmark runners
+ */
+void initFIFO(_Atomic int8_t** PartitionCrossingFIFO_readOffsetPtr_re,
+              _Atomic int8_t** PartitionCrossingFIFO_writeOffsetPtr_re,
+              PartitionCrossingFIFO_t** PartitionCrossingFIFO_arrayPtr_re,
+              atomic_flag **serverFlag, atomic_flag **clientFlag,
+              int serverCore, int clientCore);
+
+/**
+ * Releases a FIFO allocated with initFIFO
+ */
+void cleanupFIFO(_Atomic int8_t* PartitionCrossingFIFO_readOffsetPtr_re,
+                 _Atomic int8_t* PartitionCrossingFIFO_writeOffsetPtr_re,
+                 PartitionCrossingFIFO_t* PartitionCrossingFIFO_arrayPtr_re,
+                 atomic_flag *serverFlag, atomic_flag *clientFlag);
+
+#endif
@@ -1,6 +1,42 @@
 #ifndef _LAMINAR_FIFO_PARAMS_H
 #define _LAMINAR_FIFO_PARAMS_H
 
+//The type of the real and imaginary parts of each complex sample in the block
+#define FIFO_BLK_SAMPLE_TYPE_FLOAT (0)
+#define FIFO_BLK_SAMPLE_TYPE_INT8 (1)
+#define FIFO_BLK_SAMPLE_TYPE_INT16 (2)
+#define FIFO_BLK_SAMPLE_TYPE_DOUBLE (3)
+
+#ifndef FIFO_BLK_SAMPLE_TYPE
+    #define FIFO_BLK_SAMPLE_TYPE FIFO_BLK_SAMPLE_TYPE_FLOAT
+#endif
+
+#if FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_FLOAT
+    #define FIFO_BLK_SAMPLE_BYTES (4)
+#elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_INT8
+    #define FIFO_BLK_SAMPLE_BYTES (1)
+#elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_INT16
+    #define FIFO_BLK_SAMPLE_BYTES (2)
+#elif FIFO_BLK_SAMPLE_TYPE == FIFO_BLK_SAMPLE_TYPE_DOUBLE
+    #define FIFO_BLK_SAMPLE_BYTES (8)
+#else
+    #error Unknown FIFO_BLK_SAMPLE_TYPE
+#endif
+
+//The number of ports in each block (port0, port1, ...)
+#ifndef FIFO_BLK_PORTS
+    #define FIFO_BLK_PORTS (1)
+#endif
+
+//The block size is either given in complex samples per port (FIFO_BLK_SIZE_CPLX_FLOAT, named before other sample types were supported)
+//or in bytes (FIFO_BLK_SIZE_BYTES, the payload of all ports).  FIFO_BLK_SIZE_BYTES takes precedence if both are given
+#ifdef FIFO_BLK_SIZE_BYTES
+    _Static_assert(FIFO_BLK_SIZE_BYTES > 0 && FIFO_BLK_SIZE_BYTES%(FIFO_BLK_PORTS*2*FIFO_BLK_SAMPLE_BYTES) == 0,
+                   "FIFO_BLK_SIZE_BYTES must be a nonzero multiple of the complex sample size of all ports (FIFO_BLK_PORTS*2*FIFO_BLK_SAMPLE_BYTES)");
+    #undef FIFO_BLK_SIZE_CPLX_FLOAT
+    #define FIFO_BLK_SIZE_CPLX_FLOAT (FIFO_BLK_SIZE_BYTES/(FIFO_BLK_PORTS*2*FIFO_BLK_SAMPLE_BYTES))
+#endif
+
 //Defined by makefile
 #ifndef FIFO_BLK_SIZE_CPLX_FLOAT
     #define FIFO_BLK_SIZE_CPLX_FLOAT 256
@@ -0,0 +1,187 @@
+#include "laminarFifoPartition.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "timeHelpers.h"
+#include "testParams.h"
+
+//timeReadyChecks is a compile-time constant in each caller so the untimed variant carries no TSC reads or branches
+static inline __attribute__((always_inline)) void *fifo_partition_thread_impl(void* args, const bool timeReadyChecks){
+    laminar_partition_threadArgs_t *args_cast = (laminar_partition_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int numInputs = args_cast->numInputs;
+    int numOutputs = args_cast->numOutputs;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+
+    //==== Setup Input FIFOs ====
+    int8_t inputWriteOffsetCached[PARTITION_MAX_PORTS];
+    int8_t inputReadOffsetCached[PARTITION_MAX_PORTS];
+    for(int i = 0; i<numInputs; i++){
+        inputWriteOffsetCached[i] = atomic_load_explicit(args_cast->inputWriteOffsetPtrs[i], memory_order_acquire);
+        inputReadOffsetCached[i] = atomic_load_explicit(args_cast->inputReadOffsetPtrs[i], memory_order_acquire);
+    }
+    PartitionCrossingFIFO_t readTmp[PARTITION_MAX_PORTS];
+
+    //==== Setup Output FIFOs ====
+    int8_t outputWriteOffsetCached[PARTITION_MAX_PORTS];
+    int8_t outputReadOffsetCached[PARTITION_MAX_PORTS];
+    for(int i = 0; i<numOutputs; i++){
+        outputWriteOffsetCached[i] = atomic_load_explicit(args_cast->outputWriteOffsetPtrs[i], memory_order_acquire);
+        outputReadOffsetCached[i] = atomic_load_explicit(args_cast->outputReadOffsetPtrs[i], memory_order_acquire);
+    }
+
+    //==== Init read temps (the outputs are written from the blocks read from the inputs) ====
+    memset(readTmp, 0, sizeof(PartitionCrossingFIFO_t)*(numInputs > 0 ? numInputs : 1)); //A partition with no inputs writes readTmp[0]
+
+    int64_t inputCheckPasses = 0;
+    int64_t outputCheckPasses = 0;
+    int64_t inputOffsetReloads = 0;
+    int64_t outputOffsetReloads = 0;
+    uint64_t readyCheckCycles = 0;
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        uint64_t readyCheckStart = 0;
+        if(timeReadyChecks){
+            readyCheckStart = readTSC();
+        }
+
+        //Wait for input FIFO(s) to be ready
+        bool inputFIFOsReady = false;
+        while (!inputFIFOsReady)
+        {
+            inputFIFOsReady = true;
+            inputCheckPasses++;
+            for(int i = 0; i<numInputs; i++)
+            {
+                bool notEmpty = (!((inputWriteOffsetCached[i] - inputReadOffsetCached[i] == 1) || (inputWriteOffsetCached[i] - inputReadOffsetCached[i] == -FIFO_LEN_BLKS)));
+                if (!(notEmpty))
+                {
+                    inputWriteOffsetCached[i] = atomic_load_explicit(args_cast->inputWriteOffsetPtrs[i], memory_order_acquire);
+                    inputOffsetReloads++;
+                    notEmpty = (!((inputWriteOffsetCached[i] - inputReadOffsetCached[i] == 1) || (inputWriteOffsetCached[i] - inputReadOffsetCached[i] == -FIFO_LEN_BLKS)));
+                }
+                inputFIFOsReady &= notEmpty;
+            }
+        }
+
+        //Wait for output FIFO(s) to be ready
+        bool outputFIFOsReady = false;
+        while (!outputFIFOsReady)
+        {
+            outputFIFOsReady = true;
+            outputCheckPasses++;
+            for(int i = 0; i<numOutputs; i++)
+            {
+                bool notFull = (outputReadOffsetCached[i] != outputWriteOffsetCached[i]);
+                if (!(notFull))
+                {
+                    outputReadOffsetCached[i] = atomic_load_explicit(args_cast->outputReadOffsetPtrs[i], memory_order_acquire);
+                    outputOffsetReloads++;
+                    notFull = (outputReadOffsetCached[i] != outputWriteOffsetCached[i]);
+                }
+                outputFIFOsReady &= notFull;
+            }
+        }
+
+        if(timeReadyChecks){
+            readyCheckCycles += readTSC() - readyCheckStart;
+        }
+
+        //Read input FIFO(s)
+        for(int i = 0; i<numInputs; i++)
+        {
+            int readOffset = inputReadOffsetCached[i];
+            if (readOffset >= FIFO_LEN_BLKS)
+            {
+                readOffset = 0;
+            }
+            else
+            {
+                readOffset++;
+            }
+
+            //Read from array
+            fifoConsumerPrefetch(args_cast->inputArrayPtrs[i], readOffset);
+            copyBlkFromFifo(readTmp+i, args_cast->inputArrayPtrs[i] + readOffset);
+            inputReadOffsetCached[i] = readOffset;
+            //Update Read Ptr
+            atomic_store_explicit(args_cast->inputReadOffsetPtrs[i], readOffset, memory_order_release);
+        }
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        : "+m" (readTmp)
+        :
+        :);
+
+        //Write output FIFO(s)
+        for(int i = 0; i<numOutputs; i++)
+        {
+            int writeOffset = outputWriteOffsetCached[i];
+            //Write into array
+            copyBlkToFifo(args_cast->outputArrayPtrs[i] + writeOffset, readTmp + (numInputs > 0 ? i%numInputs : 0));
+            fifoProducerHint(args_cast->outputArrayPtrs[i] + writeOffset);
+            if (writeOffset >= FIFO_LEN_BLKS)
+            {
+                writeOffset = 0;
+            }
+            else
+            {
+                writeOffset++;
+            }
+            outputWriteOffsetCached[i] = writeOffset;
+            //Update Write Ptr
+            atomic_store_explicit(args_cast->outputWriteOffsetPtrs[i], writeOffset, memory_order_release);
+        }
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    args_cast->stats->inputCheckPasses = inputCheckPasses;
+    args_cast->stats->outputCheckPasses = outputCheckPasses;
+    args_cast->stats->inputOffsetReloads = inputOffsetReloads;
+    args_cast->stats->outputOffsetReloads = outputOffsetReloads;
+    args_cast->stats->readyCheckCycles = readyCheckCycles;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+void *fifo_partition_thread(void* args){
+    return fifo_partition_thread_impl(args, PARTITION_READY_CHECK_TSC);
+}
+
+void *fifo_partition_thread_untimed(void* args){
+    return fifo_partition_thread_impl(args, false);
+}
@@ -0,0 +1,58 @@
+#ifndef _LAMINAR_FIFO_PARTITION_H
+#define _LAMINAR_FIFO_PARTITION_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * A partition thread with multiple input and output Laminar FIFOs (ex. a combiner or splitter partition).
+ * Each block, the partition waits for all input FIFOs to be non-empty and all output FIFOs to be non-full (using the same
+ * inputFIFOsReady &= / outputFIFOsReady &= checks Laminar generates, with cached offsets for each FIFO), reads a block
+ * from each input, and writes a block to each output.
+ */
+
+#ifndef PARTITION_MAX_PORTS
+    #define PARTITION_MAX_PORTS (32)
+#endif
+
+//Time the ready checks of fifo_partition_thread with the TSC (adds 2 TSC reads per block).  fifo_partition_thread_untimed never times them
+#ifndef PARTITION_READY_CHECK_TSC
+    #define PARTITION_READY_CHECK_TSC (1)
+#endif
+
+typedef struct {
+    int64_t inputCheckPasses; //Passes over the input FIFOs before all were ready
+    int64_t outputCheckPasses; //Passes over the output FIFOs before all were ready
+    int64_t inputOffsetReloads; //Loads of an input FIFO's write offset (when the cached offset showed the FIFO as empty)
+    int64_t outputOffsetReloads; //Loads of an output FIFO's read offset (when the cached offset showed the FIFO as full)
+    uint64_t readyCheckCycles; //TSC cycles spent in the ready checks.  Only valid for fifo_partition_thread if PARTITION_READY_CHECK_TSC (0 otherwise)
+} laminar_partition_stats_t;
+
+typedef struct {
+    int numInputs;
+    _Atomic int8_t *inputReadOffsetPtrs[PARTITION_MAX_PORTS];
+    _Atomic int8_t *inputWriteOffsetPtrs[PARTITION_MAX_PORTS];
+    PartitionCrossingFIFO_t *inputArrayPtrs[PARTITION_MAX_PORTS];
+    int numOutputs;
+    _Atomic int8_t *outputReadOffsetPtrs[PARTITION_MAX_PORTS];
+    _Atomic int8_t *outputWriteOffsetPtrs[PARTITION_MAX_PORTS];
+    PartitionCrossingFIFO_t *outputArrayPtrs[PARTITION_MAX_PORTS];
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+    laminar_partition_stats_t *stats; //Written by the partition thread before it returns
+} laminar_partition_threadArgs_t;
+
+/**
+ * Takes laminar_partition_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *fifo_partition_thread(void* args);
+
+/**
+ * fifo_partition_thread without the ready check timing (for comparisons against FIFO threads which are not instrumented).
+ * Takes laminar_partition_threadArgs_t, returns a malloc-ed double with the duration.  stats->readyCheckCycles is 0
+ */
+void *fifo_partition_thread_untimed(void* args);
+
+#endif
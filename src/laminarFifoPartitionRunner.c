@@ -0,0 +1,247 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "laminarFifoPartitionRunner.h"
+#include "laminarFifoRunner.h"
+#include "laminarFifoInternal.h"
+#include "laminarFifoServer.h"
+#include "laminarFifoClient.h"
+#include "testParams.h"
+#include "timeHelpers.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "vitisNumaAllocHelpers.h"
+#include "topologyHelpers.h"
+#include "cacheState.h"
+
+typedef struct {
+    _Atomic int8_t* readOffsetPtr;
+    _Atomic int8_t* writeOffsetPtr;
+    PartitionCrossingFIFO_t* arrayPtr;
+    atomic_flag *serverReadyFlag;
+    atomic_flag *clientReadyFlag;
+} partition_fifo_t;
+
+static fifo_runner_thread_vars_t* startPeerThread(partition_fifo_t *fifo, _Atomic bool* startTrigger, atomic_flag *readyFlag, int core, void* (*thread_fun)(void*)){
+    fifo_runner_thread_vars_t *threadVars = (fifo_runner_thread_vars_t*) bufferArenaAlloc(sizeof(fifo_runner_thread_vars_t), core);
+    threadVars->core = core;
+    threadVars->args.PartitionCrossingFIFO_readOffsetPtr_re = fifo->readOffsetPtr;
+    threadVars->args.PartitionCrossingFIFO_writeOffsetPtr_re = fifo->writeOffsetPtr;
+    threadVars->args.PartitionCrossingFIFO_arrayPtr_re = fifo->arrayPtr;
+    threadVars->args.startTrigger = startTrigger;
+    threadVars->args.readyFlag = readyFlag;
+    #if TIME_SERIES_EN
+        threadVars->args.timeSeries = initTimeSeries(core);
+    #else
+        threadVars->args.timeSeries = NULL;
+    #endif
+    threadVars->args.cpuFreq = NULL; //Not sampled for the partition benchmark
+    //The noise log, stall counters, and occupancy of the peer threads are allocated (if enabled) but not reported for the partition benchmark
+    #if OS_NOISE_EN
+        threadVars->args.osNoise = initOsNoise(core);
+    #else
+        threadVars->args.osNoise = NULL;
+    #endif
+    #if FIFO_STALL_STATS_EN
+        threadVars->args.stallStats = (fifo_stall_stats_t*) bufferArenaAlloc(sizeof(fifo_stall_stats_t), core);
+    #else
+        threadVars->args.stallStats = NULL;
+    #endif
+    #if FIFO_OCCUPANCY_EN
+        threadVars->args.occupancy = initFifoOccupancy(core);
+    #else
+        threadVars->args.occupancy = NULL;
+    #endif
+
+    workerPoolSubmit(core, thread_fun, &(threadVars->args));
+
+    return threadVars;
+}
+
+static void setPartitionFifoBuffers(partition_fifo_t *fifo, void** buffers, size_t* sizes){
+    buffers[0] = fifo->arrayPtr;
+    sizes[0] = sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1);
+    buffers[1] = fifo->readOffsetPtr;
+    sizes[1] = sizeof(_Atomic int8_t);
+    buffers[2] = fifo->writeOffsetPtr;
+    sizes[2] = sizeof(_Atomic int8_t);
+}
+
+static double joinThread(int core){
+    double *result = (double*) workerPoolJoin(core);
+    double time = *result;
+    free(result);
+    return time;
+}
+
+void writePartitionSummaryHeader(FILE* summaryFile){
+    fprintf(summaryFile, "NumInputs,NumOutputs,PartitionCPU,PartitionTime,AggregateBytes,AggregateGbps,InputCheckPassesPerBlk,OutputCheckPassesPerBlk,InputOffsetReloadsPerBlk,OutputOffsetReloadsPerBlk,ReadyCheckCyclesPerBlk,ReadyCheckFraction,CacheState\n");
+}
+
+void runLaminarPartitionBench(int partitionCPU, int *inputCPUs, int numInputs, int *outputCPUs, int numOutputs, char* reportFilename, FILE* summaryFile){
+    if(numInputs > PARTITION_MAX_PORTS || numOutputs > PARTITION_MAX_PORTS){
+        printf("Partition has more than %d inputs or outputs (PARTITION_MAX_PORTS) ... exiting\n", PARTITION_MAX_PORTS);
+        exit(1);
+    }
+
+    //Create FIFOs (will allocate write ptr and array on server side).  The partition is the client of the inputs and the server of the outputs
+    partition_fifo_t inputFIFOs[numInputs];
+    partition_fifo_t outputFIFOs[numOutputs];
+    for(int i = 0; i<numInputs; i++){
+        initFIFO(&(inputFIFOs[i].readOffsetPtr), &(inputFIFOs[i].writeOffsetPtr), &(inputFIFOs[i].arrayPtr), &(inputFIFOs[i].serverReadyFlag), &(inputFIFOs[i].clientReadyFlag), inputCPUs[i], partitionCPU);
+    }
+    for(int i = 0; i<numOutputs; i++){
+        initFIFO(&(outputFIFOs[i].readOffsetPtr), &(outputFIFOs[i].writeOffsetPtr), &(outputFIFOs[i].arrayPtr), &(outputFIFOs[i].serverReadyFlag), &(outputFIFOs[i].clientReadyFlag), partitionCPU, outputCPUs[i]);
+    }
+
+    //Set the cache state of the FIFOs (see cacheState.h)
+    void* inputBuffers[numInputs][3];
+    size_t inputBufferSizes[numInputs][3];
+    void* outputBuffers[numOutputs][3];
+    size_t outputBufferSizes[numOutputs][3];
+    for(int i = 0; i<numInputs; i++){
+        setPartitionFifoBuffers(inputFIFOs+i, inputBuffers[i], inputBufferSizes[i]);
+        cacheStateBeforeStart(inputBuffers[i], inputBufferSizes[i], 3, inputCPUs[i], partitionCPU);
+    }
+    for(int i = 0; i<numOutputs; i++){
+        setPartitionFifoBuffers(outputFIFOs+i, outputBuffers[i], outputBufferSizes[i]);
+        cacheStateBeforeStart(outputBuffers[i], outputBufferSizes[i], 3, partitionCPU, outputCPUs[i]);
+    }
+
+    //The partition signals ready with its own flag (the partition side flags of each FIFO are unused)
+    atomic_flag *partitionReadyFlag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), partitionCPU);
+    atomic_signal_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(partitionReadyFlag, memory_order_release); //Init since this was malloc-ed
+    atomic_flag_test_and_set_explicit(partitionReadyFlag, memory_order_acq_rel);
+
+    //Create starting trigger
+    _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, false, memory_order_release);
+
+    //Start Threads
+    laminar_partition_threadArgs_t *partitionArgs = (laminar_partition_threadArgs_t*) bufferArenaAlloc(sizeof(laminar_partition_threadArgs_t), partitionCPU);
+    laminar_partition_stats_t *partitionStats = (laminar_partition_stats_t*) bufferArenaAlloc(sizeof(laminar_partition_stats_t), partitionCPU);
+    partitionArgs->numInputs = numInputs;
+    for(int i = 0; i<numInputs; i++){
+        partitionArgs->inputReadOffsetPtrs[i] = inputFIFOs[i].readOffsetPtr;
+        partitionArgs->inputWriteOffsetPtrs[i] = inputFIFOs[i].writeOffsetPtr;
+        partitionArgs->inputArrayPtrs[i] = inputFIFOs[i].arrayPtr;
+    }
+    partitionArgs->numOutputs = numOutputs;
+    for(int i = 0; i<numOutputs; i++){
+        partitionArgs->outputReadOffsetPtrs[i] = outputFIFOs[i].readOffsetPtr;
+        partitionArgs->outputWriteOffsetPtrs[i] = outputFIFOs[i].writeOffsetPtr;
+        partitionArgs->outputArrayPtrs[i] = outputFIFOs[i].arrayPtr;
+    }
+    partitionArgs->startTrigger = startTrigger;
+    partitionArgs->readyFlag = partitionReadyFlag;
+    partitionArgs->stats = partitionStats;
+    workerPoolSubmit(partitionCPU, fifo_partition_thread, partitionArgs);
+
+    fifo_runner_thread_vars_t *inputThreadVars[numInputs];
+    fifo_runner_thread_vars_t *outputThreadVars[numOutputs];
+    for(int i = 0; i<numInputs; i++){
+        inputThreadVars[i] = startPeerThread(inputFIFOs+i, startTrigger, inputFIFOs[i].serverReadyFlag, inputCPUs[i], fifo_server_thread);
+    }
+    for(int i = 0; i<numOutputs; i++){
+        outputThreadVars[i] = startPeerThread(outputFIFOs+i, startTrigger, outputFIFOs[i].clientReadyFlag, outputCPUs[i], fifo_client_thread);
+    }
+
+    //Wait for all threads ready
+    bool wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(partitionReadyFlag, memory_order_acq_rel);
+    }
+    for(int i = 0; i<numInputs; i++){
+        wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(inputFIFOs[i].serverReadyFlag, memory_order_acq_rel);
+        }
+    }
+    for(int i = 0; i<numOutputs; i++){
+        wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(outputFIFOs[i].clientReadyFlag, memory_order_acq_rel);
+        }
+    }
+
+    for(int i = 0; i<numInputs; i++){
+        cacheStateBeforeTrigger(inputBuffers[i], inputBufferSizes[i], 3);
+    }
+    for(int i = 0; i<numOutputs; i++){
+        cacheStateBeforeTrigger(outputBuffers[i], outputBufferSizes[i], 3);
+    }
+
+    //Start FIFO transfers
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, true, memory_order_release);
+
+    //Wait for threads to finish
+    double partitionTime = joinThread(partitionCPU);
+    double inputTimes[numInputs];
+    double outputTimes[numOutputs];
+    for(int i = 0; i<numInputs; i++){
+        inputTimes[i] = joinThread(inputCPUs[i]);
+    }
+    for(int i = 0; i<numOutputs; i++){
+        outputTimes[i] = joinThread(outputCPUs[i]);
+    }
+
+    //Write results
+    long long int bytesPerFIFO = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    double blks = TRANSACTIONS_BLKS;
+    double readyCheckCyclesPerBlk = PARTITION_READY_CHECK_TSC ? partitionStats->readyCheckCycles/blks : 0;
+    double readyCheckFraction = PARTITION_READY_CHECK_TSC ? partitionStats->readyCheckCycles/(partitionTime*getTSCFreqHz()) : 0;
+
+    FILE *resultsFile = fopen(reportFilename, "w");
+    fprintf(resultsFile, "Role,CPU,Port,NumInputs,NumOutputs,Time,BytesRx,BytesTx,InputCheckPasses,OutputCheckPasses,InputOffsetReloads,OutputOffsetReloads,ReadyCheckCycles,ReadyCheckFraction,CacheState,Level\n");
+    fprintf(resultsFile, "Partition,%d,%d,%d,%d,%e,%lld,%lld,%ld,%ld,%ld,%ld,%lu,%e,%s,NA\n", partitionCPU, -1, numInputs, numOutputs, partitionTime, bytesPerFIFO*numInputs, bytesPerFIFO*numOutputs,
+            partitionStats->inputCheckPasses, partitionStats->outputCheckPasses, partitionStats->inputOffsetReloads, partitionStats->outputOffsetReloads,
+            partitionStats->readyCheckCycles, readyCheckFraction, getCacheStateName(CACHE_STATE));
+    for(int i = 0; i<numInputs; i++){
+        fprintf(resultsFile, "InputServer,%d,%d,%d,%d,%e,%lld,%lld,0,0,0,0,0,0,%s,%s\n", inputCPUs[i], i, numInputs, numOutputs, inputTimes[i], 0LL, bytesPerFIFO,
+                getCacheStateName(CACHE_STATE),
+                getTopologyLevelName(getTopologyLevel(inputCPUs[i], partitionCPU)));
+    }
+    for(int i = 0; i<numOutputs; i++){
+        fprintf(resultsFile, "OutputClient,%d,%d,%d,%d,%e,%lld,%lld,0,0,0,0,0,0,%s,%s\n", outputCPUs[i], i, numInputs, numOutputs, outputTimes[i], bytesPerFIFO, 0LL,
+                getCacheStateName(CACHE_STATE),
+                getTopologyLevelName(getTopologyLevel(partitionCPU, outputCPUs[i])));
+    }
+    fclose(resultsFile);
+
+    if(summaryFile != NULL){
+        long long int aggregateBytes = bytesPerFIFO*(numInputs+numOutputs);
+        fprintf(summaryFile, "%d,%d,%d,%e,%lld,%e,%e,%e,%e,%e,%e,%e,%s\n", numInputs, numOutputs, partitionCPU, partitionTime, aggregateBytes, aggregateBytes*8/partitionTime/1e9,
+                partitionStats->inputCheckPasses/blks, partitionStats->outputCheckPasses/blks, partitionStats->inputOffsetReloads/blks, partitionStats->outputOffsetReloads/blks,
+                readyCheckCyclesPerBlk, readyCheckFraction, getCacheStateName(CACHE_STATE));
+        fflush(summaryFile);
+    }
+
+    //Cleanup
+    for(int i = 0; i<numInputs; i++){
+        bufferArenaFree(inputThreadVars[i]->args.timeSeries);
+        bufferArenaFree(inputThreadVars[i]->args.osNoise);
+        bufferArenaFree(inputThreadVars[i]->args.stallStats);
+        bufferArenaFree(inputThreadVars[i]->args.occupancy);
+        bufferArenaFree(inputThreadVars[i]);
+        cleanupFIFO(inputFIFOs[i].readOffsetPtr, inputFIFOs[i].writeOffsetPtr, inputFIFOs[i].arrayPtr, inputFIFOs[i].serverReadyFlag, inputFIFOs[i].clientReadyFlag);
+    }
+    for(int i = 0; i<numOutputs; i++){
+        bufferArenaFree(outputThreadVars[i]->args.timeSeries);
+        bufferArenaFree(outputThreadVars[i]->args.osNoise);
+        bufferArenaFree(outputThreadVars[i]->args.stallStats);
+        bufferArenaFree(outputThreadVars[i]->args.occupancy);
+        bufferArenaFree(outputThreadVars[i]);
+        cleanupFIFO(outputFIFOs[i].readOffsetPtr, outputFIFOs[i].writeOffsetPtr, outputFIFOs[i].arrayPtr, outputFIFOs[i].serverReadyFlag, outputFIFOs[i].clientReadyFlag);
+    }
+    bufferArenaFree(partitionArgs);
+    bufferArenaFree(partitionStats);
+    bufferArenaFree(partitionReadyFlag);
+    free(startTrigger);
+}
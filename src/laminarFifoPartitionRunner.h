@@ -0,0 +1,25 @@
+#ifndef _LAMINAR_FIFO_PARTITION_RUNNER_H
+#define _LAMINAR_FIFO_PARTITION_RUNNER_H
+
+#include <stdio.h>
+#include "laminarFifoPartition.h"
+
+/**
+ * Runs a partition thread with multiple input and output Laminar FIFOs.  Each input FIFO is fed by a server thread (fifo_server_thread)
+ * and each output FIFO is drained by a client thread (fifo_client_thread)
+ * @param partitionCPU the CPU the partition runs on
+ * @param inputCPUs the CPUs of the server threads feeding each input FIFO
+ * @param numInputs the number of input FIFOs (also the size of inputCPUs)
+ * @param outputCPUs the CPUs of the client threads draining each output FIFO
+ * @param numOutputs the number of output FIFOs (also the size of outputCPUs)
+ * @param reportFilename
+ * @param summaryFile if not NULL, a row summarizing the partition is appended (see writePartitionSummaryHeader)
+ */
+void runLaminarPartitionBench(int partitionCPU, int *inputCPUs, int numInputs, int *outputCPUs, int numOutputs, char* reportFilename, FILE* summaryFile);
+
+/**
+ * Writes the header for the summary rows appended by runLaminarPartitionBench
+ */
+void writePartitionSummaryHeader(FILE* summaryFile);
+
+#endif
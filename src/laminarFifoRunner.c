@@ -16,58 +16,18 @@
 #include "laminarFifoParams.h"
 #include "testParams.h"
 #include "laminarFifoRunner.h"
+#include "laminarFifoInternal.h"
+#include "laminarFifo.h"
 #include "vitisNumaAllocHelpers.h"
-
-void initFIFO(_Atomic int8_t** PartitionCrossingFIFO_readOffsetPtr_re, 
-              _Atomic int8_t** PartitionCrossingFIFO_writeOffsetPtr_re, 
-              PartitionCrossingFIFO_t** PartitionCrossingFIFO_arrayPtr_re, 
-              atomic_flag **serverFlag, atomic_flag **clientFlag, 
-              int serverCore, int clientCore){
-    *PartitionCrossingFIFO_readOffsetPtr_re = (_Atomic int8_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(_Atomic int8_t), clientCore);
-    *PartitionCrossingFIFO_writeOffsetPtr_re = (_Atomic int8_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(_Atomic int8_t), serverCore);
-    *PartitionCrossingFIFO_arrayPtr_re = (PartitionCrossingFIFO_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1), serverCore); //Alloc an additional block (for empty/full ambiguity resolution)
-
-    *serverFlag = (atomic_flag*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(atomic_flag), serverCore);
-    *clientFlag = (atomic_flag*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(atomic_flag), clientCore);
-
-    //Init Flags
-    atomic_signal_fence(memory_order_acquire);
-    atomic_flag_clear_explicit(*serverFlag, memory_order_release); //Init since this was malloc-ed
-    atomic_flag_clear_explicit(*clientFlag, memory_order_release); //Init since this was malloc-ed
-    atomic_flag_test_and_set_explicit(*serverFlag, memory_order_acq_rel);
-    atomic_flag_test_and_set_explicit(*clientFlag, memory_order_acq_rel);
-    
-    //Init Ptrs (will not have any initial state in the FIFO)
-    atomic_init(*PartitionCrossingFIFO_readOffsetPtr_re, 0);
-    if(!atomic_is_lock_free(*PartitionCrossingFIFO_readOffsetPtr_re)){
-        printf("Warning: An atomic FIFO offset (PartitionCrossingFIFO_readOffsetPtr_re) was expected to be lock free but is not\n");
-    }
-    atomic_init(*PartitionCrossingFIFO_writeOffsetPtr_re, 1);
-    if(!atomic_is_lock_free(*PartitionCrossingFIFO_writeOffsetPtr_re)){
-        printf("Warning: An atomic FIFO offset (PartitionCrossingFIFO_writeOffsetPtr_re) was expected to be lock free but is not\n");
-    }
-
-    //Init array
-    for(int i = 0; i<FIFO_LEN_BLKS+1; i++){
-        for(int j = 0; j<FIFO_BLK_SIZE_CPLX_FLOAT; j++){
-            (*PartitionCrossingFIFO_arrayPtr_re)[i].port0_real[j]=0;
-        }
-        for(int j = 0; j<FIFO_BLK_SIZE_CPLX_FLOAT; j++){
-            (*PartitionCrossingFIFO_arrayPtr_re)[i].port0_imag[j]=0;
-        }
-    }
-}
-
-void cleanupFIFO(_Atomic int8_t* PartitionCrossingFIFO_readOffsetPtr_re, 
-                 _Atomic int8_t* PartitionCrossingFIFO_writeOffsetPtr_re, 
-                 PartitionCrossingFIFO_t* PartitionCrossingFIFO_arrayPtr_re, 
-                 atomic_flag *serverFlag, atomic_flag *clientFlag){
-    free(PartitionCrossingFIFO_readOffsetPtr_re);
-    free(PartitionCrossingFIFO_writeOffsetPtr_re);
-    free(PartitionCrossingFIFO_arrayPtr_re);
-    free(serverFlag);
-    free(clientFlag);
-}
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "timeSeries.h"
+#include "reportHelpers.h"
+#include "cacheState.h"
+#include "cpuFreq.h"
+#include "osNoise.h"
+#include "fifoOccupancy.h"
+#include "topologyHelpers.h"
 
 fifo_runner_thread_vars_container_t* startThread(_Atomic int8_t* PartitionCrossingFIFO_readOffsetPtr_re, 
                                                  _Atomic int8_t* PartitionCrossingFIFO_writeOffsetPtr_re, 
@@ -77,8 +37,8 @@ fifo_runner_thread_vars_container_t* startThread(_Atomic int8_t* PartitionCrossi
                                                  atomic_flag *clientReadyFlag,
                                                  int serverCore, int clientCore){
     //Allocate: fifo_runner_thread_vars_t
-    fifo_runner_thread_vars_t *serverThreadVars = (fifo_runner_thread_vars_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(fifo_runner_thread_vars_t), serverCore);
-    fifo_runner_thread_vars_t *clientThreadVars = (fifo_runner_thread_vars_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(fifo_runner_thread_vars_t), clientCore);
+    fifo_runner_thread_vars_t *serverThreadVars = (fifo_runner_thread_vars_t*) bufferArenaAlloc(sizeof(fifo_runner_thread_vars_t), serverCore);
+    fifo_runner_thread_vars_t *clientThreadVars = (fifo_runner_thread_vars_t*) bufferArenaAlloc(sizeof(fifo_runner_thread_vars_t), clientCore);
 
     //Set arguments
     //Don't need to align this as it is only used by the master thread which is not actually performing the benchmarking
@@ -86,82 +46,8 @@ fifo_runner_thread_vars_container_t* startThread(_Atomic int8_t* PartitionCrossi
     threadVarContainer->serverVars = serverThreadVars;
     threadVarContainer->clientVars = clientThreadVars;
 
-    int status;
-    status = pthread_attr_init(&(serverThreadVars->attr));
-    if (status != 0)
-    {
-        printf("Could not create server pthread attributes ... exiting");
-        exit(1);
-    }
-    status = pthread_attr_init(&(clientThreadVars->attr));
-    if (status != 0)
-    {
-        printf("Could not create client pthread attributes ... exiting");
-        exit(1);
-    }
-
-    //Set partition to run with SCHED_FIFO RT Scheduler with Max Priority
-    //NOTE! This can lock up the computer if this thread is run on a CPU where system tasks are running.
-    status = pthread_attr_setinheritsched(&(serverThreadVars->attr), PTHREAD_EXPLICIT_SCHED);
-    if (status != 0)
-    {
-        printf("Could not set server pthread explicit schedule attribute ... exiting\n");
-        exit(1);
-    }
-    status = pthread_attr_setinheritsched(&(clientThreadVars->attr), PTHREAD_EXPLICIT_SCHED);
-    if (status != 0)
-    {
-        printf("Could not set client pthread explicit schedule attribute ... exiting\n");
-        exit(1);
-    }
-
-    status = pthread_attr_setschedpolicy(&(serverThreadVars->attr), SCHED_FIFO);
-    if (status != 0)
-    {
-        printf("Could not set server pthread schedule policy to SCHED_FIFO ... exiting\n");
-        exit(1);
-    }
-    status = pthread_attr_setschedpolicy(&(clientThreadVars->attr), SCHED_FIFO);
-    if (status != 0)
-    {
-        printf("Could not set client pthread schedule policy to SCHED_FIFO ... exiting\n");
-        exit(1);
-    }
-
-    serverThreadVars->threadParams.sched_priority = sched_get_priority_max(SCHED_FIFO);
-    status = pthread_attr_setschedparam(&(serverThreadVars->attr), &(serverThreadVars->threadParams));
-    if (status != 0)
-    {
-        printf("Could not set server pthread schedule parameter ... exiting\n");
-        exit(1);
-    }
-    clientThreadVars->threadParams.sched_priority = sched_get_priority_max(SCHED_FIFO);
-    status = pthread_attr_setschedparam(&(clientThreadVars->attr), &(clientThreadVars->threadParams));
-    if (status != 0)
-    {
-        printf("Could not set client pthread schedule parameter ... exiting\n");
-        exit(1);
-    }
-
-    //Set server partition to run on specified CPU
-    CPU_ZERO(&(serverThreadVars->cpuset));                                                                           //Clear cpuset
-    CPU_SET(serverCore, &(serverThreadVars->cpuset));                                                                //Add CPU to cpuset
-    status = pthread_attr_setaffinity_np(&(serverThreadVars->attr), sizeof(cpu_set_t), &(serverThreadVars->cpuset)); //Set thread CPU affinity
-    if (status != 0)
-    {
-        printf("Could not set server thread core affinity ... exiting");
-        exit(1);
-    }
-
-    //Set client partition to run on specified CPU
-    CPU_ZERO(&(clientThreadVars->cpuset));                                                                           //Clear cpuset
-    CPU_SET(clientCore, &(clientThreadVars->cpuset));                                                                //Add CPU to cpuset
-    status = pthread_attr_setaffinity_np(&(clientThreadVars->attr), sizeof(cpu_set_t), &(clientThreadVars->cpuset)); //Set thread CPU affinity
-    if (status != 0)
-    {
-        printf("Could not set client thread core affinity ... exiting");
-        exit(1);
-    }
+    serverThreadVars->core = serverCore;
+    clientThreadVars->core = clientCore;
 
     //Set server arguments
     serverThreadVars->args.PartitionCrossingFIFO_readOffsetPtr_re = PartitionCrossingFIFO_readOffsetPtr_re;
@@ -169,6 +55,31 @@ fifo_runner_thread_vars_container_t* startThread(_Atomic int8_t* PartitionCrossi
     serverThreadVars->args.PartitionCrossingFIFO_arrayPtr_re = PartitionCrossingFIFO_arrayPtr_re;
     serverThreadVars->args.startTrigger = startTrigger;
     serverThreadVars->args.readyFlag = serverReadyFlag;
+    #if TIME_SERIES_EN
+        serverThreadVars->args.timeSeries = initTimeSeries(serverCore);
+    #else
+        serverThreadVars->args.timeSeries = NULL;
+    #endif
+    #if CPU_FREQ_EN
+        serverThreadVars->args.cpuFreq = initCpuFreq(serverCore);
+    #else
+        serverThreadVars->args.cpuFreq = NULL;
+    #endif
+    #if OS_NOISE_EN
+        serverThreadVars->args.osNoise = initOsNoise(serverCore);
+    #else
+        serverThreadVars->args.osNoise = NULL;
+    #endif
+    #if FIFO_STALL_STATS_EN
+        serverThreadVars->args.stallStats = (fifo_stall_stats_t*) bufferArenaAlloc(sizeof(fifo_stall_stats_t), serverCore);
+    #else
+        serverThreadVars->args.stallStats = NULL;
+    #endif
+    #if FIFO_OCCUPANCY_EN
+        serverThreadVars->args.occupancy = initFifoOccupancy(serverCore);
+    #else
+        serverThreadVars->args.occupancy = NULL;
+    #endif
 
     //Set client arguments
     clientThreadVars->args.PartitionCrossingFIFO_readOffsetPtr_re = PartitionCrossingFIFO_readOffsetPtr_re;
@@ -176,53 +87,47 @@ fifo_runner_thread_vars_container_t* startThread(_Atomic int8_t* PartitionCrossi
     clientThreadVars->args.PartitionCrossingFIFO_arrayPtr_re = PartitionCrossingFIFO_arrayPtr_re;
     clientThreadVars->args.startTrigger = startTrigger;
     clientThreadVars->args.readyFlag = clientReadyFlag;
-
-    //Start threads
-    status = pthread_create(&(serverThreadVars->thread), &(serverThreadVars->attr), fifo_server_thread, &(serverThreadVars->args));
-    if (status != 0)
-    {
-        printf("Could not create a server thread ... exiting");
-        errno = status;
-        perror(NULL);
-        exit(1);
-    }
-    status = pthread_create(&(clientThreadVars->thread), &(clientThreadVars->attr), fifo_client_thread, &(clientThreadVars->args));
-    if (status != 0)
-    {
-        printf("Could not create a client thread ... exiting");
-        errno = status;
-        perror(NULL);
-        exit(1);
-    }
+    #if TIME_SERIES_EN
+        clientThreadVars->args.timeSeries = initTimeSeries(clientCore);
+    #else
+        clientThreadVars->args.timeSeries = NULL;
+    #endif
+    #if CPU_FREQ_EN
+        clientThreadVars->args.cpuFreq = initCpuFreq(clientCore);
+    #else
+        clientThreadVars->args.cpuFreq = NULL;
+    #endif
+    #if OS_NOISE_EN
+        clientThreadVars->args.osNoise = initOsNoise(clientCore);
+    #else
+        clientThreadVars->args.osNoise = NULL;
+    #endif
+    #if FIFO_STALL_STATS_EN
+        clientThreadVars->args.stallStats = (fifo_stall_stats_t*) bufferArenaAlloc(sizeof(fifo_stall_stats_t), clientCore);
+    #else
+        clientThreadVars->args.stallStats = NULL;
+    #endif
+    #if FIFO_OCCUPANCY_EN
+        clientThreadVars->args.occupancy = initFifoOccupancy(clientCore);
+    #else
+        clientThreadVars->args.occupancy = NULL;
+    #endif
+
+    //Start threads on the pinned SCHED_FIFO workers
+    workerPoolSubmit(serverCore, fifo_server_thread, &(serverThreadVars->args));
+    workerPoolSubmit(clientCore, fifo_client_thread, &(clientThreadVars->args));
 
     return threadVarContainer;
 }
 
 void collectResults(fifo_runner_thread_vars_container_t **threadVars, double *serverTimes, double *clientTimes, int numFIFOs){
     for(int i = 0; i<numFIFOs; i++){
-        int status;
-        void *serverResult;
-        status = pthread_join(threadVars[i]->serverVars->thread, &serverResult);
-        if (status != 0)
-        {
-            printf("Could not join a server thread ... exiting");
-            errno = status;
-            perror(NULL);
-            exit(1);
-        }
+        void *serverResult = workerPoolJoin(threadVars[i]->serverVars->core);
         double *serverResultCast = (double*) serverResult;
         serverTimes[i] = *serverResultCast;
         free(serverResult);
 
-        void *clientResult;
-        status = pthread_join(threadVars[i]->clientVars->thread, &clientResult);
-        if (status != 0)
-        {
-            printf("Could not join a client thread ... exiting");
-            errno = status;
-            perror(NULL);
-            exit(1);
-        }
+        void *clientResult = workerPoolJoin(threadVars[i]->clientVars->core);
         double *clientResultCast = (double*) clientResult;
         clientTimes[i] = *clientResultCast;
         free(clientResult);
@@ -230,23 +135,123 @@ void collectResults(fifo_runner_thread_vars_container_t **threadVars, double *se
 }
 
 void cleanupThreadVars(fifo_runner_thread_vars_container_t* vars){
-    free(vars->serverVars);
-    free(vars->clientVars);
+    cpuFreqClose(vars->serverVars->args.cpuFreq);
+    cpuFreqClose(vars->clientVars->args.cpuFreq);
+    bufferArenaFree(vars->serverVars->args.cpuFreq);
+    bufferArenaFree(vars->clientVars->args.cpuFreq);
+    bufferArenaFree(vars->serverVars->args.timeSeries);
+    bufferArenaFree(vars->clientVars->args.timeSeries);
+    bufferArenaFree(vars->serverVars->args.osNoise);
+    bufferArenaFree(vars->clientVars->args.osNoise);
+    bufferArenaFree(vars->serverVars->args.stallStats);
+    bufferArenaFree(vars->clientVars->args.stallStats);
+    bufferArenaFree(vars->serverVars->args.occupancy);
+    bufferArenaFree(vars->clientVars->args.occupancy);
+    bufferArenaFree(vars->serverVars);
+    bufferArenaFree(vars->clientVars);
     free(vars);
 }
 
-void writeResults(int *serverCPUs, int *clientCPUs, double *serverTimes, double *clientTimes, int numFIFOs, char* reportFilename){
+void writeResults(int *serverCPUs, int *clientCPUs, double *serverTimes, double *clientTimes, int numFIFOs, const char* cacheState,
+                  const fifo_report_stats_t *stats, char* reportFilename){
+    fifo_report_stats_t noStats = {NULL, NULL, NULL, NULL, NULL, NULL};
+    if(stats == NULL){
+        stats = &noStats;
+    }
+
     FILE *resultsFile = fopen(reportFilename, "w");
-    fprintf(resultsFile, "ServerCPU,ClientCPU,ServerTime,ClientTime,BytesTx,BytesRx\n");
+    fprintf(resultsFile, "ServerCPU,ClientCPU,ServerTime,ClientTime,BytesTx,BytesRx,CacheState,ServerGHz,ClientGHz,ServerCyclesPerByte,ClientCyclesPerByte,ServerFreqSource,ClientFreqSource,ServerGovernor,ClientGovernor,ServerBoost,ClientBoost,BlkLayout,BlkPorts,BlkPayloadBytes,SampleType,SamplesTx,ServerSamplesPerSec,ClientSamplesPerSec,ServerBytesPerSec,ClientBytesPerSec,StallStats,ServerWaitIters,ServerOffsetReloads,ServerWaitCycles,ServerCopyCycles,ServerPublishCycles,ClientWaitIters,ClientOffsetReloads,ClientWaitCycles,ClientCopyCycles,ClientPublishCycles,Level\n");
 
     long long int bytesSent = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    long long int samplesSent = TRANSACTIONS_BLKS*BLK_SAMPLES;
     for(int i = 0; i<numFIFOs; i++){
-        fprintf(resultsFile, "%d,%d,%e,%e,%lld,%lld\n", serverCPUs[i], clientCPUs[i], serverTimes[i], clientTimes[i], bytesSent, bytesSent);
+        cpu_freq_sample_t *serverFreq = stats->serverCpuFreq == NULL ? NULL : stats->serverCpuFreq[i];
+        cpu_freq_sample_t *clientFreq = stats->clientCpuFreq == NULL ? NULL : stats->clientCpuFreq[i];
+        fifo_stall_stats_t noStalls = {0, 0, 0, 0, 0};
+        fifo_stall_stats_t *serverStalls = stats->serverStallStats == NULL ? &noStalls : stats->serverStallStats[i];
+        fifo_stall_stats_t *clientStalls = stats->clientStallStats == NULL ? &noStalls : stats->clientStallStats[i];
+        fprintf(resultsFile, "%d,%d,%e,%e,%lld,%lld,%s,%e,%e,%e,%e,%s,%s,%s,%s,%s,%s,%s,%d,%lu,%s,%lld,%e,%e,%e,%e,%s,%ld,%ld,%lu,%lu,%lu,%ld,%ld,%lu,%lu,%lu,%s\n", serverCPUs[i], clientCPUs[i], serverTimes[i], clientTimes[i], bytesSent, bytesSent, cacheState,
+                cpuFreqEffectiveGHz(serverFreq, serverTimes[i]), cpuFreqEffectiveGHz(clientFreq, clientTimes[i]),
+                ((double) cpuFreqCycles(serverFreq))/bytesSent, ((double) cpuFreqCycles(clientFreq))/bytesSent,
+                getCpuFreqSourceName(serverFreq), getCpuFreqSourceName(clientFreq),
+                stats->serverCpuFreqSettings == NULL ? "NA" : stats->serverCpuFreqSettings[i].governor,
+                stats->clientCpuFreqSettings == NULL ? "NA" : stats->clientCpuFreqSettings[i].governor,
+                stats->serverCpuFreqSettings == NULL ? "NA" : stats->serverCpuFreqSettings[i].boost,
+                stats->clientCpuFreqSettings == NULL ? "NA" : stats->clientCpuFreqSettings[i].boost,
+                getFifoBlkLayoutName(), FIFO_BLK_PORTS, BLK_PAYLOAD_BYTES,
+                getFifoBlkSampleTypeName(), samplesSent, samplesSent/serverTimes[i], samplesSent/clientTimes[i], bytesSent/serverTimes[i], bytesSent/clientTimes[i],
+                stats->serverStallStats == NULL ? "NA" : "TSC",
+                serverStalls->waitIters, serverStalls->offsetReloads, serverStalls->waitCycles, serverStalls->copyCycles, serverStalls->publishCycles,
+                clientStalls->waitIters, clientStalls->offsetReloads, clientStalls->waitCycles, clientStalls->copyCycles, clientStalls->publishCycles,
+                getTopologyLevelName(getTopologyLevel(serverCPUs[i], clientCPUs[i])));
     }
 
     fclose(resultsFile);
 }
 
+void writeTimeSeriesResults(time_series_t **serverTimeSeries, time_series_t **clientTimeSeries, int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename){
+    char* timeSeriesFilename = genDerivedReportName(reportFilename, "_timeSeries");
+    char* summaryFilename = genDerivedReportName(reportFilename, "_timeSeriesSummary");
+    FILE *timeSeriesFile = fopen(timeSeriesFilename, "w");
+    FILE *summaryFile = fopen(summaryFilename, "w");
+    writeTimeSeriesHeader(timeSeriesFile, summaryFile);
+
+    for(int i = 0; i<numFIFOs; i++){
+        writeTimeSeries(timeSeriesFile, summaryFile, "Server", serverCPUs[i], serverTimeSeries[i], BLK_SIZE_BYTES);
+        writeTimeSeries(timeSeriesFile, summaryFile, "Client", clientCPUs[i], clientTimeSeries[i], BLK_SIZE_BYTES);
+    }
+
+    fclose(timeSeriesFile);
+    fclose(summaryFile);
+    free(timeSeriesFilename);
+    free(summaryFilename);
+}
+
+void writeOccupancyResults(fifo_occupancy_t **serverOccupancy, fifo_occupancy_t **clientOccupancy, int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename){
+    char* summaryFilename = genDerivedReportName(reportFilename, "_occupancy");
+    char* histFilename = genDerivedReportName(reportFilename, "_occupancyHist");
+    char* seriesFilename = genDerivedReportName(reportFilename, "_occupancySeries");
+    FILE *summaryFile = fopen(summaryFilename, "w");
+    FILE *histFile = fopen(histFilename, "w");
+    FILE *seriesFile = fopen(seriesFilename, "w");
+    writeFifoOccupancyHeader(summaryFile, histFile, seriesFile);
+
+    for(int i = 0; i<numFIFOs; i++){
+        writeFifoOccupancy(summaryFile, histFile, seriesFile, "Server", serverCPUs[i], clientCPUs[i], serverOccupancy[i]);
+        writeFifoOccupancy(summaryFile, histFile, seriesFile, "Client", serverCPUs[i], clientCPUs[i], clientOccupancy[i]);
+    }
+
+    fclose(summaryFile);
+    fclose(histFile);
+    fclose(seriesFile);
+    free(summaryFilename);
+    free(histFilename);
+    free(seriesFilename);
+}
+
+void writeOsNoiseResults(fifo_runner_thread_vars_container_t **threadVars, os_noise_irq_snapshot_t *irqsBefore, os_noise_irq_snapshot_t *irqsAfter,
+                         int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename){
+    char* summaryFilename = genDerivedReportName(reportFilename, "_osNoise");
+    char* gapFilename = genDerivedReportName(reportFilename, "_osNoiseGaps");
+    char* irqFilename = genDerivedReportName(reportFilename, "_osNoiseIrqs");
+    FILE *summaryFile = fopen(summaryFilename, "w");
+    FILE *gapFile = fopen(gapFilename, "w");
+    FILE *irqFile = fopen(irqFilename, "w");
+    writeOsNoiseHeader(summaryFile, gapFile, irqFile);
+
+    for(int i = 0; i<numFIFOs; i++){
+        writeOsNoise(summaryFile, gapFile, irqFile, "Server", serverCPUs[i], threadVars[i]->serverVars->args.osNoise, irqsBefore+i, irqsAfter+i);
+        writeOsNoise(summaryFile, gapFile, irqFile, "Client", clientCPUs[i], threadVars[i]->clientVars->args.osNoise, irqsBefore+numFIFOs+i, irqsAfter+numFIFOs+i);
+    }
+
+    fclose(summaryFile);
+    fclose(gapFile);
+    fclose(irqFile);
+    free(summaryFilename);
+    free(gapFilename);
+    free(irqFilename);
+}
+
 /**
  * @param serverCPUs a list of CPUs to serve as the server side of FIFOs.  Each server CPU is pared with a client CPU in clientCPUs
  * @param clientCPUs a list of CPUs to serve as the client side of FIFOs.  Each server CPU is pared with a server CPU in serverCPUs
@@ -254,6 +259,14 @@ void writeResults(int *serverCPUs, int *clientCPUs, double *serverTimes, double
  * @param reportFilename
  */
 void runLaminarFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename){
+    runLaminarFifoBenchTimes(serverCPUs, clientCPUs, numFIFOs, reportFilename, NULL, NULL);
+}
+
+/**
+ * Like runLaminarFifoBench but also returns the time of each thread
+ * @param serverTimesOut, clientTimesOut if not NULL, the time of each server/client thread is written here (size numFIFOs)
+ */
+void runLaminarFifoBenchTimes(int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename, double *serverTimesOut, double *clientTimesOut){
     //Create FIFOs (will allocate write ptr and array on server side)
     _Atomic int8_t* PartitionCrossingFIFO_readOffsetPtr_re[numFIFOs];
     _Atomic int8_t* PartitionCrossingFIFO_writeOffsetPtr_re[numFIFOs];
@@ -265,6 +278,24 @@ void runLaminarFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* r
         initFIFO(PartitionCrossingFIFO_readOffsetPtr_re+i, PartitionCrossingFIFO_writeOffsetPtr_re+i, PartitionCrossingFIFO_arrayPtr_re+i, serverReadyFlag+i, clientReadyFlag+i, serverCPUs[i], clientCPUs[i]);
     }
 
+    //Set the cache state of the FIFOs (see cacheState.h)
+    void* fifoBuffers[numFIFOs][3];
+    size_t fifoBufferSizes[3] = {sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1), sizeof(_Atomic int8_t), sizeof(_Atomic int8_t)};
+    for(int i = 0; i<numFIFOs; i++){
+        fifoBuffers[i][0] = PartitionCrossingFIFO_arrayPtr_re[i];
+        fifoBuffers[i][1] = PartitionCrossingFIFO_readOffsetPtr_re[i];
+        fifoBuffers[i][2] = PartitionCrossingFIFO_writeOffsetPtr_re[i];
+        cacheStateBeforeStart(fifoBuffers[i], fifoBufferSizes, 3, serverCPUs[i], clientCPUs[i]);
+    }
+
+    //Read the cpufreq settings before starting the test
+    cpu_freq_settings_t serverCpuFreqSettings[numFIFOs];
+    cpu_freq_settings_t clientCpuFreqSettings[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        readCpuFreqSettings(serverCPUs[i], serverCpuFreqSettings+i);
+        readCpuFreqSettings(clientCPUs[i], clientCpuFreqSettings+i);
+    }
+
     //Create starting trigger
     _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
     atomic_signal_fence(memory_order_acquire);
@@ -294,6 +325,19 @@ void runLaminarFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* r
         }
     }
 
+    for(int i = 0; i<numFIFOs; i++){
+        cacheStateBeforeTrigger(fifoBuffers[i], fifoBufferSizes, 3);
+    }
+
+    #if OS_NOISE_EN
+        os_noise_irq_snapshot_t *irqsBefore = (os_noise_irq_snapshot_t*) malloc(sizeof(os_noise_irq_snapshot_t)*2*numFIFOs);
+        os_noise_irq_snapshot_t *irqsAfter = (os_noise_irq_snapshot_t*) malloc(sizeof(os_noise_irq_snapshot_t)*2*numFIFOs);
+        for(int i = 0; i<numFIFOs; i++){
+            readOsNoiseIrqs(serverCPUs[i], irqsBefore+i);
+            readOsNoiseIrqs(clientCPUs[i], irqsBefore+numFIFOs+i);
+        }
+    #endif
+
     //Start FIFO transfers
     atomic_signal_fence(memory_order_acquire);
     atomic_store_explicit(startTrigger, true, memory_order_release);
@@ -302,9 +346,61 @@ void runLaminarFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* r
     double serverTimes[numFIFOs];
     double clientTimes[numFIFOs];
     collectResults(threadVars, serverTimes, clientTimes, numFIFOs);
+    for(int i = 0; i<numFIFOs; i++){
+        if(serverTimesOut != NULL){
+            serverTimesOut[i] = serverTimes[i];
+        }
+        if(clientTimesOut != NULL){
+            clientTimesOut[i] = clientTimes[i];
+        }
+    }
+
+    #if OS_NOISE_EN
+        for(int i = 0; i<numFIFOs; i++){
+            readOsNoiseIrqs(serverCPUs[i], irqsAfter+i);
+            readOsNoiseIrqs(clientCPUs[i], irqsAfter+numFIFOs+i);
+        }
+    #endif
 
     //Write results
-    writeResults(serverCPUs, clientCPUs, serverTimes, clientTimes, numFIFOs, reportFilename);
+    cpu_freq_sample_t *serverCpuFreq[numFIFOs];
+    cpu_freq_sample_t *clientCpuFreq[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        serverCpuFreq[i] = threadVars[i]->serverVars->args.cpuFreq;
+        clientCpuFreq[i] = threadVars[i]->clientVars->args.cpuFreq;
+    }
+    fifo_stall_stats_t *serverStallStats[numFIFOs];
+    fifo_stall_stats_t *clientStallStats[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        serverStallStats[i] = threadVars[i]->serverVars->args.stallStats;
+        clientStallStats[i] = threadVars[i]->clientVars->args.stallStats;
+    }
+    fifo_report_stats_t stats = {serverCpuFreq, clientCpuFreq, serverCpuFreqSettings, clientCpuFreqSettings,
+                                 FIFO_STALL_STATS_EN ? serverStallStats : NULL, FIFO_STALL_STATS_EN ? clientStallStats : NULL};
+    writeResults(serverCPUs, clientCPUs, serverTimes, clientTimes, numFIFOs, getCacheStateName(CACHE_STATE), &stats, reportFilename);
+    #if TIME_SERIES_EN
+        time_series_t *serverTimeSeries[numFIFOs];
+        time_series_t *clientTimeSeries[numFIFOs];
+        for(int i = 0; i<numFIFOs; i++){
+            serverTimeSeries[i] = threadVars[i]->serverVars->args.timeSeries;
+            clientTimeSeries[i] = threadVars[i]->clientVars->args.timeSeries;
+        }
+        writeTimeSeriesResults(serverTimeSeries, clientTimeSeries, serverCPUs, clientCPUs, numFIFOs, reportFilename);
+    #endif
+    #if FIFO_OCCUPANCY_EN
+        fifo_occupancy_t *serverOccupancy[numFIFOs];
+        fifo_occupancy_t *clientOccupancy[numFIFOs];
+        for(int i = 0; i<numFIFOs; i++){
+            serverOccupancy[i] = threadVars[i]->serverVars->args.occupancy;
+            clientOccupancy[i] = threadVars[i]->clientVars->args.occupancy;
+        }
+        writeOccupancyResults(serverOccupancy, clientOccupancy, serverCPUs, clientCPUs, numFIFOs, reportFilename);
+    #endif
+    #if OS_NOISE_EN
+        writeOsNoiseResults(threadVars, irqsBefore, irqsAfter, serverCPUs, clientCPUs, numFIFOs, reportFilename);
+        free(irqsBefore);
+        free(irqsAfter);
+    #endif
 
     //Cleanup
     for(int i = 0; i<numFIFOs; i++){
@@ -12,12 +12,10 @@
 #include <stdint.h>
 
 #include "laminarFifoCommon.h"
+#include "laminarFifo.h"
 
 typedef struct {
-    pthread_t thread;
-    pthread_attr_t attr;
-    struct sched_param threadParams;
-    cpu_set_t cpuset;
+    int core; //The worker pool core the thread runs on
     laminar_fifo_threadArgs_t args;
 } fifo_runner_thread_vars_t;
 
@@ -28,4 +26,46 @@ typedef struct {
 
 void runLaminarFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename);
 
+/**
+ * Like runLaminarFifoBench but also returns the time of each thread
+ * @param serverTimesOut, clientTimesOut if not NULL, the time of each server/client thread is written here (size numFIFOs)
+ */
+void runLaminarFifoBenchTimes(int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename, double *serverTimesOut, double *clientTimesOut);
+
+//The optional per-thread measurements of the report shared by the single producer single consumer FIFO benchmarks.
+//Each array has numFIFOs entries.  Any field may be NULL if it was not collected
+typedef struct {
+    cpu_freq_sample_t **serverCpuFreq; //The frequency samples of each thread (see cpuFreq.h)
+    cpu_freq_sample_t **clientCpuFreq;
+    cpu_freq_settings_t *serverCpuFreqSettings; //The cpufreq settings of each core when the test was started
+    cpu_freq_settings_t *clientCpuFreqSettings;
+    fifo_stall_stats_t **serverStallStats; //The stall counters of each thread (see FIFO_STALL_STATS_EN)
+    fifo_stall_stats_t **clientStallStats;
+} fifo_report_stats_t;
+
+/**
+ * Writes the report shared by all single producer single consumer FIFO benchmarks
+ * @param cacheState the name of the cache state the FIFOs were in when started (see cacheState.h)
+ * @param stats the optional per-thread measurements.  May be NULL if none were collected
+ */
+void writeResults(int *serverCPUs, int *clientCPUs, double *serverTimes, double *clientTimes, int numFIFOs, const char* cacheState,
+                  const fifo_report_stats_t *stats, char* reportFilename);
+
+/**
+ * Writes the time series reports (see timeSeries.h) shared by all single producer single consumer FIFO benchmarks
+ */
+void writeTimeSeriesResults(time_series_t **serverTimeSeries, time_series_t **clientTimeSeries, int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename);
+
+/**
+ * Writes the occupancy reports (see fifoOccupancy.h) of each FIFO as seen by its server and client
+ */
+void writeOccupancyResults(fifo_occupancy_t **serverOccupancy, fifo_occupancy_t **clientOccupancy, int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename);
+
+/**
+ * Writes the noise profile reports (see osNoise.h) of each server and client thread
+ * @param irqsBefore, irqsAfter the interrupt counts of each server core followed by each client core (2*numFIFOs entries)
+ */
+void writeOsNoiseResults(fifo_runner_thread_vars_container_t **threadVars, os_noise_irq_snapshot_t *irqsBefore, os_noise_irq_snapshot_t *irqsAfter,
+                         int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename);
+
 #endif
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "laminarFifoCommon.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
 #include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -17,6 +19,11 @@ void *fifo_server_thread(void* args){
     PartitionCrossingFIFO_t *PartitionCrossingFIFO_arrayPtr_re = args_cast->PartitionCrossingFIFO_arrayPtr_re;
     _Atomic bool *startTrigger = args_cast->startTrigger;
     atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+    cpu_freq_sample_t *cpuFreq = args_cast->cpuFreq;
+    os_noise_t *osNoise = args_cast->osNoise;
+    fifo_stall_stats_t *stallStats = args_cast->stallStats;
+    fifo_occupancy_t *occupancy = args_cast->occupancy;
 
     //==== Setup Output FIFOs ====
     int8_t PartitionCrossingFIFO_writeOffsetCached_re;
@@ -26,12 +33,11 @@ void *fifo_server_thread(void* args){
     PartitionCrossingFIFO_t PartitionCrossingFIFO_writeTmp;
 
     //==== Init write temp ====
-    for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){
-        PartitionCrossingFIFO_writeTmp.port0_real[i] = 0;
-    }
-    for(int i = 0; i<FIFO_BLK_SIZE_CPLX_FLOAT; i++){
-        PartitionCrossingFIFO_writeTmp.port0_imag[i] = 0;
-    }
+    initFifoBlk(&PartitionCrossingFIFO_writeTmp);
+
+    #if CPU_FREQ_EN
+        cpuFreqOpen(cpuFreq);
+    #endif
 
     //==== Signal Ready ====
     atomic_thread_fence(memory_order_acquire);
@@ -45,14 +51,38 @@ void *fifo_server_thread(void* args){
     }
 
     //==== Start Test ====
+    #if CPU_FREQ_EN
+        cpuFreqStart(cpuFreq);
+    #endif
+
     //Start timer
     timespec_t startTime;
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
     clock_gettime(CLOCK_MONOTONIC, &startTime);
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
 
+    #if OS_NOISE_EN
+        osNoiseStart(osNoise);
+    #endif
+
+    #if FIFO_STALL_STATS_EN
+        fifo_stall_stats_t stalls = {0, 0, 0, 0, 0};
+        uint64_t stallLastTSC = readTSC();
+    #endif
+
     //Run for specified number of itterations
     for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        #if FIFO_OCCUPANCY_EN
+            bool occupancyRecorded = false;
+        #endif
+
+        #if OS_NOISE_EN
+            osNoiseCheck(osNoise);
+        #endif
 
         //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
         asm volatile(""
@@ -65,24 +95,55 @@ void *fifo_server_thread(void* args){
         bool outputFIFOsReady = false;
         while (!outputFIFOsReady)
         {
+            #if OS_NOISE_EN
+                osNoiseCheck(osNoise);
+            #endif
             outputFIFOsReady = true;
             {
                 bool PartitionCrossingFIFO_notFull_re = (PartitionCrossingFIFO_readOffsetCached_re != PartitionCrossingFIFO_writeOffsetCached_re);
                 if (!(PartitionCrossingFIFO_notFull_re))
                 {
                     PartitionCrossingFIFO_readOffsetCached_re = atomic_load_explicit(PartitionCrossingFIFO_readOffsetPtr_re, memory_order_acquire);
+                    #if FIFO_STALL_STATS_EN
+                        stalls.offsetReloads++;
+                    #endif
+                    #if FIFO_OCCUPANCY_EN
+                        //Sample with the refreshed offset rather than the stale cached one
+                        if(!occupancyRecorded){
+                            fifoOccupancyRecord(occupancy, blksTransfered, PartitionCrossingFIFO_writeOffsetCached_re, PartitionCrossingFIFO_readOffsetCached_re);
+                            occupancyRecorded = true;
+                        }
+                    #endif
                     PartitionCrossingFIFO_notFull_re = (PartitionCrossingFIFO_readOffsetCached_re != PartitionCrossingFIFO_writeOffsetCached_re);
                 }
                 outputFIFOsReady &= PartitionCrossingFIFO_notFull_re;
             }
+            #if FIFO_STALL_STATS_EN
+                stalls.waitIters += !outputFIFOsReady;
+            #endif
         }
 
+        #if FIFO_OCCUPANCY_EN
+            //The cached offsets did not need to be refreshed
+            if(!occupancyRecorded){
+                fifoOccupancyRecord(occupancy, blksTransfered, PartitionCrossingFIFO_writeOffsetCached_re, PartitionCrossingFIFO_readOffsetCached_re);
+            }
+        #endif
+
+        #if FIFO_STALL_STATS_EN
+            fifoStallAccount(&stallLastTSC, &stalls.waitCycles);
+        #endif
+
         //Write output FIFO(s)
         //  --- Pulled from generated Laminar code (bool changed from vitisBool_t to bool)
         { //Begin Scope for PartitionCrossingFIFO FIFO Write
             int PartitionCrossingFIFO_writeOffsetPtr_re_local = PartitionCrossingFIFO_writeOffsetCached_re;
             //Write into array
-            __builtin_memcpy_inline(PartitionCrossingFIFO_arrayPtr_re + PartitionCrossingFIFO_writeOffsetPtr_re_local, &PartitionCrossingFIFO_writeTmp, sizeof(PartitionCrossingFIFO_t));
+            copyBlkToFifo(PartitionCrossingFIFO_arrayPtr_re + PartitionCrossingFIFO_writeOffsetPtr_re_local, &PartitionCrossingFIFO_writeTmp);
+            fifoProducerHint(PartitionCrossingFIFO_arrayPtr_re + PartitionCrossingFIFO_writeOffsetPtr_re_local);
+            #if FIFO_STALL_STATS_EN
+                fifoStallAccount(&stallLastTSC, &stalls.copyCycles);
+            #endif
             if (PartitionCrossingFIFO_writeOffsetPtr_re_local >= FIFO_LEN_BLKS)
             {
                 PartitionCrossingFIFO_writeOffsetPtr_re_local = 0;
@@ -94,14 +155,37 @@ void *fifo_server_thread(void* args){
             PartitionCrossingFIFO_writeOffsetCached_re = PartitionCrossingFIFO_writeOffsetPtr_re_local;
             //Update Write Ptr
             atomic_store_explicit(PartitionCrossingFIFO_writeOffsetPtr_re, PartitionCrossingFIFO_writeOffsetPtr_re_local, memory_order_release);
+            #if FIFO_STALL_STATS_EN
+                fifoStallAccount(&stallLastTSC, &stalls.publishCycles);
+            #endif
         } //End Scope for PartitionCrossingFIFO FIFO Write
     }
 
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    #if FIFO_OCCUPANCY_EN
+        fifoOccupancyRecordFinal(occupancy, TRANSACTIONS_BLKS);
+    #endif
+
+    #if OS_NOISE_EN
+        osNoiseStop(osNoise);
+    #endif
+
+    #if FIFO_STALL_STATS_EN
+        *stallStats = stalls;
+    #endif
+
     timespec_t stopTime;
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
     clock_gettime(CLOCK_MONOTONIC, &stopTime);
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
 
+    #if CPU_FREQ_EN
+        cpuFreqStop(cpuFreq);
+    #endif
+
     //Return results
     double* duration = malloc(sizeof(double));
     *duration = difftimespec(&stopTime, &startTime);
@@ -0,0 +1,200 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include "mcRingBufferFifo.h"
+#include "timeHelpers.h"
+#include "testParams.h"
+#include "bufferArena.h"
+
+static void* mc_ring_buffer_init(int serverCore, int clientCore){
+    mc_ring_buffer_fifo_t *fifo = (mc_ring_buffer_fifo_t*) bufferArenaAlloc(sizeof(mc_ring_buffer_fifo_t), serverCore);
+    fifo->read = (_Atomic int32_t*) bufferArenaAlloc(sizeof(_Atomic int32_t), clientCore);
+    fifo->write = (_Atomic int32_t*) bufferArenaAlloc(sizeof(_Atomic int32_t), serverCore);
+    fifo->array = (PartitionCrossingFIFO_t*) bufferArenaAlloc(sizeof(PartitionCrossingFIFO_t)*SPSC_FIFO_SLOTS, serverCore);
+
+    atomic_init(fifo->read, 0);
+    atomic_init(fifo->write, 0);
+    if(!atomic_is_lock_free(fifo->read)){
+        printf("Warning: A MCRingBuffer control variable was expected to be lock free but is not\n");
+    }
+
+    return fifo;
+}
+
+static void mc_ring_buffer_cleanup(void* fifo_uncast){
+    mc_ring_buffer_fifo_t *fifo = (mc_ring_buffer_fifo_t*) fifo_uncast;
+    bufferArenaFree(fifo->read);
+    bufferArenaFree(fifo->write);
+    bufferArenaFree(fifo->array);
+    bufferArenaFree(fifo);
+}
+
+static int mc_ring_buffer_get_buffers(void* fifo_uncast, void** buffers, size_t* sizes){
+    mc_ring_buffer_fifo_t *fifo = (mc_ring_buffer_fifo_t*) fifo_uncast;
+    buffers[0] = fifo->array;
+    sizes[0] = sizeof(PartitionCrossingFIFO_t)*SPSC_FIFO_SLOTS;
+    buffers[1] = fifo->read;
+    sizes[1] = sizeof(_Atomic int32_t);
+    buffers[2] = fifo->write;
+    sizes[2] = sizeof(_Atomic int32_t);
+    return 3;
+}
+
+static void *mc_ring_buffer_server_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    mc_ring_buffer_fifo_t *fifo = (mc_ring_buffer_fifo_t*) args_cast->fifo;
+    PartitionCrossingFIFO_t *array = fifo->array;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    //Producer local control variables
+    int32_t nextWrite = atomic_load_explicit(fifo->write, memory_order_acquire);
+    int32_t localRead = atomic_load_explicit(fifo->read, memory_order_acquire);
+    int wBatch = 0;
+    PartitionCrossingFIFO_t writeTmp;
+    memset(&writeTmp, 0, sizeof(PartitionCrossingFIFO_t));
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "=rm" (writeTmp)
+        : 
+        :);
+
+        //Wait for space, only re-reading the shared read index when the cached copy shows the FIFO as full
+        int32_t afterNextWrite = nextWrite >= SPSC_FIFO_SLOTS-1 ? 0 : nextWrite+1;
+        while(afterNextWrite == localRead){
+            localRead = atomic_load_explicit(fifo->read, memory_order_acquire);
+        }
+
+        copyBlkToFifo(array + nextWrite, &writeTmp);
+        nextWrite = afterNextWrite;
+
+        //Only publish the write index once per batch
+        wBatch++;
+        if(wBatch >= MC_RING_BUFFER_BATCH){
+            atomic_store_explicit(fifo->write, nextWrite, memory_order_release);
+            wBatch = 0;
+        }
+    }
+
+    //Publish any remaining blocks in a partial batch
+    atomic_store_explicit(fifo->write, nextWrite, memory_order_release);
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+static void *mc_ring_buffer_client_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    mc_ring_buffer_fifo_t *fifo = (mc_ring_buffer_fifo_t*) args_cast->fifo;
+    PartitionCrossingFIFO_t *array = fifo->array;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    //Consumer local control variables
+    int32_t nextRead = atomic_load_explicit(fifo->read, memory_order_acquire);
+    int32_t localWrite = atomic_load_explicit(fifo->write, memory_order_acquire);
+    int rBatch = 0;
+    PartitionCrossingFIFO_t readTmp;
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //Wait for data, only re-reading the shared write index when the cached copy shows the FIFO as empty
+        while(nextRead == localWrite){
+            localWrite = atomic_load_explicit(fifo->write, memory_order_acquire);
+        }
+
+        copyBlkFromFifo(&readTmp, array + nextRead);
+        nextRead = nextRead >= SPSC_FIFO_SLOTS-1 ? 0 : nextRead+1;
+
+        //Only publish the read index once per batch
+        rBatch++;
+        if(rBatch >= MC_RING_BUFFER_BATCH){
+            atomic_store_explicit(fifo->read, nextRead, memory_order_release);
+            rBatch = 0;
+        }
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        :
+        : "rm" (readTmp)
+        :);
+    }
+
+    //Publish any remaining blocks in a partial batch
+    atomic_store_explicit(fifo->read, nextRead, memory_order_release);
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+const spsc_fifo_impl_t MC_RING_BUFFER_FIFO_IMPL = {
+    .name = "mcRingBuffer",
+    .init = mc_ring_buffer_init,
+    .cleanup = mc_ring_buffer_cleanup,
+    .getBuffers = mc_ring_buffer_get_buffers,
+    .server_thread = mc_ring_buffer_server_thread,
+    .client_thread = mc_ring_buffer_client_thread
+};
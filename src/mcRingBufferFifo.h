@@ -0,0 +1,29 @@
+#ifndef _MC_RING_BUFFER_FIFO_H
+#define _MC_RING_BUFFER_FIFO_H
+
+#include "spscFifoCommon.h"
+#include "testParams.h"
+
+/*
+ * MCRingBuffer (Lee et al., ANCS 2009)
+ * Shared read and write indices (control variables) on seperate cache lines.  Each side keeps a local copy of its own index
+ * and a cached copy of the other side's index.  The shared index is only updated once every MC_RING_BUFFER_BATCH_BLKS blocks
+ */
+
+#ifndef MC_RING_BUFFER_BATCH_BLKS
+    #define MC_RING_BUFFER_BATCH_BLKS (8)
+#endif
+
+//Each side can hold back up to batch-1 index updates.  To avoid both sides waiting on each other's unpublished updates, 2*(batch-1) < FIFO_LEN_BLKS
+#define MC_RING_BUFFER_BATCH_MAX ((FIFO_LEN_BLKS+1)/2)
+#define MC_RING_BUFFER_BATCH (MC_RING_BUFFER_BATCH_BLKS < MC_RING_BUFFER_BATCH_MAX ? MC_RING_BUFFER_BATCH_BLKS : MC_RING_BUFFER_BATCH_MAX)
+
+typedef struct {
+    _Atomic int32_t *read; //Allocated on the client core
+    _Atomic int32_t *write; //Allocated on the server core
+    PartitionCrossingFIFO_t *array; //SPSC_FIFO_SLOTS, allocated on the server core
+} mc_ring_buffer_fifo_t;
+
+extern const spsc_fifo_impl_t MC_RING_BUFFER_FIFO_IMPL;
+
+#endif
@@ -2,6 +2,9 @@
 #define _MEMORY_COMMON_H
 
 #include "laminarFifoCommon.h"
+#include "timeSeries.h"
+#include "cpuFreq.h"
+#include "osNoise.h"
 
 //For Ryzen, there is a 32 KByte L1 Cache, a 512 KByte L2 Cache, and a shared 4 or 16 Mbyte L3 victim cache
 
@@ -16,6 +19,9 @@ typedef struct {
     PartitionCrossingFIFO_t *buffer; //Will read/write into this
     _Atomic bool *startTrigger; //This is shared by all threads
     atomic_flag *readyFlag; //This is unique to each thread
+    time_series_t *timeSeries; //This is unique to each thread.  Only used if TIME_SERIES_EN
+    cpu_freq_sample_t *cpuFreq; //This is unique to each thread.  Only used if CPU_FREQ_EN (may be NULL)
+    os_noise_t *osNoise; //This is unique to each thread.  Only used if OS_NOISE_EN
 } memory_threadArgs_t;
 
 #endif
\ No newline at end of file
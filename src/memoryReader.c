@@ -8,8 +8,10 @@
 #include <string.h>
 #include "timeHelpers.h"
 #include "testParams.h"
+#include "bufferArena.h"
 
-//Initializes a segment of memory pointed to by writeBuffer before the benchmark starts
+//Initializes a segment of memory pointed to by buffer before the benchmark starts.  The buffer may be reused from the buffer arena
+//(see bufferArena.h) so it is re-touched here to leave it in the same cache state as a freshly allocated buffer (unless ARENA_COLD_CACHE)
 //Durring benchmark reads from readBuffer into a temporary.  This operation is timed
 void *memory_reader_thread(void* args){
     memory_threadArgs_t *args_cast = (memory_threadArgs_t *)args;
@@ -18,23 +20,30 @@ void *memory_reader_thread(void* args){
     PartitionCrossingFIFO_t *buffer = args_cast->buffer;
     _Atomic bool *startTrigger = args_cast->startTrigger;
     atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+    cpu_freq_sample_t *cpuFreq = args_cast->cpuFreq;
+    os_noise_t *osNoise = args_cast->osNoise;
 
     //==== Setup Temporary for reading  ====
     PartitionCrossingFIFO_t readTmp;
-
-    //==== Init Write Array ====
-    for(int i = 0; i<MEMORY_ARRAY_SIZE_BLKS; i++){
-        for(int j = 0; j<FIFO_BLK_SIZE_CPLX_FLOAT; j++){
-            buffer[i].port0_real[j] = 0;
-        }
-        for(int j = 0; j<FIFO_BLK_SIZE_CPLX_FLOAT; j++){
-            buffer[i].port0_imag[j] = 0;
+    #if FIFO_BLK_CONSUME
+        fifo_sample_acc_t consumeAcc = 0;
+    #endif
+
+    //==== Init Array ====
+    #if !ARENA_COLD_CACHE
+        for(int i = 0; i<MEMORY_ARRAY_SIZE_BLKS; i++){
+            initFifoBlk(buffer+i);
         }
-    }
+    #endif
 
     //==== Set initial read location =====
     int bufferIdx = 0;
 
+    #if CPU_FREQ_EN
+        cpuFreqOpen(cpuFreq);
+    #endif
+
     //==== Signal Ready ====
     atomic_thread_fence(memory_order_acquire);
     atomic_flag_clear_explicit(readyFlag, memory_order_release);
@@ -47,14 +56,29 @@ void *memory_reader_thread(void* args){
     }
 
     //==== Start Test ====
+    #if CPU_FREQ_EN
+        cpuFreqStart(cpuFreq);
+    #endif
+
     //Start timer
     timespec_t startTime;
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
     clock_gettime(CLOCK_MONOTONIC, &startTime);
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
 
+    #if OS_NOISE_EN
+        osNoiseStart(osNoise);
+    #endif
+
     //Run for specified number of itterations
     for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        #if OS_NOISE_EN
+            osNoiseCheck(osNoise);
+        #endif
 
         //Since this is not a FIFO transfer, there is no need for checking pointers or for atomic read/writes with aquire/release ordering
 
@@ -68,6 +92,10 @@ void *memory_reader_thread(void* args){
         //Increment the ptr position or wrap
         bufferIdx = bufferIdx<(MEMORY_ARRAY_SIZE_BLKS-1) ? bufferIdx+1 : 0;
 
+        #if FIFO_BLK_CONSUME
+            consumeAcc += consumeFifoBlk(&readTmp);
+        #endif
+
         //Need to make sure that the memory copy is not optimized out if the content is not checked
         asm volatile(""
         :
@@ -75,11 +103,31 @@ void *memory_reader_thread(void* args){
         :);
     }
 
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    #if OS_NOISE_EN
+        osNoiseStop(osNoise);
+    #endif
+
+    #if FIFO_BLK_CONSUME
+        //Need to make sure that the consumer is not optimized out
+        asm volatile(""
+        :
+        : "rm" (consumeAcc)
+        :);
+    #endif
+
     timespec_t stopTime;
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
     clock_gettime(CLOCK_MONOTONIC, &stopTime);
     asm volatile("" ::: "memory"); //Stop Re-ordering of timer
 
+    #if CPU_FREQ_EN
+        cpuFreqStop(cpuFreq);
+    #endif
+
     //Return results
     double* duration = malloc(sizeof(double));
     *duration = difftimespec(&stopTime, &startTime);
@@ -10,33 +10,34 @@
 #include "memoryReader.h"
 #include "errno.h"
 #include "vitisNumaAllocHelpers.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "timeSeries.h"
+#include "reportHelpers.h"
+#include "cacheState.h"
+#include "cpuFreq.h"
+#include "osNoise.h"
+#include "topologyHelpers.h"
 
 void initMemoryBuffer(PartitionCrossingFIFO_t** buffer_arrayPtr_re, 
                 atomic_flag **readyFlag, 
-                int core){
-    *buffer_arrayPtr_re = (PartitionCrossingFIFO_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, MEMORY_ARRAY_SIZE_BYTES, core);
+                int core,
+                int bufferCore){
+    //Buffers come from the arena and are reused between tests.  The buffer is zeroed on bufferCore when first allocated (and re-zeroed if ARENA_COLD_CACHE)
+    //which places it in bufferCore's NUMA node.  The memory threads re-touch it on the measuring core before signalling ready (see memoryReader.c)
+    *buffer_arrayPtr_re = (PartitionCrossingFIFO_t*) bufferArenaAlloc(MEMORY_ARRAY_SIZE_BYTES, bufferCore);
 
-    *readyFlag = (atomic_flag*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(atomic_flag), core);
+    *readyFlag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), core);
 
     //Init Flags
     atomic_signal_fence(memory_order_acquire);
     atomic_flag_clear_explicit(*readyFlag, memory_order_release); //Init since this was malloc-ed
     atomic_flag_test_and_set_explicit(*readyFlag, memory_order_acq_rel);
-
-    //Init array
-    for(int i = 0; i<FIFO_LEN_BLKS+1; i++){
-        for(int j = 0; j<FIFO_BLK_SIZE_CPLX_FLOAT; j++){
-            (*buffer_arrayPtr_re)[i].port0_real[j]=0;
-        }
-        for(int j = 0; j<FIFO_BLK_SIZE_CPLX_FLOAT; j++){
-            (*buffer_arrayPtr_re)[i].port0_imag[j]=0;
-        }
-    }
 }
 
 void cleanupMemoryBuffer(PartitionCrossingFIFO_t* buffer_arrayPtr_re, atomic_flag *readyFlag){
-    free(buffer_arrayPtr_re);
-    free(readyFlag);
+    bufferArenaFree(buffer_arrayPtr_re);
+    bufferArenaFree(readyFlag);
 }
 
 memory_runner_thread_vars_t* startMemoryThread(PartitionCrossingFIFO_t* buffer_arrayPtr_re,
@@ -45,64 +46,31 @@ memory_runner_thread_vars_t* startMemoryThread(PartitionCrossingFIFO_t* buffer_a
                                                int core,
                                                void* (*memory_thread_fun)(void*)){
     //Allocate: fifo_runner_thread_vars_t
-    memory_runner_thread_vars_t *readerThreadVars = (memory_runner_thread_vars_t*) vitis_aligned_alloc_core(VITIS_MEM_ALIGNMENT, sizeof(memory_runner_thread_vars_t), core);
-
-    int status;
-    status = pthread_attr_init(&(readerThreadVars->attr));
-    if (status != 0)
-    {
-        printf("Could not create server pthread attributes ... exiting");
-        exit(1);
-    }
-
-    //Set partition to run with SCHED_FIFO RT Scheduler with Max Priority
-    //NOTE! This can lock up the computer if this thread is run on a CPU where system tasks are running.
-    status = pthread_attr_setinheritsched(&(readerThreadVars->attr), PTHREAD_EXPLICIT_SCHED);
-    if (status != 0)
-    {
-        printf("Could not set server pthread explicit schedule attribute ... exiting\n");
-        exit(1);
-    }
-
-    status = pthread_attr_setschedpolicy(&(readerThreadVars->attr), SCHED_FIFO);
-    if (status != 0)
-    {
-        printf("Could not set server pthread schedule policy to SCHED_FIFO ... exiting\n");
-        exit(1);
-    }
-
-    readerThreadVars->threadParams.sched_priority = sched_get_priority_max(SCHED_FIFO);
-    status = pthread_attr_setschedparam(&(readerThreadVars->attr), &(readerThreadVars->threadParams));
-    if (status != 0)
-    {
-        printf("Could not set server pthread schedule parameter ... exiting\n");
-        exit(1);
-    }
-
-    //Set server partition to run on specified CPU
-    CPU_ZERO(&(readerThreadVars->cpuset));                                                                           //Clear cpuset
-    CPU_SET(core, &(readerThreadVars->cpuset));                                                          //Add CPU to cpuset
-    status = pthread_attr_setaffinity_np(&(readerThreadVars->attr), sizeof(cpu_set_t), &(readerThreadVars->cpuset)); //Set thread CPU affinity
-    if (status != 0)
-    {
-        printf("Could not set server thread core affinity ... exiting");
-        exit(1);
-    }
+    memory_runner_thread_vars_t *readerThreadVars = (memory_runner_thread_vars_t*) bufferArenaAlloc(sizeof(memory_runner_thread_vars_t), core);
+    readerThreadVars->core = core;
 
     //Set server arguments
     readerThreadVars->args.buffer = buffer_arrayPtr_re;
     readerThreadVars->args.startTrigger = startTrigger;
     readerThreadVars->args.readyFlag = readyFlag;
+    #if TIME_SERIES_EN
+        readerThreadVars->args.timeSeries = initTimeSeries(core);
+    #else
+        readerThreadVars->args.timeSeries = NULL;
+    #endif
+    #if CPU_FREQ_EN
+        readerThreadVars->args.cpuFreq = initCpuFreq(core);
+    #else
+        readerThreadVars->args.cpuFreq = NULL;
+    #endif
+    #if OS_NOISE_EN
+        readerThreadVars->args.osNoise = initOsNoise(core);
+    #else
+        readerThreadVars->args.osNoise = NULL;
+    #endif
 
-    //Start threads
-    status = pthread_create(&(readerThreadVars->thread), &(readerThreadVars->attr), memory_thread_fun, &(readerThreadVars->args));
-    if (status != 0)
-    {
-        printf("Could not create a server thread ... exiting");
-        errno = status;
-        perror(NULL);
-        exit(1);
-    }
+    //Start thread on the pinned SCHED_FIFO worker
+    workerPoolSubmit(core, memory_thread_fun, &(readerThreadVars->args));
 
     return readerThreadVars;
 }
@@ -116,16 +84,7 @@ memory_runner_thread_vars_t* startMemoryReaderThread(PartitionCrossingFIFO_t* bu
 
 void collectResultsMemory(memory_runner_thread_vars_t **threadVars, double *memoryTimes, int numFIFOs){
     for(int i = 0; i<numFIFOs; i++){
-        int status;
-        void *memoryResult;
-        status = pthread_join(threadVars[i]->thread, &memoryResult);
-        if (status != 0)
-        {
-            printf("Could not join a server thread ... exiting");
-            errno = status;
-            perror(NULL);
-            exit(1);
-        }
+        void *memoryResult = workerPoolJoin(threadVars[i]->core);
         double *memoryResultCast = (double*) memoryResult;
         memoryTimes[i] = *memoryResultCast;
         free(memoryResultCast);
@@ -133,34 +92,107 @@ void collectResultsMemory(memory_runner_thread_vars_t **threadVars, double *memo
 }
 
 void cleanupMemoryThreadVars(memory_runner_thread_vars_t* vars){
-    free(vars);
+    cpuFreqClose(vars->args.cpuFreq);
+    bufferArenaFree(vars->args.cpuFreq);
+    bufferArenaFree(vars->args.timeSeries);
+    bufferArenaFree(vars->args.osNoise);
+    bufferArenaFree(vars);
 }
 
-void writeMemoryResults(int *cpus, double *memoryTimes, int numFIFOs, char* reportFilename){
+void writeMemoryResults(int *cpus, int *bufferCPUs, double *memoryTimes, memory_runner_thread_vars_t **threadVars, cpu_freq_settings_t *cpuFreqSettings, int numFIFOs, char* reportFilename){
     FILE *resultsFile = fopen(reportFilename, "w");
-    fprintf(resultsFile, "CPU,MemoryTime,BytesTransacted,MemArrayBytes\n");
+    fprintf(resultsFile, "CPU,MemoryTime,BytesTransacted,MemArrayBytes,CacheState,GHz,CyclesPerByte,FreqSource,Governor,Boost,BlkLayout,BlkPorts,BlkPayloadBytes,SampleType,SamplesTransacted,SamplesPerSec,BytesPerSec,BufferCPU,Level\n");
 
     long long int bytesTransacted = TRANSACTIONS_BLKS*BLK_SIZE_BYTES;
+    long long int samplesTransacted = TRANSACTIONS_BLKS*BLK_SAMPLES;
     long long int memArrayBytes = MEMORY_ARRAY_SIZE_BYTES;
     for(int i = 0; i<numFIFOs; i++){
-        fprintf(resultsFile, "%d,%e,%lld,%lld\n", cpus[i], memoryTimes[i], bytesTransacted, memArrayBytes);
+        cpu_freq_sample_t *cpuFreq = threadVars[i]->args.cpuFreq;
+        fprintf(resultsFile, "%d,%e,%lld,%lld,%s,%e,%e,%s,%s,%s,%s,%d,%lu,%s,%lld,%e,%e,%d,%s\n", cpus[i], memoryTimes[i], bytesTransacted, memArrayBytes, getCacheStateName(CACHE_STATE),
+                cpuFreqEffectiveGHz(cpuFreq, memoryTimes[i]), ((double) cpuFreqCycles(cpuFreq))/bytesTransacted, getCpuFreqSourceName(cpuFreq),
+                cpuFreqSettings[i].governor, cpuFreqSettings[i].boost, getFifoBlkLayoutName(), FIFO_BLK_PORTS, BLK_PAYLOAD_BYTES,
+                getFifoBlkSampleTypeName(), samplesTransacted, samplesTransacted/memoryTimes[i], bytesTransacted/memoryTimes[i],
+                bufferCPUs[i], getTopologyLevelName(getTopologyLevel(cpus[i], bufferCPUs[i])));
     }
 
     fclose(resultsFile);
 }
 
+void writeMemoryTimeSeriesResults(memory_runner_thread_vars_t **threadVars, int *cpus, int numFIFOs, char* reportFilename){
+    char* timeSeriesFilename = genDerivedReportName(reportFilename, "_timeSeries");
+    char* summaryFilename = genDerivedReportName(reportFilename, "_timeSeriesSummary");
+    FILE *timeSeriesFile = fopen(timeSeriesFilename, "w");
+    FILE *summaryFile = fopen(summaryFilename, "w");
+    writeTimeSeriesHeader(timeSeriesFile, summaryFile);
+
+    for(int i = 0; i<numFIFOs; i++){
+        writeTimeSeries(timeSeriesFile, summaryFile, "Memory", cpus[i], threadVars[i]->args.timeSeries, BLK_SIZE_BYTES);
+    }
+
+    fclose(timeSeriesFile);
+    fclose(summaryFile);
+    free(timeSeriesFilename);
+    free(summaryFilename);
+}
+
+void writeMemoryOsNoiseResults(memory_runner_thread_vars_t **threadVars, os_noise_irq_snapshot_t *irqsBefore, os_noise_irq_snapshot_t *irqsAfter, int *cpus, int numFIFOs, char* reportFilename){
+    char* summaryFilename = genDerivedReportName(reportFilename, "_osNoise");
+    char* gapFilename = genDerivedReportName(reportFilename, "_osNoiseGaps");
+    char* irqFilename = genDerivedReportName(reportFilename, "_osNoiseIrqs");
+    FILE *summaryFile = fopen(summaryFilename, "w");
+    FILE *gapFile = fopen(gapFilename, "w");
+    FILE *irqFile = fopen(irqFilename, "w");
+    writeOsNoiseHeader(summaryFile, gapFile, irqFile);
+
+    for(int i = 0; i<numFIFOs; i++){
+        writeOsNoise(summaryFile, gapFile, irqFile, "Memory", cpus[i], threadVars[i]->args.osNoise, irqsBefore+i, irqsAfter+i);
+    }
+
+    fclose(summaryFile);
+    fclose(gapFile);
+    fclose(irqFile);
+    free(summaryFilename);
+    free(gapFilename);
+    free(irqFilename);
+}
+
 /**
  * @param serverCPUs a list of CPUs to run the memory test
  * @param numFIFOs the number of FIFOs (also the size of serverCPUs and clientCPUs)
  * @param reportFilename
  */
 void runMemoryBench(int *cpus, int numFIFOs, char* reportFilename, void* (*memory_thread_fun)(void*)){
+    runMemoryBenchPlaced(cpus, cpus, numFIFOs, reportFilename, memory_thread_fun);
+}
+
+/**
+ * @param cpus a list of CPUs to run the memory test
+ * @param bufferCPUs the buffer of each CPU in cpus is allocated (and first touched) on the corresponding CPU in bufferCPUs
+ * @param numFIFOs the number of FIFOs (also the size of cpus and bufferCPUs)
+ * @param reportFilename
+ */
+void runMemoryBenchPlaced(int *cpus, int *bufferCPUs, int numFIFOs, char* reportFilename, void* (*memory_thread_fun)(void*)){
     //Create buffers
     PartitionCrossingFIFO_t* buffers[numFIFOs];
     atomic_flag *readyFlags[numFIFOs];
 
     for(int i = 0; i<numFIFOs; i++){
-        initMemoryBuffer(buffers+i, readyFlags+i, cpus[i]);
+        initMemoryBuffer(buffers+i, readyFlags+i, cpus[i], bufferCPUs[i]);
+    }
+
+    //Set the cache state of the buffers (see cacheState.h)
+    void* memBuffers[numFIFOs];
+    size_t memBufferSizes[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        memBuffers[i] = buffers[i];
+        memBufferSizes[i] = MEMORY_ARRAY_SIZE_BYTES;
+        cacheStateBeforeStart(memBuffers+i, memBufferSizes+i, 1, bufferCPUs[i], cpus[i]);
+    }
+
+    //Read the cpufreq settings before starting the test
+    cpu_freq_settings_t cpuFreqSettings[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        readCpuFreqSettings(cpus[i], cpuFreqSettings+i);
     }
 
     //Create starting trigger
@@ -182,6 +214,16 @@ void runMemoryBench(int *cpus, int numFIFOs, char* reportFilename, void* (*memor
         }
     }
 
+    cacheStateBeforeTrigger(memBuffers, memBufferSizes, numFIFOs);
+
+    #if OS_NOISE_EN
+        os_noise_irq_snapshot_t *irqsBefore = (os_noise_irq_snapshot_t*) malloc(sizeof(os_noise_irq_snapshot_t)*numFIFOs);
+        os_noise_irq_snapshot_t *irqsAfter = (os_noise_irq_snapshot_t*) malloc(sizeof(os_noise_irq_snapshot_t)*numFIFOs);
+        for(int i = 0; i<numFIFOs; i++){
+            readOsNoiseIrqs(cpus[i], irqsBefore+i);
+        }
+    #endif
+
     //Start FIFO transfers
     atomic_signal_fence(memory_order_acquire);
     atomic_store_explicit(startTrigger, true, memory_order_release);
@@ -190,8 +232,22 @@ void runMemoryBench(int *cpus, int numFIFOs, char* reportFilename, void* (*memor
     double memoryTimes[numFIFOs];
     collectResultsMemory(threadVars, memoryTimes, numFIFOs);
 
+    #if OS_NOISE_EN
+        for(int i = 0; i<numFIFOs; i++){
+            readOsNoiseIrqs(cpus[i], irqsAfter+i);
+        }
+    #endif
+
     //Write results
-    writeMemoryResults(cpus, memoryTimes, numFIFOs, reportFilename);
+    writeMemoryResults(cpus, bufferCPUs, memoryTimes, threadVars, cpuFreqSettings, numFIFOs, reportFilename);
+    #if TIME_SERIES_EN
+        writeMemoryTimeSeriesResults(threadVars, cpus, numFIFOs, reportFilename);
+    #endif
+    #if OS_NOISE_EN
+        writeMemoryOsNoiseResults(threadVars, irqsBefore, irqsAfter, cpus, numFIFOs, reportFilename);
+        free(irqsBefore);
+        free(irqsAfter);
+    #endif
 
     //Cleanup
     for(int i = 0; i<numFIFOs; i++){
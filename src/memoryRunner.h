@@ -14,13 +14,16 @@
 #include "memoryCommon.h"
 
 typedef struct {
-    pthread_t thread;
-    pthread_attr_t attr;
-    struct sched_param threadParams;
-    cpu_set_t cpuset;
+    int core; //The worker pool core the thread runs on
     memory_threadArgs_t args;
 } memory_runner_thread_vars_t;
 
 void runMemoryBench(int *cpus, int numFIFOs, char* reportFilename, void* (*memory_thread_fun)(void*));
 
+/**
+ * Like runMemoryBench but the buffer of each CPU is placed on (allocated and first touched by) a different CPU.  Used to measure
+ * the cost of accessing memory homed at each topology level (ex. a remote NUMA node)
+ */
+void runMemoryBenchPlaced(int *cpus, int *bufferCPUs, int numFIFOs, char* reportFilename, void* (*memory_thread_fun)(void*));
+
 #endif
\ No newline at end of file
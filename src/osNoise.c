@@ -0,0 +1,201 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE //For getline and clock_gettime
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "osNoise.h"
+#include "bufferArena.h"
+
+os_noise_t* initOsNoise(int core){
+    //The arena touches the log when it is first allocated so that page faults do not occur durring the timed region
+    os_noise_t* noise = (os_noise_t*) bufferArenaAlloc(sizeof(os_noise_t), core);
+    noise->thresholdTSC = (uint64_t) (OS_NOISE_THRESHOLD_NS*1.0e-9*getTSCFreqHz());
+    noise->startTSC = 0;
+    noise->lastTSC = 0;
+    noise->numGaps = 0;
+    noise->totalGapTSC = 0;
+    noise->maxGapTSC = 0;
+    return noise;
+}
+
+/**
+ * Copies src into dst (of size dstLen), collapsing runs of whitespace into a single space and replacing commas (the report is a CSV)
+ */
+static void copyIrqDesc(char* dst, int dstLen, const char* src){
+    int len = 0;
+    bool lastSpace = true; //Also trims leading whitespace
+    for(; *src != '\0' && len<dstLen-1; src++){
+        if(isspace((unsigned char) *src)){
+            if(!lastSpace){
+                dst[len++] = ' ';
+            }
+            lastSpace = true;
+        }else{
+            dst[len++] = *src == ',' ? ';' : *src;
+            lastSpace = false;
+        }
+    }
+    if(len>0 && dst[len-1] == ' '){
+        len--;
+    }
+    dst[len] = '\0';
+}
+
+void readOsNoiseIrqs(int cpu, os_noise_irq_snapshot_t* snapshot){
+    snapshot->cpu = cpu;
+    snapshot->numIrqs = 0;
+
+    FILE* interruptsFile = fopen("/proc/interrupts", "r");
+    if(interruptsFile == NULL){
+        return;
+    }
+
+    char* line = NULL;
+    size_t lineLen = 0;
+
+    //The header lists the online CPUs (which may not be contiguous).  Find the column of this CPU
+    int column = -1;
+    if(getline(&line, &lineLen, interruptsFile) > 0){
+        char cpuName[16];
+        snprintf(cpuName, sizeof(cpuName), "CPU%d", cpu);
+        int col = 0;
+        for(char* tok = strtok(line, " \t\n"); tok != NULL; tok = strtok(NULL, " \t\n"), col++){
+            if(strcmp(tok, cpuName) == 0){
+                column = col;
+                break;
+            }
+        }
+    }
+
+    while(column >= 0 && snapshot->numIrqs < OS_NOISE_MAX_IRQS && getline(&line, &lineLen, interruptsFile) > 0){
+        char* colon = strchr(line, ':');
+        if(colon == NULL){
+            continue;
+        }
+        *colon = '\0';
+
+        //Some sources (ex. ERR, MIS) have a single count rather than one per CPU
+        char* pos = colon+1;
+        bool found = false;
+        uint64_t count = 0;
+        for(int col = 0; ; col++){
+            char* end;
+            uint64_t val = strtoull(pos, &end, 10);
+            if(end == pos){
+                break;
+            }
+            pos = end;
+            if(col == column){
+                count = val;
+                found = true;
+            }
+        }
+
+        if(found){
+            os_noise_irq_t* irq = snapshot->irqs + snapshot->numIrqs;
+            copyIrqDesc(irq->name, sizeof(irq->name), line);
+            copyIrqDesc(irq->desc, sizeof(irq->desc), pos);
+            irq->count = count;
+            snapshot->numIrqs++;
+        }
+    }
+
+    free(line);
+    fclose(interruptsFile);
+}
+
+void writeOsNoiseHeader(FILE* summaryFile, FILE* gapFile, FILE* irqFile){
+    fprintf(summaryFile, "Role,CPU,ThresholdNs,Duration,Gaps,LoggedGaps,TotalGapNs,MaxGapNs,MeanGapNs,GapFraction,GapsPerSec,Interrupts,TopIrq,TopIrqCount\n");
+    fprintf(gapFile, "Role,CPU,Gap,StartNs,DurationNs\n");
+    fprintf(irqFile, "Role,CPU,Irq,Description,Count\n");
+}
+
+void writeOsNoise(FILE* summaryFile, FILE* gapFile, FILE* irqFile, const char* role, int cpu, os_noise_t *noise,
+                  os_noise_irq_snapshot_t *irqsBefore, os_noise_irq_snapshot_t *irqsAfter){
+    double tscFreqHz = getTSCFreqHz();
+
+    int64_t loggedGaps = noise->numGaps < OS_NOISE_MAX_GAPS ? noise->numGaps : OS_NOISE_MAX_GAPS;
+    for(int64_t gap = 0; gap<loggedGaps; gap++){
+        fprintf(gapFile, "%s,%d,%ld,%e,%e\n", role, cpu, gap, (noise->gapStartTSC[gap]-noise->startTSC)/tscFreqHz*1.0e9,
+                noise->gapDurationTSC[gap]/tscFreqHz*1.0e9);
+    }
+
+    //The sources are matched by name since a source may be added between the snapshots
+    uint64_t totalIrqs = 0;
+    uint64_t topIrqCount = 0;
+    const char* topIrq = "NA";
+    for(int i = 0; i<irqsAfter->numIrqs; i++){
+        os_noise_irq_t* after = irqsAfter->irqs+i;
+        uint64_t before = 0;
+        for(int j = 0; j<irqsBefore->numIrqs; j++){
+            int idx = (i+j) % irqsBefore->numIrqs; //Usually at the same index
+            if(strcmp(irqsBefore->irqs[idx].name, after->name) == 0){
+                before = irqsBefore->irqs[idx].count;
+                break;
+            }
+        }
+
+        uint64_t delta = after->count > before ? after->count - before : 0;
+        if(delta > 0){
+            fprintf(irqFile, "%s,%d,%s,%s,%lu\n", role, cpu, after->name, after->desc, delta);
+            totalIrqs += delta;
+            if(delta > topIrqCount){
+                topIrqCount = delta;
+                topIrq = after->name;
+            }
+        }
+    }
+
+    double duration = (noise->lastTSC-noise->startTSC)/tscFreqHz;
+    double totalGapNs = noise->totalGapTSC/tscFreqHz*1.0e9;
+    fprintf(summaryFile, "%s,%d,%d,%e,%ld,%ld,%e,%e,%e,%e,%e,%lu,%s,%lu\n", role, cpu, OS_NOISE_THRESHOLD_NS, duration, noise->numGaps, loggedGaps,
+            totalGapNs, noise->maxGapTSC/tscFreqHz*1.0e9, noise->numGaps > 0 ? totalGapNs/noise->numGaps : 0,
+            duration > 0 ? totalGapNs*1.0e-9/duration : 0, duration > 0 ? noise->numGaps/duration : 0, totalIrqs, topIrq, topIrqCount);
+}
+
+void *os_noise_probe_thread(void* args){
+    os_noise_probe_threadArgs_t *args_cast = (os_noise_probe_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    uint64_t durationTSC = args_cast->durationTSC;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    os_noise_t *noise = args_cast->noise;
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    osNoiseStart(noise);
+    while(noise->lastTSC - noise->startTSC < durationTSC){
+        osNoiseCheck(noise);
+    }
+    osNoiseStop(noise);
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
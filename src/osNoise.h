@@ -0,0 +1,122 @@
+#ifndef _OS_NOISE_H
+#define _OS_NOISE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "timeHelpers.h"
+
+//Reads the TSC on every itteration of the benchmark loops (including the FIFO full/empty polling loops).  A gap between 2 reads larger
+//than OS_NOISE_THRESHOLD_NS is logged as an interruption (IRQ, timer tick, SMI, preemption).  The interrupt counts of each pinned core are
+//read from /proc/interrupts before the trigger and after the threads finish so that the gaps can be correlated with interrupt sources.
+//Note: this adds a TSC read to each itteration and is intended for diagnosing noise rather than measuring peak bandwidth
+#ifndef OS_NOISE_EN
+    #define OS_NOISE_EN (0)
+#endif
+
+//Should be larger than the time to transfer 1 block (the longest time between TSC reads when not interrupted)
+#ifndef OS_NOISE_THRESHOLD_NS
+    #define OS_NOISE_THRESHOLD_NS (2000)
+#endif
+
+//The first OS_NOISE_MAX_GAPS gaps are logged.  Later gaps are only included in the totals
+#ifndef OS_NOISE_MAX_GAPS
+    #define OS_NOISE_MAX_GAPS (4096)
+#endif
+
+//The maximum number of interrupt sources (lines in /proc/interrupts) tracked
+#ifndef OS_NOISE_MAX_IRQS
+    #define OS_NOISE_MAX_IRQS (512)
+#endif
+
+typedef struct {
+    uint64_t thresholdTSC;
+    uint64_t startTSC;
+    uint64_t lastTSC;
+    int64_t numGaps; //Total number of gaps (may be > OS_NOISE_MAX_GAPS)
+    uint64_t totalGapTSC;
+    uint64_t maxGapTSC;
+    uint64_t gapStartTSC[OS_NOISE_MAX_GAPS];
+    uint64_t gapDurationTSC[OS_NOISE_MAX_GAPS];
+} os_noise_t;
+
+typedef struct {
+    char name[16]; //ex. LOC, 24
+    char desc[64]; //ex. Local timer interrupts
+    uint64_t count;
+} os_noise_irq_t;
+
+//The interrupt counts of a single core
+typedef struct {
+    int cpu;
+    int numIrqs;
+    os_noise_irq_t irqs[OS_NOISE_MAX_IRQS];
+} os_noise_irq_snapshot_t;
+
+/**
+ * Allocates the gap log on the given core.  Free with bufferArenaFree()
+ */
+os_noise_t* initOsNoise(int core);
+
+/**
+ * Call just before the timed region
+ */
+static inline void osNoiseStart(os_noise_t *noise){
+    noise->startTSC = readTSC();
+    noise->lastTSC = noise->startTSC;
+}
+
+/**
+ * Call on every itteration of the benchmark loop and of any polling loop
+ */
+static inline void osNoiseCheck(os_noise_t *noise){
+    uint64_t now = readTSC();
+    uint64_t gap = now - noise->lastTSC;
+    if(gap > noise->thresholdTSC){
+        if(noise->numGaps < OS_NOISE_MAX_GAPS){
+            noise->gapStartTSC[noise->numGaps] = noise->lastTSC;
+            noise->gapDurationTSC[noise->numGaps] = gap;
+        }
+        noise->numGaps++;
+        noise->totalGapTSC += gap;
+        noise->maxGapTSC = gap > noise->maxGapTSC ? gap : noise->maxGapTSC;
+    }
+    noise->lastTSC = now;
+}
+
+/**
+ * Call just after the timed region
+ */
+static inline void osNoiseStop(os_noise_t *noise){
+    osNoiseCheck(noise);
+}
+
+/**
+ * Reads the interrupt counts of the given core from /proc/interrupts.  numIrqs is 0 if it cannot be read
+ */
+void readOsNoiseIrqs(int cpu, os_noise_irq_snapshot_t* snapshot);
+
+void writeOsNoiseHeader(FILE* summaryFile, FILE* gapFile, FILE* irqFile);
+
+/**
+ * Writes the noise profile of a single thread: a summary row to summaryFile, each logged gap to gapFile, and the interrupts of its core
+ * which fired durring the test (the difference between the snapshots) to irqFile
+ * @param role a label for the thread (ex. Server, Client, Reader)
+ */
+void writeOsNoise(FILE* summaryFile, FILE* gapFile, FILE* irqFile, const char* role, int cpu, os_noise_t *noise,
+                  os_noise_irq_snapshot_t *irqsBefore, os_noise_irq_snapshot_t *irqsAfter);
+
+typedef struct {
+    uint64_t durationTSC; //How long to spin for
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+    os_noise_t *noise;
+} os_noise_probe_threadArgs_t;
+
+/**
+ * Spins on the TSC (and nothing else) for durationTSC.  Takes os_noise_probe_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *os_noise_probe_thread(void* args);
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "osNoiseRunner.h"
+#include "testParams.h"
+#include "timeHelpers.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "reportHelpers.h"
+#include "vitisNumaAllocHelpers.h"
+
+void runOsNoiseProbeBench(int *cpus, int numCPUs, double durationSec, char* reportFilename){
+    uint64_t durationTSC = (uint64_t) (durationSec*getTSCFreqHz()); //Calibrate before starting the threads
+
+    //Create starting trigger
+    _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, false, memory_order_release);
+
+    //Start Threads
+    os_noise_probe_threadArgs_t *args[numCPUs];
+    for(int i = 0; i<numCPUs; i++){
+        args[i] = (os_noise_probe_threadArgs_t*) bufferArenaAlloc(sizeof(os_noise_probe_threadArgs_t), cpus[i]);
+        args[i]->durationTSC = durationTSC;
+        args[i]->startTrigger = startTrigger;
+        args[i]->readyFlag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), cpus[i]);
+        args[i]->noise = initOsNoise(cpus[i]);
+
+        atomic_signal_fence(memory_order_acquire);
+        atomic_flag_clear_explicit(args[i]->readyFlag, memory_order_release); //Init since this was malloc-ed
+        atomic_flag_test_and_set_explicit(args[i]->readyFlag, memory_order_acq_rel);
+
+        workerPoolSubmit(cpus[i], os_noise_probe_thread, args[i]);
+    }
+
+    //Wait for all threads ready
+    for(int i = 0; i<numCPUs; i++){
+        bool wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(args[i]->readyFlag, memory_order_acq_rel);
+        }
+    }
+
+    os_noise_irq_snapshot_t *irqsBefore = (os_noise_irq_snapshot_t*) malloc(sizeof(os_noise_irq_snapshot_t)*numCPUs);
+    os_noise_irq_snapshot_t *irqsAfter = (os_noise_irq_snapshot_t*) malloc(sizeof(os_noise_irq_snapshot_t)*numCPUs);
+    for(int i = 0; i<numCPUs; i++){
+        readOsNoiseIrqs(cpus[i], irqsBefore+i);
+    }
+
+    //Start probes
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, true, memory_order_release);
+
+    //Wait for threads to finish
+    for(int i = 0; i<numCPUs; i++){
+        free(workerPoolJoin(cpus[i]));
+    }
+
+    for(int i = 0; i<numCPUs; i++){
+        readOsNoiseIrqs(cpus[i], irqsAfter+i);
+    }
+
+    //Write results
+    char* gapFilename = genDerivedReportName(reportFilename, "_gaps");
+    char* irqFilename = genDerivedReportName(reportFilename, "_irqs");
+    FILE *summaryFile = fopen(reportFilename, "w");
+    FILE *gapFile = fopen(gapFilename, "w");
+    FILE *irqFile = fopen(irqFilename, "w");
+    writeOsNoiseHeader(summaryFile, gapFile, irqFile);
+
+    for(int i = 0; i<numCPUs; i++){
+        writeOsNoise(summaryFile, gapFile, irqFile, "Probe", cpus[i], args[i]->noise, irqsBefore+i, irqsAfter+i);
+    }
+
+    fclose(summaryFile);
+    fclose(gapFile);
+    fclose(irqFile);
+    free(gapFilename);
+    free(irqFilename);
+
+    //Cleanup
+    for(int i = 0; i<numCPUs; i++){
+        bufferArenaFree(args[i]->noise);
+        bufferArenaFree(args[i]->readyFlag);
+        bufferArenaFree(args[i]);
+    }
+    free(irqsBefore);
+    free(irqsAfter);
+    free(startTrigger);
+}
@@ -0,0 +1,12 @@
+#ifndef _OS_NOISE_RUNNER_H
+#define _OS_NOISE_RUNNER_H
+
+#include "osNoise.h"
+
+/**
+ * Runs the noise probe (a thread which only spins on the TSC, see osNoise.h) on each of the given CPUs concurrently for durationSec.
+ * The noise profile of each CPU is written to reportFilename with the gaps and interrupts written to derived reports
+ */
+void runOsNoiseProbeBench(int *cpus, int numCPUs, double durationSec, char* reportFilename);
+
+#endif
@@ -0,0 +1,234 @@
+#include "pacedFifo.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <math.h>
+#include <string.h>
+#include "timeHelpers.h"
+
+void *paced_fifo_server_thread(void* args){
+    paced_fifo_threadArgs_t *args_cast = (paced_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    _Atomic int8_t *readOffsetPtr = args_cast->readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr = args_cast->writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr = args_cast->arrayPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    double intervalTSC = args_cast->intervalTSC;
+    int profile = args_cast->profile;
+    uint64_t randState = args_cast->seed == 0 ? 1 : args_cast->seed; //xorshift state must not be 0
+    uint64_t *scheduledTSC = args_cast->scheduledTSC;
+    uint64_t *sentTSC = args_cast->sentTSC;
+    bool paced = intervalTSC > 0;
+
+    //==== Setup Output FIFO ====
+    int8_t writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t writeTmp;
+    int64_t producerStalls = 0;
+
+    //==== Init write temp ====
+    initFifoBlk(&writeTmp);
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //The schedule is kept as a double so that rounding to TSC ticks does not accumulate
+    double nextRelease = (double) readTSC();
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<PACED_TRANSACTIONS_BLKS; blksTransfered++){
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "+m" (writeTmp)
+        :
+        :);
+
+        //Wait for the block's release time
+        uint64_t releaseTSC;
+        if(paced){
+            releaseTSC = (uint64_t) nextRelease;
+            while(readTSC() < releaseTSC){}
+            nextRelease += pacedNextInterval(profile, intervalTSC, blksTransfered, &randState);
+        }else{
+            releaseTSC = readTSC();
+        }
+
+        //Wait for output FIFO to be ready
+        bool notFull = (readOffsetCached != writeOffsetCached);
+        bool stalled = false;
+        while (!notFull)
+        {
+            readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+            notFull = (readOffsetCached != writeOffsetCached);
+
+            //Only a stall if the FIFO is still full once the cached offset is refreshed
+            if(!notFull && !stalled){
+                stalled = true;
+                producerStalls++;
+            }
+        }
+
+        //Write into array
+        int writeOffset = writeOffsetCached;
+        copyBlkToFifo(arrayPtr + writeOffset, &writeTmp);
+        fifoProducerHint(arrayPtr + writeOffset);
+        if (writeOffset >= FIFO_LEN_BLKS)
+        {
+            writeOffset = 0;
+        }
+        else
+        {
+            writeOffset++;
+        }
+        writeOffsetCached = writeOffset;
+        //Timestamp before the block is published so the consumer cannot receive it before it was sent
+        uint64_t blkSentTSC = readTSC();
+        asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+        //Update Write Ptr
+        atomic_store_explicit(writeOffsetPtr, writeOffset, memory_order_release);
+
+        scheduledTSC[blksTransfered] = releaseTSC;
+        sentTSC[blksTransfered] = blkSentTSC;
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    *(args_cast->producerStalls) = producerStalls;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+void *paced_fifo_client_thread(void* args){
+    paced_fifo_threadArgs_t *args_cast = (paced_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    _Atomic int8_t *readOffsetPtr = args_cast->readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr = args_cast->writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr = args_cast->arrayPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    uint64_t *receivedTSC = args_cast->receivedTSC;
+
+    //==== Setup Input FIFO ====
+    int8_t writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t readTmp;
+    #if FIFO_BLK_CONSUME
+        fifo_sample_acc_t consumeAcc = 0;
+    #endif
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<PACED_TRANSACTIONS_BLKS; blksTransfered++){
+        //Wait for input FIFO to be ready
+        bool notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -FIFO_LEN_BLKS)));
+        while (!notEmpty)
+        {
+            writeOffsetCached = atomic_load_explicit(writeOffsetPtr, memory_order_acquire);
+            notEmpty = (!((writeOffsetCached - readOffsetCached == 1) || (writeOffsetCached - readOffsetCached == -FIFO_LEN_BLKS)));
+        }
+
+        //Read from array
+        int readOffset = readOffsetCached;
+        if (readOffset >= FIFO_LEN_BLKS)
+        {
+            readOffset = 0;
+        }
+        else
+        {
+            readOffset++;
+        }
+        fifoConsumerPrefetch(arrayPtr, readOffset);
+        copyBlkFromFifo(&readTmp, arrayPtr + readOffset);
+        readOffsetCached = readOffset;
+        //Update Read Ptr
+        atomic_store_explicit(readOffsetPtr, readOffset, memory_order_release);
+
+        #if FIFO_BLK_CONSUME
+            consumeAcc += consumeFifoBlk(&readTmp);
+        #endif
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        :
+        : "rm" (readTmp)
+        :);
+
+        receivedTSC[blksTransfered] = readTSC();
+    }
+
+    #if FIFO_BLK_CONSUME
+        //Need to make sure that the consumer is not optimized out
+        asm volatile(""
+        :
+        : "rm" (consumeAcc)
+        :);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+const char* getPacedProfileName(int profile){
+    switch(profile){
+        case PACED_PROFILE_CONSTANT:
+            return "Constant";
+        case PACED_PROFILE_POISSON:
+            return "Poisson";
+        case PACED_PROFILE_BURST:
+            return "Burst";
+        default:
+            return "Unknown";
+    }
+}
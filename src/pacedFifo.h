@@ -0,0 +1,90 @@
+#ifndef _PACED_FIFO_H
+#define _PACED_FIFO_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * A Laminar FIFO whose server releases blocks on a TSC based schedule (a fixed sample rate source like a radio) instead of as fast
+ * as the FIFO allows.  The server records when each block was scheduled and when it was written.  The client records when each block
+ * was read.  The latency of a block is the time from when it was scheduled to when it was read (which includes any time the server
+ * waited for the FIFO to have space).
+ */
+
+//The number of blocks transfered in each paced run.  Paced runs at low load take (1/load) times longer than the saturation run
+#ifndef PACED_TRANSACTIONS_BLKS
+    #define PACED_TRANSACTIONS_BLKS (100000)
+#endif
+
+//How the release times of blocks are spaced (the mean rate is the same for all profiles)
+#define PACED_PROFILE_CONSTANT (0) //Blocks are released every interval
+#define PACED_PROFILE_POISSON (1) //The time between blocks is exponentially distributed with a mean of interval
+#define PACED_PROFILE_BURST (2) //PACED_BURST_BLKS blocks are released together every PACED_BURST_BLKS intervals
+
+#ifndef PACED_BURST_BLKS
+    #define PACED_BURST_BLKS (8)
+#endif
+
+typedef struct {
+    _Atomic int8_t *readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr;
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+
+    //Server only
+    double intervalTSC; //The mean time between block releases in TSC ticks.  0 releases blocks as fast as the FIFO allows
+    int profile; //PACED_PROFILE_CONSTANT, PACED_PROFILE_POISSON, or PACED_PROFILE_BURST
+    uint64_t seed; //The seed of the PACED_PROFILE_POISSON interval generator
+    uint64_t *scheduledTSC; //PACED_TRANSACTIONS_BLKS entries.  The time each block was scheduled to be released
+    uint64_t *sentTSC; //PACED_TRANSACTIONS_BLKS entries.  The time each block was written to the FIFO (just before its write offset was published)
+    int64_t *producerStalls; //The number of blocks which had to wait for space in the FIFO after being released (still full after refreshing the cached read offset)
+
+    //Client only
+    uint64_t *receivedTSC; //PACED_TRANSACTIONS_BLKS entries.  The time each block was read from the FIFO
+} paced_fifo_threadArgs_t;
+
+/**
+ * xorshift64* (the interval generator only needs to be cheap and repeatable, not cryptographic)
+ */
+static inline uint64_t pacedRand(uint64_t *state){
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * Returns the time between the release of blk and blk+1 in TSC ticks
+ */
+static inline double pacedNextInterval(int profile, double intervalTSC, int64_t blk, uint64_t *randState){
+    if(profile == PACED_PROFILE_POISSON){
+        double u = (pacedRand(randState) >> 11) * (1.0/9007199254740992.0); //[0, 1) with 53 bits
+        return -log(1.0-u)*intervalTSC;
+    }else if(profile == PACED_PROFILE_BURST){
+        return ((blk+1) % PACED_BURST_BLKS) == 0 ? intervalTSC*PACED_BURST_BLKS : 0;
+    }
+    return intervalTSC;
+}
+
+/**
+ * Takes paced_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *paced_fifo_server_thread(void* args);
+
+/**
+ * Takes paced_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *paced_fifo_client_thread(void* args);
+
+/**
+ * Gets the name of a pacing profile (ex. Constant, Poisson)
+ */
+const char* getPacedProfileName(int profile);
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pacedFifoRunner.h"
+#include "laminarFifoRunner.h"
+#include "laminarFifoInternal.h"
+#include "testParams.h"
+#include "timeHelpers.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "vitisNumaAllocHelpers.h"
+#include "cacheState.h"
+
+static double joinThread(int core){
+    double *result = (double*) workerPoolJoin(core);
+    double time = *result;
+    free(result);
+    return time;
+}
+
+static int compareDouble(const void* a, const void* b){
+    double aVal = *((const double*) a);
+    double bVal = *((const double*) b);
+    return (aVal > bVal) - (aVal < bVal);
+}
+
+/**
+ * Nearest rank percentile of a sorted array
+ */
+static double percentile(double* sorted, int64_t len, double pct){
+    int64_t rank = (int64_t) ceil(pct/100.0*len);
+    if(rank < 1){
+        rank = 1;
+    }
+    return sorted[rank-1];
+}
+
+void writePacedFifoHeader(FILE* reportFile){
+    fprintf(reportFile, "Level,ServerCPU,ClientCPU,Profile,OfferedLoad,TargetBytesPerSec,AchievedBytesPerSec,ServerTime,ClientTime,Blks,BytesTx,DeadlineNs,MissedDeadlines,ProducerStalls,LatencyMinNs,LatencyMeanNs,LatencyP50Ns,LatencyP99Ns,LatencyP999Ns,LatencyMaxNs,JitterNs,TransitMeanNs,CacheState\n");
+}
+
+double runPacedFifoBench(int serverCPU, int clientCPU, const char* level, double targetBytesPerSec, double offeredLoad, int profile, FILE* reportFile, char* blockReportFilename){
+    double tscFreqHz = getTSCFreqHz(); //Calibrate before starting the threads
+
+    _Atomic int8_t* readOffsetPtr;
+    _Atomic int8_t* writeOffsetPtr;
+    PartitionCrossingFIFO_t* arrayPtr;
+    atomic_flag *serverReadyFlag;
+    atomic_flag *clientReadyFlag;
+    initFIFO(&readOffsetPtr, &writeOffsetPtr, &arrayPtr, &serverReadyFlag, &clientReadyFlag, serverCPU, clientCPU);
+
+    //The timestamp arrays are touched by the arena when allocated so that page faults do not occur durring the timed region
+    uint64_t *scheduledTSC = (uint64_t*) bufferArenaAlloc(sizeof(uint64_t)*PACED_TRANSACTIONS_BLKS, serverCPU);
+    uint64_t *sentTSC = (uint64_t*) bufferArenaAlloc(sizeof(uint64_t)*PACED_TRANSACTIONS_BLKS, serverCPU);
+    uint64_t *receivedTSC = (uint64_t*) bufferArenaAlloc(sizeof(uint64_t)*PACED_TRANSACTIONS_BLKS, clientCPU);
+    int64_t *producerStalls = (int64_t*) bufferArenaAlloc(sizeof(int64_t), serverCPU);
+
+    //Create starting trigger
+    _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, false, memory_order_release);
+
+    double intervalTSC = targetBytesPerSec > 0 ? tscFreqHz*BLK_SIZE_BYTES/targetBytesPerSec : 0;
+
+    paced_fifo_threadArgs_t *serverArgs = (paced_fifo_threadArgs_t*) bufferArenaAlloc(sizeof(paced_fifo_threadArgs_t), serverCPU);
+    paced_fifo_threadArgs_t *clientArgs = (paced_fifo_threadArgs_t*) bufferArenaAlloc(sizeof(paced_fifo_threadArgs_t), clientCPU);
+    paced_fifo_threadArgs_t *argsList[2] = {serverArgs, clientArgs};
+    for(int i = 0; i<2; i++){
+        argsList[i]->readOffsetPtr = readOffsetPtr;
+        argsList[i]->writeOffsetPtr = writeOffsetPtr;
+        argsList[i]->arrayPtr = arrayPtr;
+        argsList[i]->startTrigger = startTrigger;
+        argsList[i]->intervalTSC = intervalTSC;
+        argsList[i]->profile = profile;
+        argsList[i]->seed = 0x9E3779B97F4A7C15ULL ^ (((uint64_t) serverCPU) << 32) ^ clientCPU;
+        argsList[i]->scheduledTSC = scheduledTSC;
+        argsList[i]->sentTSC = sentTSC;
+        argsList[i]->producerStalls = producerStalls;
+        argsList[i]->receivedTSC = receivedTSC;
+    }
+    serverArgs->readyFlag = serverReadyFlag;
+    clientArgs->readyFlag = clientReadyFlag;
+
+    //Set the cache state of the FIFO (see cacheState.h)
+    void* fifoBuffers[3] = {arrayPtr, readOffsetPtr, writeOffsetPtr};
+    size_t fifoBufferSizes[3] = {sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1), sizeof(_Atomic int8_t), sizeof(_Atomic int8_t)};
+    cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, 3, serverCPU, clientCPU);
+
+    workerPoolSubmit(serverCPU, paced_fifo_server_thread, serverArgs);
+    workerPoolSubmit(clientCPU, paced_fifo_client_thread, clientArgs);
+
+    //Wait for all threads ready
+    bool wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(serverReadyFlag, memory_order_acq_rel);
+    }
+    wait = true;
+    while(wait){
+        wait = atomic_flag_test_and_set_explicit(clientReadyFlag, memory_order_acq_rel);
+    }
+
+    cacheStateBeforeTrigger(fifoBuffers, fifoBufferSizes, 3);
+
+    //Start FIFO transfers
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, true, memory_order_release);
+
+    //Wait for threads to finish
+    double serverTime = joinThread(serverCPU);
+    double clientTime = joinThread(clientCPU);
+
+    //Compute the latency of each block
+    long long int bytesSent = ((long long int) PACED_TRANSACTIONS_BLKS)*BLK_SIZE_BYTES;
+    double achievedBytesPerSec = bytesSent/clientTime;
+    double periodTSC = intervalTSC > 0 ? intervalTSC : tscFreqHz*BLK_SIZE_BYTES/achievedBytesPerSec;
+    double deadlineNs = PACED_DEADLINE_PERIODS*periodTSC/tscFreqHz*1.0e9;
+
+    double *latencyNs = (double*) malloc(sizeof(double)*PACED_TRANSACTIONS_BLKS);
+    double latencySum = 0;
+    double latencySqSum = 0;
+    double transitSum = 0;
+    int64_t missedDeadlines = 0;
+    for(int64_t blk = 0; blk<PACED_TRANSACTIONS_BLKS; blk++){
+        //The TSC is assumed to be invariant and synchronized across cores.  Clamp in case it is slightly skewed
+        double latency = receivedTSC[blk] > scheduledTSC[blk] ? (receivedTSC[blk] - scheduledTSC[blk])/tscFreqHz*1.0e9 : 0;
+        double transit = receivedTSC[blk] > sentTSC[blk] ? (receivedTSC[blk] - sentTSC[blk])/tscFreqHz*1.0e9 : 0;
+        latencyNs[blk] = latency;
+        latencySum += latency;
+        latencySqSum += latency*latency;
+        transitSum += transit;
+        if(latency > deadlineNs){
+            missedDeadlines++;
+        }
+    }
+
+    if(blockReportFilename != NULL){
+        FILE* blockReportFile = fopen(blockReportFilename, "w");
+        fprintf(blockReportFile, "Blk,ScheduledNs,SentNs,ReceivedNs,LatencyNs\n");
+        uint64_t originTSC = scheduledTSC[0];
+        for(int64_t blk = 0; blk<PACED_TRANSACTIONS_BLKS; blk++){
+            fprintf(blockReportFile, "%ld,%e,%e,%e,%e\n", blk, (scheduledTSC[blk]-originTSC)/tscFreqHz*1.0e9, (sentTSC[blk]-originTSC)/tscFreqHz*1.0e9,
+                    (receivedTSC[blk]-originTSC)/tscFreqHz*1.0e9, latencyNs[blk]);
+        }
+        fclose(blockReportFile);
+    }
+
+    qsort(latencyNs, PACED_TRANSACTIONS_BLKS, sizeof(double), compareDouble);
+    double latencyMean = latencySum/PACED_TRANSACTIONS_BLKS;
+    double latencyVar = latencySqSum/PACED_TRANSACTIONS_BLKS - latencyMean*latencyMean;
+
+    //Write results
+    fprintf(reportFile, "%s,%d,%d,%s,%f,%e,%e,%e,%e,%d,%lld,%e,%ld,%ld,%e,%e,%e,%e,%e,%e,%e,%e,%s\n", level, serverCPU, clientCPU,
+            targetBytesPerSec > 0 ? getPacedProfileName(profile) : "Unpaced", offeredLoad, targetBytesPerSec, achievedBytesPerSec,
+            serverTime, clientTime, PACED_TRANSACTIONS_BLKS, bytesSent, deadlineNs, missedDeadlines, *producerStalls,
+            latencyNs[0], latencyMean, percentile(latencyNs, PACED_TRANSACTIONS_BLKS, 50), percentile(latencyNs, PACED_TRANSACTIONS_BLKS, 99),
+            percentile(latencyNs, PACED_TRANSACTIONS_BLKS, 99.9), latencyNs[PACED_TRANSACTIONS_BLKS-1], sqrt(latencyVar > 0 ? latencyVar : 0),
+            transitSum/PACED_TRANSACTIONS_BLKS, getCacheStateName(CACHE_STATE));
+    fflush(reportFile);
+
+    //Cleanup
+    free(latencyNs);
+    cleanupFIFO(readOffsetPtr, writeOffsetPtr, arrayPtr, serverReadyFlag, clientReadyFlag);
+    bufferArenaFree(scheduledTSC);
+    bufferArenaFree(sentTSC);
+    bufferArenaFree(receivedTSC);
+    bufferArenaFree(producerStalls);
+    bufferArenaFree(serverArgs);
+    bufferArenaFree(clientArgs);
+    free(startTrigger);
+
+    return achievedBytesPerSec;
+}
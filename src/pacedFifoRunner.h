@@ -0,0 +1,29 @@
+#ifndef _PACED_FIFO_RUNNER_H
+#define _PACED_FIFO_RUNNER_H
+
+#include <stdio.h>
+#include "pacedFifo.h"
+
+//A block misses its deadline if its latency (from when it was scheduled to when it was read) exceeds this many mean block intervals.
+//For the unpaced (saturation) run, the interval is taken from the achieved rate
+#ifndef PACED_DEADLINE_PERIODS
+    #define PACED_DEADLINE_PERIODS (1.0)
+#endif
+
+/**
+ * Runs a paced FIFO (see pacedFifo.h) from serverCPU to clientCPU and appends a row to reportFile (see writePacedFifoHeader)
+ * @param level the name of the topology level the CPUs span (reported in each row)
+ * @param targetBytesPerSec the mean rate at which the server releases blocks.  0 releases blocks as fast as the FIFO allows (saturation)
+ * @param offeredLoad the fraction of link capacity targetBytesPerSec corresponds to (reported in each row)
+ * @param profile PACED_PROFILE_CONSTANT, PACED_PROFILE_POISSON, or PACED_PROFILE_BURST
+ * @param blockReportFilename if not NULL, the per-block timestamps and latency are written to this file
+ * @returns the rate (bytes/s) achieved by the client
+ */
+double runPacedFifoBench(int serverCPU, int clientCPU, const char* level, double targetBytesPerSec, double offeredLoad, int profile, FILE* reportFile, char* blockReportFilename);
+
+/**
+ * Writes the header for the rows appended by runPacedFifoBench
+ */
+void writePacedFifoHeader(FILE* reportFile);
+
+#endif
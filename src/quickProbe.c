@@ -0,0 +1,242 @@
+#include "quickProbe.h"
+#include "fifoCopy.h"
+#include "fifoHints.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "laminarFifo.h"
+#include "timeHelpers.h"
+
+/**
+ * Writes transferBlks blocks from tmp into the next slot of fifo
+ * @returns false if the FIFO was still full at deadlineTSC
+ */
+static inline bool quickProbeSend(quick_probe_fifo_t *fifo, int8_t *writeOffsetCached, int8_t *readOffsetCached,
+                                  PartitionCrossingFIFO_t *tmp, int transferBlks, uint64_t deadlineTSC){
+    //Wait for the FIFO to have space
+    bool notFull = (*readOffsetCached != *writeOffsetCached);
+    while (!notFull)
+    {
+        if(readTSC() > deadlineTSC){
+            return false;
+        }
+        *readOffsetCached = atomic_load_explicit(fifo->readOffsetPtr, memory_order_acquire);
+        notFull = (*readOffsetCached != *writeOffsetCached);
+    }
+
+    int writeOffset = *writeOffsetCached;
+    PartitionCrossingFIFO_t *slot = fifo->arrayPtr + writeOffset*transferBlks;
+    for(int b = 0; b<transferBlks; b++){
+        copyBlkToFifo(slot+b, tmp+b);
+        fifoProducerHint(slot+b);
+    }
+    if (writeOffset >= FIFO_LEN_BLKS)
+    {
+        writeOffset = 0;
+    }
+    else
+    {
+        writeOffset++;
+    }
+    *writeOffsetCached = writeOffset;
+    atomic_store_explicit(fifo->writeOffsetPtr, writeOffset, memory_order_release);
+    return true;
+}
+
+/**
+ * Reads the next slot of fifo (transferBlks blocks) into tmp
+ * @returns false if the FIFO was still empty at deadlineTSC
+ */
+static inline bool quickProbeReceive(quick_probe_fifo_t *fifo, int8_t *writeOffsetCached, int8_t *readOffsetCached,
+                                     PartitionCrossingFIFO_t *tmp, int transferBlks, uint64_t deadlineTSC){
+    //Wait for the FIFO to have a slot
+    bool notEmpty = (!((*writeOffsetCached - *readOffsetCached == 1) || (*writeOffsetCached - *readOffsetCached == -FIFO_LEN_BLKS)));
+    while (!notEmpty)
+    {
+        if(readTSC() > deadlineTSC){
+            return false;
+        }
+        *writeOffsetCached = atomic_load_explicit(fifo->writeOffsetPtr, memory_order_acquire);
+        notEmpty = (!((*writeOffsetCached - *readOffsetCached == 1) || (*writeOffsetCached - *readOffsetCached == -FIFO_LEN_BLKS)));
+    }
+
+    int readOffset = *readOffsetCached;
+    if (readOffset >= FIFO_LEN_BLKS)
+    {
+        readOffset = 0;
+    }
+    else
+    {
+        readOffset++;
+    }
+    PartitionCrossingFIFO_t *slot = fifo->arrayPtr + readOffset*transferBlks;
+    for(int b = 0; b<transferBlks; b++){
+        copyBlkFromFifo(tmp+b, slot+b);
+    }
+    *readOffsetCached = readOffset;
+    atomic_store_explicit(fifo->readOffsetPtr, readOffset, memory_order_release);
+    return true;
+}
+
+void *quick_probe_server_thread(void* args){
+    quick_probe_threadArgs_t *args_cast = (quick_probe_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int transferBlks = args_cast->transferBlks;
+    quick_probe_fifo_t fifo = args_cast->fifo;
+    uint64_t deadlineTSC = args_cast->deadlineTSC;
+    int64_t slots = (QUICK_PROBE_TRIALS+1)*args_cast->slotsPerTrial;
+
+    //==== Setup Output FIFO ====
+    int8_t writeOffsetCached = atomic_load_explicit(fifo.writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(fifo.readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t writeTmp[QUICK_PROBE_MAX_TRANSFER_BLKS];
+    memset(writeTmp, 0, sizeof(PartitionCrossingFIFO_t)*transferBlks);
+
+    laminarBarrierSignalReady(args_cast->readyFlag);
+    laminarBarrierWaitForTrigger(args_cast->startTrigger);
+
+    //==== Start Test ====
+    bool timedOut = false;
+    for(int64_t slot = 0; slot<slots && !timedOut; slot++){
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmps are modified.  They are not actually modified
+        asm volatile(""
+        : "+m" (writeTmp)
+        :
+        :);
+
+        timedOut = !quickProbeSend(&fifo, &writeOffsetCached, &readOffsetCached, writeTmp, transferBlks, deadlineTSC);
+    }
+
+    *(args_cast->timedOut) = timedOut;
+    return NULL;
+}
+
+void *quick_probe_client_thread(void* args){
+    quick_probe_threadArgs_t *args_cast = (quick_probe_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int transferBlks = args_cast->transferBlks;
+    quick_probe_fifo_t fifo = args_cast->fifo;
+    uint64_t deadlineTSC = args_cast->deadlineTSC;
+    int64_t slotsPerTrial = args_cast->slotsPerTrial;
+    uint64_t *trialEndTSC = args_cast->trialEndTSC;
+
+    //==== Setup Input FIFO ====
+    int8_t writeOffsetCached = atomic_load_explicit(fifo.writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(fifo.readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t readTmp[QUICK_PROBE_MAX_TRANSFER_BLKS];
+
+    laminarBarrierSignalReady(args_cast->readyFlag);
+    laminarBarrierWaitForTrigger(args_cast->startTrigger);
+
+    //==== Start Test ====
+    bool timedOut = false;
+    int trialsCompleted = 0;
+    trialEndTSC[0] = readTSC();
+    for(int trial = 0; trial<QUICK_PROBE_TRIALS+1 && !timedOut; trial++){
+        for(int64_t slot = 0; slot<slotsPerTrial && !timedOut; slot++){
+            timedOut = !quickProbeReceive(&fifo, &writeOffsetCached, &readOffsetCached, readTmp, transferBlks, deadlineTSC);
+
+            //Need to make sure that the memory copy is not optimized out if the content is not checked
+            asm volatile(""
+            : "+m" (readTmp)
+            :
+            :);
+        }
+        if(!timedOut){
+            trialEndTSC[trial+1] = readTSC();
+            trialsCompleted++;
+        }
+    }
+
+    *(args_cast->trialsCompleted) = trialsCompleted;
+    *(args_cast->timedOut) = timedOut;
+    return NULL;
+}
+
+void *quick_probe_ping_thread(void* args){
+    quick_probe_threadArgs_t *args_cast = (quick_probe_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int transferBlks = args_cast->transferBlks;
+    quick_probe_fifo_t fifo = args_cast->fifo;
+    quick_probe_fifo_t returnFifo = args_cast->returnFifo;
+    uint64_t deadlineTSC = args_cast->deadlineTSC;
+    uint64_t *roundTripTSC = args_cast->roundTripTSC;
+
+    //==== Setup FIFOs ====
+    int8_t writeOffsetCached = atomic_load_explicit(fifo.writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(fifo.readOffsetPtr, memory_order_acquire);
+    int8_t returnWriteOffsetCached = atomic_load_explicit(returnFifo.writeOffsetPtr, memory_order_acquire);
+    int8_t returnReadOffsetCached = atomic_load_explicit(returnFifo.readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t tmp[QUICK_PROBE_MAX_TRANSFER_BLKS];
+    memset(tmp, 0, sizeof(PartitionCrossingFIFO_t)*transferBlks);
+
+    laminarBarrierSignalReady(args_cast->readyFlag);
+    laminarBarrierWaitForTrigger(args_cast->startTrigger);
+
+    //==== Start Test ====
+    //Only 1 slot is ever in flight so each round trip includes the full cost of the offset handoff in both directions
+    bool timedOut = false;
+    for(int i = 0; i<QUICK_PROBE_WARMUP_ROUND_TRIPS+QUICK_PROBE_ROUND_TRIPS && !timedOut; i++){
+        uint64_t startTSC = readTSC();
+        timedOut = !quickProbeSend(&fifo, &writeOffsetCached, &readOffsetCached, tmp, transferBlks, deadlineTSC);
+        if(!timedOut){
+            timedOut = !quickProbeReceive(&returnFifo, &returnWriteOffsetCached, &returnReadOffsetCached, tmp, transferBlks, deadlineTSC);
+        }
+        uint64_t stopTSC = readTSC();
+
+        asm volatile(""
+        : "+m" (tmp)
+        :
+        :);
+
+        if(i >= QUICK_PROBE_WARMUP_ROUND_TRIPS){
+            roundTripTSC[i-QUICK_PROBE_WARMUP_ROUND_TRIPS] = stopTSC - startTSC;
+        }
+    }
+
+    *(args_cast->timedOut) = timedOut;
+    return NULL;
+}
+
+void *quick_probe_pong_thread(void* args){
+    quick_probe_threadArgs_t *args_cast = (quick_probe_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    int transferBlks = args_cast->transferBlks;
+    quick_probe_fifo_t fifo = args_cast->fifo;
+    quick_probe_fifo_t returnFifo = args_cast->returnFifo;
+    uint64_t deadlineTSC = args_cast->deadlineTSC;
+
+    //==== Setup FIFOs ====
+    int8_t writeOffsetCached = atomic_load_explicit(fifo.writeOffsetPtr, memory_order_acquire);
+    int8_t readOffsetCached = atomic_load_explicit(fifo.readOffsetPtr, memory_order_acquire);
+    int8_t returnWriteOffsetCached = atomic_load_explicit(returnFifo.writeOffsetPtr, memory_order_acquire);
+    int8_t returnReadOffsetCached = atomic_load_explicit(returnFifo.readOffsetPtr, memory_order_acquire);
+    PartitionCrossingFIFO_t tmp[QUICK_PROBE_MAX_TRANSFER_BLKS];
+
+    laminarBarrierSignalReady(args_cast->readyFlag);
+    laminarBarrierWaitForTrigger(args_cast->startTrigger);
+
+    //==== Start Test ====
+    bool timedOut = false;
+    for(int i = 0; i<QUICK_PROBE_WARMUP_ROUND_TRIPS+QUICK_PROBE_ROUND_TRIPS && !timedOut; i++){
+        timedOut = !quickProbeReceive(&fifo, &writeOffsetCached, &readOffsetCached, tmp, transferBlks, deadlineTSC);
+
+        asm volatile(""
+        : "+m" (tmp)
+        :
+        :);
+
+        if(!timedOut){
+            timedOut = !quickProbeSend(&returnFifo, &returnWriteOffsetCached, &returnReadOffsetCached, tmp, transferBlks, deadlineTSC);
+        }
+    }
+
+    *(args_cast->timedOut) = timedOut;
+    return NULL;
+}
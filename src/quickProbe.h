@@ -0,0 +1,82 @@
+#ifndef _QUICK_PROBE_H
+#define _QUICK_PROBE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * Short, TSC timed Laminar FIFO transfers used by the quick probe (see quickProbeRunner.h).  Each FIFO slot holds transferBlks blocks
+ * (slot s is array[s*transferBlks .. s*transferBlks+transferBlks-1]) so that several transfer sizes can be measured without rebuilding
+ * with a different block size.  The server writes every block of the slot before publishing the write offset, like the coalesced FIFO.
+ *
+ * Every wait loop gives up once the TSC passes deadlineTSC so that a stalled or starved core cannot hold up the probe.  A thread which
+ * gives up sets *timedOut and returns early
+ */
+
+#ifndef QUICK_PROBE_MAX_TRANSFER_BLKS
+    #define QUICK_PROBE_MAX_TRANSFER_BLKS (16)
+#endif
+
+//The number of bandwidth trials (after the warmup trial) in each run
+#ifndef QUICK_PROBE_TRIALS
+    #define QUICK_PROBE_TRIALS (5)
+#endif
+
+//The number of round trips timed in each latency run (after QUICK_PROBE_WARMUP_ROUND_TRIPS)
+#ifndef QUICK_PROBE_ROUND_TRIPS
+    #define QUICK_PROBE_ROUND_TRIPS (256)
+#endif
+
+#ifndef QUICK_PROBE_WARMUP_ROUND_TRIPS
+    #define QUICK_PROBE_WARMUP_ROUND_TRIPS (32)
+#endif
+
+typedef struct {
+    _Atomic int8_t *readOffsetPtr;
+    _Atomic int8_t *writeOffsetPtr;
+    PartitionCrossingFIFO_t *arrayPtr; //(FIFO_LEN_BLKS+1)*transferBlks blocks
+} quick_probe_fifo_t;
+
+typedef struct {
+    int transferBlks; //Blocks in each slot (1 to QUICK_PROBE_MAX_TRANSFER_BLKS)
+    quick_probe_fifo_t fifo; //Bandwidth: from the server to the client.  Latency: from the ping thread to the pong thread
+    quick_probe_fifo_t returnFifo; //Latency only: from the pong thread back to the ping thread
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+    uint64_t deadlineTSC;
+    bool *timedOut; //Written by the thread before it returns
+
+    //Bandwidth
+    int64_t slotsPerTrial; //Each run is QUICK_PROBE_TRIALS+1 trials (the first is the warmup)
+    uint64_t *trialEndTSC; //Client only.  QUICK_PROBE_TRIALS+2 entries, the first is the start of the warmup trial
+    int *trialsCompleted; //Client only.  Trials (including the warmup) which completed before the deadline
+
+    //Latency
+    uint64_t *roundTripTSC; //Ping only.  QUICK_PROBE_ROUND_TRIPS entries
+} quick_probe_threadArgs_t;
+
+/**
+ * Takes quick_probe_threadArgs_t.  Writes (QUICK_PROBE_TRIALS+1)*slotsPerTrial slots into fifo.  Returns NULL
+ */
+void *quick_probe_server_thread(void* args);
+
+/**
+ * Takes quick_probe_threadArgs_t.  Reads (QUICK_PROBE_TRIALS+1)*slotsPerTrial slots from fifo and records the end of each trial which
+ * completes.  Returns NULL
+ */
+void *quick_probe_client_thread(void* args);
+
+/**
+ * Takes quick_probe_threadArgs_t.  Sends a slot to the pong thread and waits for it to come back, recording the round trip time.
+ * Returns NULL
+ */
+void *quick_probe_ping_thread(void* args);
+
+/**
+ * Takes quick_probe_threadArgs_t.  Returns each slot it receives from the ping thread.  Returns NULL
+ */
+void *quick_probe_pong_thread(void* args);
+
+#endif
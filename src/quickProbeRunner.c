@@ -0,0 +1,252 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "quickProbeRunner.h"
+#include "laminarFifo.h"
+#include "testParams.h"
+#include "topologyHelpers.h"
+
+int getQuickProbeTransferBlks(int sizeIdx){
+    int transferBlks = 1;
+    for(int i = 0; i<sizeIdx; i++){
+        transferBlks *= QUICK_PROBE_SIZE_STEP;
+    }
+
+    if(transferBlks > QUICK_PROBE_MAX_TRANSFER_BLKS){
+        printf("Quick probe transfers of %d blocks exceed QUICK_PROBE_MAX_TRANSFER_BLKS (%d) ... exiting\n", transferBlks, QUICK_PROBE_MAX_TRANSFER_BLKS);
+        exit(1);
+    }
+    return transferBlks;
+}
+
+/**
+ * Allocates an empty FIFO with slots of transferBlks blocks.  Placed like laminarFifoCreate
+ */
+static void allocQuickProbeFifo(quick_probe_fifo_t* fifo, int serverCPU, int clientCPU, int transferBlks){
+    fifo->readOffsetPtr = (_Atomic int8_t*) laminarAlloc(sizeof(_Atomic int8_t), clientCPU);
+    fifo->writeOffsetPtr = (_Atomic int8_t*) laminarAlloc(sizeof(_Atomic int8_t), serverCPU);
+    fifo->arrayPtr = (PartitionCrossingFIFO_t*) laminarAlloc(sizeof(PartitionCrossingFIFO_t)*(FIFO_LEN_BLKS+1)*transferBlks, serverCPU); //Alloc an additional slot (for empty/full ambiguity resolution)
+    atomic_init(fifo->readOffsetPtr, 0);
+    atomic_init(fifo->writeOffsetPtr, 1);
+}
+
+static void freeQuickProbeFifo(quick_probe_fifo_t* fifo){
+    laminarFree(fifo->readOffsetPtr);
+    laminarFree(fifo->writeOffsetPtr);
+    laminarFree(fifo->arrayPtr);
+}
+
+/**
+ * Runs the 2 threads (thread 0 on cpus[0]) with a shared start barrier.  The arguments of both threads are initialized from common.
+ * If the threads are not both ready by the deadline, they are released anyway and give up as soon as they start
+ * @returns true if either thread was not ready or timed out
+ */
+static bool runQuickProbeThreads(int* cpus, void* (*funs[2])(void*), quick_probe_threadArgs_t* common, quick_probe_threadArgs_t** args){
+    laminar_start_barrier_t *barrier = laminarBarrierCreate(cpus, 2);
+    bool *timedOut[2];
+    for(int i = 0; i<2; i++){
+        timedOut[i] = (bool*) laminarAlloc(sizeof(bool), cpus[i]);
+        *(args[i]) = *common;
+        args[i]->startTrigger = barrier->startTrigger;
+        args[i]->readyFlag = barrier->readyFlags[i];
+        args[i]->timedOut = timedOut[i];
+    }
+    for(int i = 0; i<2; i++){
+        laminarThreadStart(cpus[i], funs[i], args[i]);
+    }
+
+    bool anyTimedOut = !laminarBarrierWaitAllReadyUntil(barrier, common->deadlineTSC);
+    laminarBarrierRelease(barrier);
+
+    for(int i = 0; i<2; i++){
+        laminarThreadJoin(cpus[i]);
+        anyTimedOut |= *(timedOut[i]);
+        laminarFree(timedOut[i]);
+    }
+    laminarBarrierDestroy(barrier);
+    return anyTimedOut;
+}
+
+void runQuickProbePair(int serverCPU, int clientCPU, int level, int transferBlks, uint64_t deadlineTSC, quick_probe_result_t* result){
+    double tscFreqHz = getTSCFreqHz();
+    int cpus[2] = {serverCPU, clientCPU};
+    size_t transferBytes = transferBlks*BLK_SIZE_BYTES;
+
+    result->serverCPU = serverCPU;
+    result->clientCPU = clientCPU;
+    result->level = level;
+    result->transferBlks = transferBlks;
+    result->timedOut = false;
+    result->trials = 0;
+    result->roundTrips = 0;
+
+    quick_probe_threadArgs_t *args[2];
+    for(int i = 0; i<2; i++){
+        args[i] = (quick_probe_threadArgs_t*) laminarAlloc(sizeof(quick_probe_threadArgs_t), cpus[i]);
+    }
+    quick_probe_threadArgs_t common = {0};
+    common.transferBlks = transferBlks;
+    common.deadlineTSC = deadlineTSC;
+
+    //==== Bandwidth ====
+    //Each trial covers the FIFO at least twice so that the trial is not just filling the FIFO
+    int64_t slotsPerTrial = QUICK_PROBE_TRIAL_BYTES/transferBytes;
+    if(slotsPerTrial < 2*(FIFO_LEN_BLKS+1)){
+        slotsPerTrial = 2*(FIFO_LEN_BLKS+1);
+    }
+    uint64_t *trialEndTSC = (uint64_t*) laminarAlloc(sizeof(uint64_t)*(QUICK_PROBE_TRIALS+2), clientCPU);
+    int *trialsCompleted = (int*) laminarAlloc(sizeof(int), clientCPU);
+    allocQuickProbeFifo(&common.fifo, serverCPU, clientCPU, transferBlks);
+    common.slotsPerTrial = slotsPerTrial;
+    common.trialEndTSC = trialEndTSC;
+    common.trialsCompleted = trialsCompleted;
+
+    void* (*bandwidthFuns[2])(void*) = {quick_probe_server_thread, quick_probe_client_thread};
+    result->timedOut |= runQuickProbeThreads(cpus, bandwidthFuns, &common, args);
+
+    //The first trial is the warmup.  Trials which completed before a timeout are kept
+    for(int trial = 1; trial<*trialsCompleted; trial++){
+        double trialSec = (trialEndTSC[trial+1] - trialEndTSC[trial])/tscFreqHz;
+        result->bytesPerSec[result->trials] = slotsPerTrial*transferBytes/trialSec;
+        result->trials++;
+    }
+
+    freeQuickProbeFifo(&common.fifo);
+    laminarFree(trialEndTSC);
+    laminarFree(trialsCompleted);
+
+    //==== Latency ====
+    if(!result->timedOut){
+        uint64_t *roundTripTSC = (uint64_t*) laminarAlloc(sizeof(uint64_t)*QUICK_PROBE_ROUND_TRIPS, serverCPU);
+        allocQuickProbeFifo(&common.fifo, serverCPU, clientCPU, transferBlks);
+        allocQuickProbeFifo(&common.returnFifo, clientCPU, serverCPU, transferBlks);
+        common.slotsPerTrial = 0;
+        common.trialEndTSC = NULL;
+        common.trialsCompleted = NULL;
+        common.roundTripTSC = roundTripTSC;
+
+        void* (*latencyFuns[2])(void*) = {quick_probe_ping_thread, quick_probe_pong_thread};
+        result->timedOut |= runQuickProbeThreads(cpus, latencyFuns, &common, args);
+
+        if(!result->timedOut){
+            for(int i = 0; i<QUICK_PROBE_ROUND_TRIPS; i++){
+                result->latencyNs[i] = roundTripTSC[i]/tscFreqHz*1e9/2;
+            }
+            result->roundTrips = QUICK_PROBE_ROUND_TRIPS;
+        }
+
+        freeQuickProbeFifo(&common.fifo);
+        freeQuickProbeFifo(&common.returnFifo);
+        laminarFree(roundTripTSC);
+    }
+
+    for(int i = 0; i<2; i++){
+        laminarFree(args[i]);
+    }
+}
+
+/**
+ * Computes the mean, the standard deviation, and the half width of the 95% confidence interval of the mean (normal approximation)
+ */
+static void quickProbeStats(double* samples, int numSamples, double* mean, double* stdDev, double* ci95){
+    double sum = 0;
+    for(int i = 0; i<numSamples; i++){
+        sum += samples[i];
+    }
+    *mean = sum/numSamples;
+
+    double sumSq = 0;
+    for(int i = 0; i<numSamples; i++){
+        sumSq += (samples[i]-*mean)*(samples[i]-*mean);
+    }
+    *stdDev = numSamples > 1 ? sqrt(sumSq/(numSamples-1)) : 0;
+    *ci95 = 1.96*(*stdDev)/sqrt(numSamples);
+}
+
+static int compareDoubles(const void* a, const void* b){
+    double aVal = *((const double*) a);
+    double bVal = *((const double*) b);
+    return (aVal > bVal) - (aVal < bVal);
+}
+
+void writeQuickProbeCostHeader(FILE* reportFile){
+    fprintf(reportFile, "Level,TransferBlks,TransferBytes,Pairs,PairsTimedOut,BandwidthTrials,BytesPerSec,BytesPerSecStdDev,BytesPerSecCI95,LatencySamples,LatencyNs,LatencyNsStdDev,LatencyNsCI95,LatencyNsMedian\n");
+}
+
+void writeQuickProbeCostRow(FILE* reportFile, int level, int transferBlks, quick_probe_result_t* results, int numResults){
+    int pairsTimedOut = 0;
+    int numTrials = 0;
+    int numRoundTrips = 0;
+    for(int i = 0; i<numResults; i++){
+        pairsTimedOut += results[i].timedOut ? 1 : 0;
+        numTrials += results[i].trials;
+        numRoundTrips += results[i].roundTrips;
+    }
+
+    fprintf(reportFile, "%s,%d,%lu,%d,%d,%d,", getTopologyLevelName(level), transferBlks, transferBlks*BLK_SIZE_BYTES, numResults, pairsTimedOut, numTrials);
+
+    if(numTrials > 0){
+        double bytesPerSec[numTrials];
+        int ind = 0;
+        for(int i = 0; i<numResults; i++){
+            for(int t = 0; t<results[i].trials; t++){
+                bytesPerSec[ind++] = results[i].bytesPerSec[t];
+            }
+        }
+        double mean, stdDev, ci95;
+        quickProbeStats(bytesPerSec, numTrials, &mean, &stdDev, &ci95);
+        fprintf(reportFile, "%e,%e,%e,", mean, stdDev, ci95);
+    }else{
+        fprintf(reportFile, "NA,NA,NA,");
+    }
+
+    fprintf(reportFile, "%d,", numRoundTrips);
+    if(numRoundTrips > 0){
+        double *latencyNs = (double*) malloc(sizeof(double)*numRoundTrips);
+        int ind = 0;
+        for(int i = 0; i<numResults; i++){
+            for(int r = 0; r<results[i].roundTrips; r++){
+                latencyNs[ind++] = results[i].latencyNs[r];
+            }
+        }
+        double mean, stdDev, ci95;
+        quickProbeStats(latencyNs, numRoundTrips, &mean, &stdDev, &ci95);
+        qsort(latencyNs, numRoundTrips, sizeof(double), compareDoubles);
+        fprintf(reportFile, "%e,%e,%e,%e\n", mean, stdDev, ci95, latencyNs[numRoundTrips/2]);
+        free(latencyNs);
+    }else{
+        fprintf(reportFile, "NA,NA,NA,NA\n");
+    }
+    fflush(reportFile);
+}
+
+void writeQuickProbePairHeader(FILE* reportFile){
+    fprintf(reportFile, "ServerCPU,ClientCPU,Level,TransferBlks,TimedOut,BandwidthTrials,BytesPerSec,BytesPerSecStdDev,LatencySamples,LatencyNs,LatencyNsStdDev\n");
+}
+
+void writeQuickProbePairRow(FILE* reportFile, quick_probe_result_t* result){
+    fprintf(reportFile, "%d,%d,%s,%d,%d,%d,", result->serverCPU, result->clientCPU, getTopologyLevelName(result->level),
+            result->transferBlks, result->timedOut ? 1 : 0, result->trials);
+
+    double mean, stdDev, ci95;
+    if(result->trials > 0){
+        quickProbeStats(result->bytesPerSec, result->trials, &mean, &stdDev, &ci95);
+        fprintf(reportFile, "%e,%e,", mean, stdDev);
+    }else{
+        fprintf(reportFile, "NA,NA,");
+    }
+
+    fprintf(reportFile, "%d,", result->roundTrips);
+    if(result->roundTrips > 0){
+        quickProbeStats(result->latencyNs, result->roundTrips, &mean, &stdDev, &ci95);
+        fprintf(reportFile, "%e,%e\n", mean, stdDev);
+    }else{
+        fprintf(reportFile, "NA,NA\n");
+    }
+    fflush(reportFile);
+}
@@ -0,0 +1,76 @@
+#ifndef _QUICK_PROBE_RUNNER_H
+#define _QUICK_PROBE_RUNNER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "quickProbe.h"
+
+/*
+ * A fast self-calibration probe intended to run when a deployment starts.  A few pairs of cores at each topology level are measured
+ * with very short transfers at a few transfer sizes and the results are written as a compact cost table: the bandwidth and one-way
+ * latency of each level and transfer size with an error estimate.
+ *
+ * The transfer sizes are 1, QUICK_PROBE_SIZE_STEP, QUICK_PROBE_SIZE_STEP^2, ... blocks (QUICK_PROBE_SIZES sizes).  Bandwidth is measured
+ * with a free running FIFO over QUICK_PROBE_TRIALS trials of QUICK_PROBE_TRIAL_BYTES each.  Latency is half the round trip time of a
+ * single slot bounced between the cores
+ */
+
+#ifndef QUICK_PROBE_SIZES
+    #define QUICK_PROBE_SIZES (3)
+#endif
+
+#ifndef QUICK_PROBE_SIZE_STEP
+    #define QUICK_PROBE_SIZE_STEP (4)
+#endif
+
+#ifndef QUICK_PROBE_TRIAL_BYTES
+    #define QUICK_PROBE_TRIAL_BYTES (1024*1024)
+#endif
+
+typedef struct {
+    int serverCPU;
+    int clientCPU;
+    int level; //The topology level of the pair (see topologyHelpers.h)
+    int transferBlks;
+    bool timedOut;
+    int trials; //Bandwidth trials which completed (before a timeout)
+    double bytesPerSec[QUICK_PROBE_TRIALS];
+    int roundTrips; //Round trips which completed
+    double latencyNs[QUICK_PROBE_ROUND_TRIPS]; //One-way (half the round trip)
+} quick_probe_result_t;
+
+/**
+ * Gets the number of blocks in each transfer for transfer size index sizeIdx (0 to QUICK_PROBE_SIZES-1)
+ */
+int getQuickProbeTransferBlks(int sizeIdx);
+
+/**
+ * Measures the bandwidth and latency from serverCPU to clientCPU with transfers of transferBlks blocks.  Waiting for the threads to be
+ * ready and the transfers give up at deadlineTSC (setting result->timedOut).  Bandwidth trials which completed before a timeout are kept
+ * @param level the topology level of the pair (recorded in the result so that it is not read from sysfs again)
+ */
+void runQuickProbePair(int serverCPU, int clientCPU, int level, int transferBlks, uint64_t deadlineTSC, quick_probe_result_t* result);
+
+/**
+ * Writes the header for the rows appended by writeQuickProbeCostRow
+ */
+void writeQuickProbeCostHeader(FILE* reportFile);
+
+/**
+ * Combines the results of the pairs of cores at a topology level (for a single transfer size) into a row of the cost table.
+ * The error estimates are the standard deviation and the half width of the 95% confidence interval of the mean over all samples
+ */
+void writeQuickProbeCostRow(FILE* reportFile, int level, int transferBlks, quick_probe_result_t* results, int numResults);
+
+/**
+ * Writes the header for the rows appended by writeQuickProbePairRow
+ */
+void writeQuickProbePairHeader(FILE* reportFile);
+
+/**
+ * Writes the result of a single pair of cores
+ */
+void writeQuickProbePairRow(FILE* reportFile, quick_probe_result_t* result);
+
+#endif
@@ -0,0 +1,262 @@
+#include "recordFifo.h"
+#include "pacedFifo.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include "timeHelpers.h"
+
+void *record_fifo_server_thread(void* args){
+    record_fifo_threadArgs_t *args_cast = (record_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    _Atomic int64_t *readLinesPtr = args_cast->readLinesPtr;
+    _Atomic int64_t *writeLinesPtr = args_cast->writeLinesPtr;
+    uint8_t *ringPtr = args_cast->ringPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    bool padded = args_cast->padded;
+    uint32_t *payloadBytes = args_cast->payloadBytes;
+    double intervalTSC = args_cast->intervalTSC;
+    int profile = args_cast->profile;
+    uint64_t randState = args_cast->seed == 0 ? 1 : args_cast->seed; //xorshift state must not be 0
+    uint64_t *scheduledTSC = args_cast->scheduledTSC;
+    bool paced = intervalTSC > 0;
+
+    //==== Setup Output FIFO ====
+    int64_t writeLinesCached = atomic_load_explicit(writeLinesPtr, memory_order_acquire);
+    int64_t readLinesCached = atomic_load_explicit(readLinesPtr, memory_order_acquire);
+    int64_t writeLine = writeLinesCached % RECORD_FIFO_LEN_LINES; //The position in the ring
+    int64_t producerStalls = 0;
+    int64_t padLines = 0;
+
+    //==== Init write temp ====
+    uint8_t writeTmp[RECORD_FIFO_MAX_BYTES];
+    memset(writeTmp, 0, RECORD_FIFO_MAX_BYTES);
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //The schedule is kept as a double so that rounding to TSC ticks does not accumulate
+    double nextRelease = (double) readTSC();
+
+    //Run for specified number of itterations
+    for(int64_t recordsTransfered = 0; recordsTransfered<RECORD_FIFO_RECORDS; recordsTransfered++){
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "+m" (writeTmp)
+        :
+        :);
+
+        //Wait for the record's release time
+        uint64_t releaseTSC;
+        if(paced){
+            releaseTSC = (uint64_t) nextRelease;
+            while(readTSC() < releaseTSC){}
+            nextRelease += pacedNextInterval(profile, intervalTSC, recordsTransfered, &randState);
+        }else{
+            releaseTSC = readTSC();
+        }
+
+        uint32_t recordBytes = padded ? RECORD_FIFO_MAX_BYTES : payloadBytes[recordsTransfered];
+        int64_t recordLines = padded ? RECORD_FIFO_PADDED_LINES : RECORD_FIFO_LINES(recordBytes);
+        //Records are not split across the end of the ring
+        int64_t recordPadLines = RECORD_FIFO_LEN_LINES - writeLine < recordLines ? RECORD_FIFO_LEN_LINES - writeLine : 0;
+        int64_t neededLines = recordPadLines + recordLines;
+
+        //Wait for output FIFO to have space for the pad and the record
+        bool hasSpace = (writeLinesCached + neededLines - readLinesCached <= RECORD_FIFO_LEN_LINES);
+        bool stalled = false;
+        while (!hasSpace)
+        {
+            readLinesCached = atomic_load_explicit(readLinesPtr, memory_order_acquire);
+            hasSpace = (writeLinesCached + neededLines - readLinesCached <= RECORD_FIFO_LEN_LINES);
+
+            //Only a stall if there is still no space once the cached offset is refreshed
+            if(!hasSpace && !stalled){
+                stalled = true;
+                producerStalls++;
+            }
+        }
+
+        //In padded mode, the pad is implicit (the client skips the same lines)
+        if(recordPadLines > 0){
+            if(!padded){
+                record_fifo_hdr_t *padHdr = (record_fifo_hdr_t*) (ringPtr + writeLine*RECORD_FIFO_LINE_BYTES);
+                padHdr->lines = recordPadLines;
+                padHdr->payloadBytes = RECORD_FIFO_PAD;
+            }
+            padLines += recordPadLines;
+            writeLine = 0;
+        }
+
+        //Write into ring
+        uint8_t *record = ringPtr + writeLine*RECORD_FIFO_LINE_BYTES;
+        if(padded){
+            memcpy(record, writeTmp, recordBytes);
+        }else{
+            record_fifo_hdr_t *hdr = (record_fifo_hdr_t*) record;
+            hdr->lines = recordLines;
+            hdr->payloadBytes = recordBytes;
+            memcpy(record + RECORD_FIFO_HDR_BYTES, writeTmp, recordBytes);
+        }
+        writeLine += recordLines;
+        if(writeLine >= RECORD_FIFO_LEN_LINES){
+            writeLine = 0;
+        }
+        writeLinesCached += neededLines;
+        //Update Write Ptr
+        atomic_store_explicit(writeLinesPtr, writeLinesCached, memory_order_release);
+
+        scheduledTSC[recordsTransfered] = releaseTSC;
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    *(args_cast->producerStalls) = producerStalls;
+    *(args_cast->padLines) = padLines;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+void *record_fifo_client_thread(void* args){
+    record_fifo_threadArgs_t *args_cast = (record_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    _Atomic int64_t *readLinesPtr = args_cast->readLinesPtr;
+    _Atomic int64_t *writeLinesPtr = args_cast->writeLinesPtr;
+    uint8_t *ringPtr = args_cast->ringPtr;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    bool padded = args_cast->padded;
+    uint64_t *receivedTSC = args_cast->receivedTSC;
+
+    //==== Setup Input FIFO ====
+    int64_t writeLinesCached = atomic_load_explicit(writeLinesPtr, memory_order_acquire);
+    int64_t readLinesCached = atomic_load_explicit(readLinesPtr, memory_order_acquire);
+    int64_t readLine = readLinesCached % RECORD_FIFO_LEN_LINES; //The position in the ring
+    int64_t receivedBytes = 0;
+    uint8_t readTmp[RECORD_FIFO_MAX_BYTES];
+
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t recordsTransfered = 0; recordsTransfered<RECORD_FIFO_RECORDS; recordsTransfered++){
+        uint8_t *record;
+        uint32_t recordBytes;
+        int64_t recordLines;
+        while(true){
+            //Wait for input FIFO to be ready
+            bool notEmpty = (writeLinesCached != readLinesCached);
+            while (!notEmpty)
+            {
+                writeLinesCached = atomic_load_explicit(writeLinesPtr, memory_order_acquire);
+                notEmpty = (writeLinesCached != readLinesCached);
+            }
+
+            //Skip a pad (the read offset is published with the record after it).  In padded mode, the pad is implicit
+            if(padded){
+                if(RECORD_FIFO_LEN_LINES - readLine < RECORD_FIFO_PADDED_LINES){
+                    readLinesCached += RECORD_FIFO_LEN_LINES - readLine;
+                    readLine = 0;
+                }
+                record = ringPtr + readLine*RECORD_FIFO_LINE_BYTES;
+                recordBytes = RECORD_FIFO_MAX_BYTES;
+                recordLines = RECORD_FIFO_PADDED_LINES;
+                break;
+            }
+            record_fifo_hdr_t *hdr = (record_fifo_hdr_t*) (ringPtr + readLine*RECORD_FIFO_LINE_BYTES);
+            if(hdr->payloadBytes != RECORD_FIFO_PAD){
+                record = ((uint8_t*) hdr) + RECORD_FIFO_HDR_BYTES;
+                recordBytes = hdr->payloadBytes;
+                recordLines = hdr->lines;
+                break;
+            }
+            readLinesCached += hdr->lines;
+            readLine = 0;
+        }
+
+        //Read from ring
+        memcpy(readTmp, record, recordBytes);
+        receivedBytes += recordBytes;
+        readLine += recordLines;
+        if(readLine >= RECORD_FIFO_LEN_LINES){
+            readLine = 0;
+        }
+        readLinesCached += recordLines;
+        //Update Read Ptr
+        atomic_store_explicit(readLinesPtr, readLinesCached, memory_order_release);
+
+        receivedTSC[recordsTransfered] = readTSC();
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        : "+m" (readTmp)
+        :
+        :);
+    }
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    *(args_cast->receivedBytes) = receivedBytes;
+
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+const char* getRecordFifoDistName(int dist){
+    switch(dist){
+        case RECORD_FIFO_DIST_UNIFORM:
+            return "Uniform";
+        case RECORD_FIFO_DIST_BIMODAL:
+            return "Bimodal";
+        case RECORD_FIFO_DIST_FIXED:
+            return "Fixed";
+        default:
+            return "Unknown";
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef _RECORD_FIFO_H
+#define _RECORD_FIFO_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "laminarFifoCommon.h"
+
+/*
+ * A FIFO of variable length records (ex. decoded frames and control messages) instead of fixed size blocks.  The ring is an array of
+ * RECORD_FIFO_LINE_BYTES lines.  Each record starts on a line boundary with a header (record_fifo_hdr_t) followed by its payload, and
+ * occupies as many lines as the header and payload need.
+ *
+ * The offsets are the total number of lines written and read.  They never wrap (the position in the ring is the count modulo the
+ * number of lines) so every line of the ring can be used without the empty/full ambiguity of the Laminar offsets.
+ *
+ * A record is never split across the end of the ring.  If it does not fit in the lines before the end, the server fills them with a
+ * pad record and writes the record at the start of the ring.  The pad and the record are published together.
+ *
+ * In padded mode, every record is a fixed block of RECORD_FIFO_MAX_BYTES (RECORD_FIFO_PADDED_LINES lines) and the full payload is
+ * copied.  Like the blocks of the Laminar FIFO, the size is implicit so there is no header and the pad at the end of the ring (if the
+ * ring is not a multiple of the block) is skipped by both sides without a pad record.  This is the baseline of padding every record to
+ * a fixed block.
+ *
+ * The records are released on the same schedule as the paced FIFO (see pacedFifo.h) so that the latency of each record can be measured
+ */
+
+#define RECORD_FIFO_LINE_BYTES (64)
+
+//The number of records transfered in each run
+#ifndef RECORD_FIFO_RECORDS
+    #define RECORD_FIFO_RECORDS (100000)
+#endif
+
+//The payload size distribution
+#define RECORD_FIFO_DIST_UNIFORM (0) //Uniform between RECORD_FIFO_MIN_BYTES and RECORD_FIFO_MAX_BYTES
+#define RECORD_FIFO_DIST_BIMODAL (1) //RECORD_FIFO_LARGE_PCT percent of the records are RECORD_FIFO_MAX_BYTES, the rest are RECORD_FIFO_MIN_BYTES
+#define RECORD_FIFO_DIST_FIXED (2) //All records are RECORD_FIFO_MAX_BYTES
+
+#ifndef RECORD_FIFO_MIN_BYTES
+    #define RECORD_FIFO_MIN_BYTES (32)
+#endif
+
+//By default the largest record carries the same number of bytes as a block
+#ifndef RECORD_FIFO_MAX_BYTES
+    #define RECORD_FIFO_MAX_BYTES (BLK_SIZE_BYTES)
+#endif
+
+#ifndef RECORD_FIFO_LARGE_PCT
+    #define RECORD_FIFO_LARGE_PCT (10)
+#endif
+
+//Marks a pad record in record_fifo_hdr_t.payloadBytes
+#define RECORD_FIFO_PAD (UINT32_MAX)
+
+typedef struct {
+    uint32_t lines; //The lines the record occupies (including the header)
+    uint32_t payloadBytes; //RECORD_FIFO_PAD for a pad record
+} record_fifo_hdr_t;
+
+#define RECORD_FIFO_HDR_BYTES (sizeof(record_fifo_hdr_t))
+
+//The lines occupied by a record with the given payload
+#define RECORD_FIFO_LINES(payloadBytes) (((payloadBytes)+RECORD_FIFO_HDR_BYTES+RECORD_FIFO_LINE_BYTES-1)/RECORD_FIFO_LINE_BYTES)
+
+//The lines occupied by each record in padded mode (no header)
+#define RECORD_FIFO_PADDED_LINES ((RECORD_FIFO_MAX_BYTES+RECORD_FIFO_LINE_BYTES-1)/RECORD_FIFO_LINE_BYTES)
+
+//The number of lines in the ring.  By default the ring holds FIFO_LEN_BLKS+1 records of RECORD_FIFO_MAX_BYTES (the footprint of the
+//Laminar FIFO array when RECORD_FIFO_MAX_BYTES is the block size)
+#ifndef RECORD_FIFO_LEN_LINES
+    #define RECORD_FIFO_LEN_LINES ((FIFO_LEN_BLKS+1)*RECORD_FIFO_LINES(RECORD_FIFO_MAX_BYTES))
+#endif
+
+_Static_assert(RECORD_FIFO_MIN_BYTES >= 1 && RECORD_FIFO_MIN_BYTES <= RECORD_FIFO_MAX_BYTES, "RECORD_FIFO_MIN_BYTES must be in [1, RECORD_FIFO_MAX_BYTES]");
+_Static_assert(RECORD_FIFO_LARGE_PCT >= 0 && RECORD_FIFO_LARGE_PCT <= 100, "RECORD_FIFO_LARGE_PCT must be in [0, 100]");
+//The server may need to pad up to 1 line less than a record before writing it
+_Static_assert(2*RECORD_FIFO_LINES(RECORD_FIFO_MAX_BYTES)-1 <= RECORD_FIFO_LEN_LINES, "RECORD_FIFO_LEN_LINES must hold a pad and a RECORD_FIFO_MAX_BYTES record");
+
+typedef struct {
+    _Atomic int64_t *readLinesPtr; //Lines read.  Written by the client
+    _Atomic int64_t *writeLinesPtr; //Lines written.  Written by the server
+    uint8_t *ringPtr; //RECORD_FIFO_LEN_LINES lines
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+    bool padded; //Every record is a RECORD_FIFO_MAX_BYTES block without a header
+
+    //Server only
+    uint32_t *payloadBytes; //RECORD_FIFO_RECORDS entries.  The payload size of each record
+    double intervalTSC; //See paced_fifo_threadArgs_t
+    int profile;
+    uint64_t seed;
+    uint64_t *scheduledTSC; //RECORD_FIFO_RECORDS entries
+    int64_t *producerStalls; //The number of records which had to wait for space in the FIFO after being released (still no space after refreshing the cached read offset)
+    int64_t *padLines; //The lines skipped at the end of the ring
+
+    //Client only
+    uint64_t *receivedTSC; //RECORD_FIFO_RECORDS entries
+    int64_t *receivedBytes; //The total payload received
+} record_fifo_threadArgs_t;
+
+/**
+ * Takes record_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *record_fifo_server_thread(void* args);
+
+/**
+ * Takes record_fifo_threadArgs_t, returns a malloc-ed double with the duration
+ */
+void *record_fifo_client_thread(void* args);
+
+/**
+ * Gets the name of a size distribution (ex. Uniform, Bimodal)
+ */
+const char* getRecordFifoDistName(int dist);
+
+#endif
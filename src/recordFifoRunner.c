@@ -0,0 +1,174 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "recordFifoRunner.h"
+#include "pacedFifo.h"
+#include "laminarFifo.h"
+#include "cacheState.h"
+
+static int compareDouble(const void* a, const void* b){
+    double aVal = *((const double*) a);
+    double bVal = *((const double*) b);
+    return (aVal > bVal) - (aVal < bVal);
+}
+
+/**
+ * Nearest rank percentile of a sorted array
+ */
+static double percentile(double* sorted, int64_t len, double pct){
+    int64_t rank = (int64_t) ceil(pct/100.0*len);
+    if(rank < 1){
+        rank = 1;
+    }
+    return sorted[rank-1];
+}
+
+/**
+ * Draws the payload size of each record
+ */
+static void genRecordSizes(uint32_t* payloadBytes, int dist, uint64_t seed){
+    uint64_t randState = seed == 0 ? 1 : seed; //xorshift state must not be 0
+    for(int64_t record = 0; record<RECORD_FIFO_RECORDS; record++){
+        if(dist == RECORD_FIFO_DIST_UNIFORM){
+            payloadBytes[record] = RECORD_FIFO_MIN_BYTES + pacedRand(&randState) % (RECORD_FIFO_MAX_BYTES - RECORD_FIFO_MIN_BYTES + 1);
+        }else if(dist == RECORD_FIFO_DIST_BIMODAL){
+            payloadBytes[record] = pacedRand(&randState) % 100 < RECORD_FIFO_LARGE_PCT ? RECORD_FIFO_MAX_BYTES : RECORD_FIFO_MIN_BYTES;
+        }else if(dist == RECORD_FIFO_DIST_FIXED){
+            payloadBytes[record] = RECORD_FIFO_MAX_BYTES;
+        }else{
+            printf("Unknown record size distribution %d ... exiting\n", dist);
+            exit(1);
+        }
+    }
+}
+
+void writeRecordFifoHeader(FILE* reportFile){
+    fprintf(reportFile, "Level,ServerCPU,ClientCPU,SizeDist,Mode,MinBytes,MaxBytes,MeanPayloadBytes,LenLines,OfferedLoad,TargetRecordsPerSec,Records,PayloadBytes,RingBytes,PadLines,ServerTime,ClientTime,RecordsPerSec,PayloadBytesPerSec,RingBytesPerSec,ProducerStalls,LatencyMeanNs,LatencyP50Ns,LatencyP99Ns,LatencyP999Ns,LatencyMaxNs,CacheState\n");
+}
+
+double runRecordFifoBench(int serverCPU, int clientCPU, const char* level, int dist, bool padded, double targetRecordsPerSec, double offeredLoad, FILE* reportFile){
+    double tscFreqHz = getTSCFreqHz(); //Calibrate before starting the threads
+    int cpus[2] = {serverCPU, clientCPU};
+
+    //Placed like laminarFifoCreate
+    _Atomic int64_t *readLinesPtr = (_Atomic int64_t*) laminarAlloc(sizeof(_Atomic int64_t), clientCPU);
+    _Atomic int64_t *writeLinesPtr = (_Atomic int64_t*) laminarAlloc(sizeof(_Atomic int64_t), serverCPU);
+    uint8_t *ringPtr = (uint8_t*) laminarAlloc(RECORD_FIFO_LEN_LINES*RECORD_FIFO_LINE_BYTES, serverCPU);
+    atomic_init(readLinesPtr, 0);
+    atomic_init(writeLinesPtr, 0);
+
+    //The sizes and timestamp arrays are touched by the arena when allocated so that page faults do not occur durring the timed region
+    uint64_t seed = 0x9E3779B97F4A7C15ULL ^ (((uint64_t) serverCPU) << 32) ^ clientCPU; //The same schedule as the paced FIFO
+    uint32_t *payloadBytes = (uint32_t*) laminarAlloc(sizeof(uint32_t)*RECORD_FIFO_RECORDS, serverCPU);
+    genRecordSizes(payloadBytes, dist, seed);
+    uint64_t *scheduledTSC = (uint64_t*) laminarAlloc(sizeof(uint64_t)*RECORD_FIFO_RECORDS, serverCPU);
+    uint64_t *receivedTSC = (uint64_t*) laminarAlloc(sizeof(uint64_t)*RECORD_FIFO_RECORDS, clientCPU);
+    int64_t *producerStalls = (int64_t*) laminarAlloc(sizeof(int64_t), serverCPU);
+    int64_t *padLines = (int64_t*) laminarAlloc(sizeof(int64_t), serverCPU);
+    int64_t *receivedBytes = (int64_t*) laminarAlloc(sizeof(int64_t), clientCPU);
+
+    laminar_start_barrier_t *barrier = laminarBarrierCreate(cpus, 2);
+
+    double intervalTSC = targetRecordsPerSec > 0 ? tscFreqHz/targetRecordsPerSec : 0;
+
+    record_fifo_threadArgs_t *args[2];
+    for(int i = 0; i<2; i++){
+        args[i] = (record_fifo_threadArgs_t*) laminarAlloc(sizeof(record_fifo_threadArgs_t), cpus[i]);
+        args[i]->readLinesPtr = readLinesPtr;
+        args[i]->writeLinesPtr = writeLinesPtr;
+        args[i]->ringPtr = ringPtr;
+        args[i]->startTrigger = barrier->startTrigger;
+        args[i]->readyFlag = barrier->readyFlags[i];
+        args[i]->padded = padded;
+        args[i]->payloadBytes = payloadBytes;
+        args[i]->intervalTSC = intervalTSC;
+        args[i]->profile = PACED_PROFILE_CONSTANT;
+        args[i]->seed = seed;
+        args[i]->scheduledTSC = scheduledTSC;
+        args[i]->producerStalls = producerStalls;
+        args[i]->padLines = padLines;
+        args[i]->receivedTSC = receivedTSC;
+        args[i]->receivedBytes = receivedBytes;
+    }
+
+    //Set the cache state of the FIFO (see cacheState.h)
+    void* fifoBuffers[3] = {ringPtr, readLinesPtr, writeLinesPtr};
+    size_t fifoBufferSizes[3] = {RECORD_FIFO_LEN_LINES*RECORD_FIFO_LINE_BYTES, sizeof(_Atomic int64_t), sizeof(_Atomic int64_t)};
+    cacheStateBeforeStart(fifoBuffers, fifoBufferSizes, 3, serverCPU, clientCPU);
+
+    laminarThreadStart(serverCPU, record_fifo_server_thread, args[0]);
+    laminarThreadStart(clientCPU, record_fifo_client_thread, args[1]);
+
+    //Start FIFO transfers once all threads are ready
+    laminarBarrierWaitAllReady(barrier);
+    cacheStateBeforeTrigger(fifoBuffers, fifoBufferSizes, 3);
+    laminarBarrierRelease(barrier);
+
+    //Wait for threads to finish
+    double times[2];
+    for(int i = 0; i<2; i++){
+        double *result = (double*) laminarThreadJoin(cpus[i]);
+        times[i] = *result;
+        free(result);
+    }
+
+    //The payload copied (including the padding of padded mode), the useful payload, and the lines occupied in the ring (including pads)
+    long long int payloadSum = 0;
+    long long int usefulBytes = 0;
+    long long int ringLines = *padLines;
+    for(int64_t record = 0; record<RECORD_FIFO_RECORDS; record++){
+        uint32_t recordBytes = padded ? RECORD_FIFO_MAX_BYTES : payloadBytes[record];
+        payloadSum += recordBytes;
+        usefulBytes += payloadBytes[record];
+        ringLines += padded ? RECORD_FIFO_PADDED_LINES : RECORD_FIFO_LINES(recordBytes);
+    }
+    if(*receivedBytes != payloadSum){
+        printf("Record FIFO client received %ld payload bytes, expected %lld ... exiting\n", *receivedBytes, payloadSum);
+        exit(1);
+    }
+
+    //Compute the latency of each record
+    double *latencyNs = (double*) malloc(sizeof(double)*RECORD_FIFO_RECORDS);
+    double latencySum = 0;
+    for(int64_t record = 0; record<RECORD_FIFO_RECORDS; record++){
+        //The TSC is assumed to be invariant and synchronized across cores.  Clamp in case it is slightly skewed
+        double latency = receivedTSC[record] > scheduledTSC[record] ? (receivedTSC[record] - scheduledTSC[record])/tscFreqHz*1.0e9 : 0;
+        latencyNs[record] = latency;
+        latencySum += latency;
+    }
+    qsort(latencyNs, RECORD_FIFO_RECORDS, sizeof(double), compareDouble);
+
+    //Write results
+    double recordsPerSec = RECORD_FIFO_RECORDS/times[1];
+    fprintf(reportFile, "%s,%d,%d,%s,%s,%d,%lu,%f,%lu,%f,%e,%d,%lld,%lld,%ld,%e,%e,%e,%e,%e,%ld,%e,%e,%e,%e,%e,%s\n", level, serverCPU, clientCPU,
+            getRecordFifoDistName(dist), padded ? "Padded" : "Variable", RECORD_FIFO_MIN_BYTES, (size_t) RECORD_FIFO_MAX_BYTES,
+            ((double) usefulBytes)/RECORD_FIFO_RECORDS, (size_t) RECORD_FIFO_LEN_LINES, offeredLoad, targetRecordsPerSec, RECORD_FIFO_RECORDS,
+            usefulBytes, ringLines*RECORD_FIFO_LINE_BYTES, *padLines, times[0], times[1], recordsPerSec, usefulBytes/times[1],
+            ringLines*RECORD_FIFO_LINE_BYTES/times[1], *producerStalls, latencySum/RECORD_FIFO_RECORDS, percentile(latencyNs, RECORD_FIFO_RECORDS, 50),
+            percentile(latencyNs, RECORD_FIFO_RECORDS, 99), percentile(latencyNs, RECORD_FIFO_RECORDS, 99.9), latencyNs[RECORD_FIFO_RECORDS-1],
+            getCacheStateName(CACHE_STATE));
+    fflush(reportFile);
+
+    //Cleanup
+    free(latencyNs);
+    laminarBarrierDestroy(barrier);
+    for(int i = 0; i<2; i++){
+        laminarFree(args[i]);
+    }
+    laminarFree(readLinesPtr);
+    laminarFree(writeLinesPtr);
+    laminarFree(ringPtr);
+    laminarFree(payloadBytes);
+    laminarFree(scheduledTSC);
+    laminarFree(receivedTSC);
+    laminarFree(producerStalls);
+    laminarFree(padLines);
+    laminarFree(receivedBytes);
+
+    return recordsPerSec;
+}
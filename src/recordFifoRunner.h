@@ -0,0 +1,24 @@
+#ifndef _RECORD_FIFO_RUNNER_H
+#define _RECORD_FIFO_RUNNER_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "recordFifo.h"
+
+/**
+ * Runs a variable length record FIFO (see recordFifo.h) from serverCPU to clientCPU and appends a row to reportFile (see writeRecordFifoHeader)
+ * @param level the name of the topology level the CPUs span (reported in each row)
+ * @param dist RECORD_FIFO_DIST_UNIFORM, RECORD_FIFO_DIST_BIMODAL, or RECORD_FIFO_DIST_FIXED.  The sizes are drawn before the threads start
+ * @param padded if true, every record is padded to a RECORD_FIFO_MAX_BYTES block without a header (the fixed block baseline)
+ * @param targetRecordsPerSec the mean rate at which the server releases records.  0 releases records as fast as the FIFO allows
+ * @param offeredLoad the fraction of capacity targetRecordsPerSec corresponds to (reported in each row)
+ * @returns the rate (records/s) achieved by the client
+ */
+double runRecordFifoBench(int serverCPU, int clientCPU, const char* level, int dist, bool padded, double targetRecordsPerSec, double offeredLoad, FILE* reportFile);
+
+/**
+ * Writes the header for the rows appended by runRecordFifoBench
+ */
+void writeRecordFifoHeader(FILE* reportFile);
+
+#endif
@@ -0,0 +1,20 @@
+#include <stdlib.h>
+#include <string.h>
+#include "reportHelpers.h"
+
+char* genDerivedReportName(const char* reportFilename, const char* tag){
+    const char* ext = ".csv";
+    int baseLen = strlen(reportFilename);
+    int extLen = strlen(ext);
+    if(baseLen >= extLen && strcmp(reportFilename+baseLen-extLen, ext) == 0){
+        baseLen -= extLen;
+    }
+
+    int reportNameLen = baseLen + strlen(tag) + extLen + 1; //+1 For EOL
+    char* reportName = malloc(reportNameLen*sizeof(char));
+    strncpy(reportName, reportFilename, baseLen);
+    reportName[baseLen] = '\0';
+    strcat(reportName, tag);
+    strcat(reportName, ext);
+    return reportName;
+}
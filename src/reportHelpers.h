@@ -0,0 +1,12 @@
+#ifndef _REPORT_HELPERS_H
+#define _REPORT_HELPERS_H
+
+/**
+ * Generates the name of a secondary report derived from a primary report filename.
+ * The tag is inserted before the .csv extension (if present). ex. report_x.csv + _timeSeries -> report_x_timeSeries.csv
+ * 
+ * Note: This function allocates a new string which should be freed after use
+ */
+char* genDerivedReportName(const char* reportFilename, const char* tag);
+
+#endif
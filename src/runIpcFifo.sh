@@ -0,0 +1,27 @@
+#!/bin/bash
+set -e
+
+#Runs the inter-process FIFO benchmark (see ipcFifo.h) with the server and client in seperate commCharaterize processes.
+#The server process also runs the in-process FIFO on the same cores for comparison (<report>_inProcess.csv)
+#Build with IPC_FIFO_HUGE_PAGES=1 to place the FIFO on hugetlbfs (requires huge pages to be reserved)
+#Usage: ./runIpcFifo.sh <reportPrefix> <serverCPU> <clientCPU> [shmName]
+
+RPTPREFIX=$1
+SERVER_CPU=$2
+CLIENT_CPU=$3
+SHM_NAME=$4
+
+if [[ -z ${SHM_NAME} ]]; then
+    SHM_NAME=laminarIpcFifo
+fi
+
+#Remove any mapping left behind by an aborted run so the client does not attach to it
+rm -f /dev/shm/${SHM_NAME}
+rm -f /dev/hugepages/${SHM_NAME}
+
+REPORT=${RPTPREFIX}_ipcFifo_serverCPU-${SERVER_CPU}_clientCPU-${CLIENT_CPU}.csv
+
+./commCharaterize --ipc-server ${SHM_NAME} ${SERVER_CPU} ${REPORT} &
+SERVER_PID=$!
+./commCharaterize --ipc-client ${SHM_NAME} ${CLIENT_CPU}
+wait ${SERVER_PID}
@@ -16,6 +16,7 @@ from slackUtils import *
 TARGET_BYTES: int = 1000000000
 # TARGET_BYTES: int = 10000000 #For testing clflush 
 UNIT_SIZE: int = 4*2 #Complex floats (8 bytes) are the unit described in the FIFO structure
+SAMPLE_TYPE_UNIT_SIZES: typing.Final[typing.Dict[int, int]] = {0: 4*2, 1: 1*2, 2: 2*2, 3: 8*2} #Complex sample size for each FIFO_BLK_SAMPLE_TYPE (see laminarFifoParams.h)
 #Need these to be in increments of 256 bits (or 32 bytes, or 4 complex floats)
 BLK_SIZE_START: int = 4 #These are in UNIT_SIZE
 #BLK_SIZE_END: int = 513 #These are in UNIT_SIZE
@@ -31,8 +32,18 @@ def main():
     #Parse CLI Arguments for Config File Location
     parser = argparse.ArgumentParser(description='Runs a sweep of the Laminar Comm Characterize test')
     parser.add_argument('--name', type=str, required=True, help='The directory in which the resuts of Laminar Comm Characterize will be located')
+    parser.add_argument('--consumer-prefetch-dist', type=int, default=0, help='FIFO_CONSUMER_PREFETCH_DIST_BLKS (see fifoHints.h).  0 disables consumer prefetching')
+    parser.add_argument('--consumer-prefetch-hint', type=int, default=0, choices=[0, 1], help='FIFO_CONSUMER_PREFETCH_HINT (0: prefetcht0, 1: prefetchw)')
+    parser.add_argument('--producer-hint', type=int, default=0, choices=[0, 1, 2], help='FIFO_PRODUCER_HINT (0: none, 1: cldemote, 2: clwb)')
+    parser.add_argument('--ports', type=int, default=1, help='FIFO_BLK_PORTS (see laminarFifoParams.h).  The swept block size is per port')
+    parser.add_argument('--layout', type=int, default=0, choices=[0, 1], help='FIFO_BLK_LAYOUT (0: planar, 1: interleaved)')
+    parser.add_argument('--port-pad', type=int, default=0, choices=[0, 1], help='FIFO_BLK_PORT_PAD (1: start each port on a cache line)')
+    parser.add_argument('--sample-type', type=int, default=0, choices=[0, 1, 2, 3], help='FIFO_BLK_SAMPLE_TYPE (0: float, 1: int8, 2: int16, 3: double).  The swept block size is in complex samples of this type')
+    parser.add_argument('--consume', type=int, default=0, choices=[0, 1], help='FIFO_BLK_CONSUME (1: the client and memory reader accumulate the power of each block)')
     args = parser.parse_args()
     name = args.name
+    hintDefines = f'FIFO_CONSUMER_PREFETCH_DIST_BLKS={args.consumer_prefetch_dist:d} FIFO_CONSUMER_PREFETCH_HINT={args.consumer_prefetch_hint:d} FIFO_PRODUCER_HINT={args.producer_hint:d}'
+    layoutDefines = f'FIFO_BLK_PORTS={args.ports:d} FIFO_BLK_LAYOUT={args.layout:d} FIFO_BLK_PORT_PAD={args.port_pad:d} FIFO_BLK_CONSUME={args.consume:d} FIFO_BLK_SAMPLE_TYPE={args.sample_type:d}'
 
     hostname = platform.node()
 
@@ -45,7 +56,7 @@ def main():
 
     for (i, blkSize) in enumerate(blkSizes):
         cur_time = datetime.datetime.now()
-        blkSizeBytes = blkSize*UNIT_SIZE
+        blkSizeBytes = blkSize*SAMPLE_TYPE_UNIT_SIZES[args.sample_type]*args.ports #Payload (excludes any port padding)
         blockTransactions = math.ceil(TARGET_BYTES/float(blkSizeBytes))
         bytesSent = blockTransactions*blkSizeBytes
 
@@ -58,7 +69,7 @@ def main():
         #Build new version
         fifoTestEn = '1' if RUN_FIFO_TESTS else '0'
         memTestEn = '1' if RUN_MEM_TESTS else '0'
-        cmd = f'FIFO_BLK_SIZE_CPLX_FLOAT={blkSize:d} TRANSACTIONS_BLKS={blockTransactions:d} FIFO_TESTS={fifoTestEn} MEM_TESTS={memTestEn} ./build.sh'
+        cmd = f'FIFO_BLK_SIZE_CPLX_FLOAT={blkSize:d} TRANSACTIONS_BLKS={blockTransactions:d} FIFO_TESTS={fifoTestEn} MEM_TESTS={memTestEn} {hintDefines} {layoutDefines} ./build.sh'
         print('\nRunning: {}\n'.format(cmd))
         rtn = subprocess.call(cmd, shell=True, executable='/bin/bash')
         if rtn != 0:
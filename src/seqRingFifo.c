@@ -0,0 +1,171 @@
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <string.h>
+#include "seqRingFifo.h"
+#include "timeHelpers.h"
+#include "testParams.h"
+#include "bufferArena.h"
+
+static void* seq_ring_init(int serverCore, int clientCore){
+    seq_ring_fifo_t *fifo = (seq_ring_fifo_t*) bufferArenaAlloc(sizeof(seq_ring_fifo_t), serverCore);
+    fifo->slots = (seq_ring_slot_t*) bufferArenaAlloc(sizeof(seq_ring_slot_t)*SPSC_FIFO_SLOTS, serverCore);
+
+    //Slot i is free for the producer's i-th write
+    for(int i = 0; i<SPSC_FIFO_SLOTS; i++){
+        atomic_init(&(fifo->slots[i].seq), i);
+    }
+    if(!atomic_is_lock_free(&(fifo->slots[0].seq))){
+        printf("Warning: A sequence ring slot sequence number was expected to be lock free but is not\n");
+    }
+
+    return fifo;
+}
+
+static void seq_ring_cleanup(void* fifo_uncast){
+    seq_ring_fifo_t *fifo = (seq_ring_fifo_t*) fifo_uncast;
+    bufferArenaFree(fifo->slots);
+    bufferArenaFree(fifo);
+}
+
+static int seq_ring_get_buffers(void* fifo_uncast, void** buffers, size_t* sizes){
+    seq_ring_fifo_t *fifo = (seq_ring_fifo_t*) fifo_uncast;
+    buffers[0] = fifo->slots;
+    sizes[0] = sizeof(seq_ring_slot_t)*SPSC_FIFO_SLOTS;
+    return 1;
+}
+
+static void *seq_ring_server_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    seq_ring_fifo_t *fifo = (seq_ring_fifo_t*) args_cast->fifo;
+    seq_ring_slot_t *slots = fifo->slots;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    uint64_t pos = 0; //Private to the producer, never wraps
+    int slot = 0; //pos % SPSC_FIFO_SLOTS
+    PartitionCrossingFIFO_t writeTmp;
+    memset(&writeTmp, 0, sizeof(PartitionCrossingFIFO_t));
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //Try to make sure the copy is not optimized out by signalling to compiler that the write tmp is modified.  It is not actually modified
+        asm volatile(""
+        : "=rm" (writeTmp)
+        : 
+        :);
+
+        //The slot is free for this write once the consumer has set its sequence number to pos
+        while(atomic_load_explicit(&(slots[slot].seq), memory_order_acquire) != pos){}
+
+        copyBlkToFifo(&(slots[slot].blk), &writeTmp);
+        atomic_store_explicit(&(slots[slot].seq), pos+1, memory_order_release);
+
+        pos++;
+        slot = slot >= SPSC_FIFO_SLOTS-1 ? 0 : slot+1;
+    }
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+static void *seq_ring_client_thread(void* args){
+    spsc_fifo_threadArgs_t *args_cast = (spsc_fifo_threadArgs_t *)args;
+
+    //==== Get Arguments ====
+    seq_ring_fifo_t *fifo = (seq_ring_fifo_t*) args_cast->fifo;
+    seq_ring_slot_t *slots = fifo->slots;
+    _Atomic bool *startTrigger = args_cast->startTrigger;
+    atomic_flag *readyFlag = args_cast->readyFlag;
+    time_series_t *timeSeries = args_cast->timeSeries;
+
+    //==== Setup ====
+    uint64_t pos = 0; //Private to the consumer, never wraps
+    int slot = 0; //pos % SPSC_FIFO_SLOTS
+    PartitionCrossingFIFO_t readTmp;
+
+    spscFifoWaitForStart(readyFlag, startTrigger);
+
+    //==== Start Test ====
+    //Start timer
+    timespec_t startTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Run for specified number of itterations
+    for(int64_t blksTransfered = 0; blksTransfered<TRANSACTIONS_BLKS; blksTransfered++){
+        #if TIME_SERIES_EN
+            timeSeriesRecord(timeSeries, blksTransfered);
+        #endif
+
+        //The slot holds the block for this read once the producer has set its sequence number to pos+1
+        while(atomic_load_explicit(&(slots[slot].seq), memory_order_acquire) != pos+1){}
+
+        copyBlkFromFifo(&readTmp, &(slots[slot].blk));
+        atomic_store_explicit(&(slots[slot].seq), pos+SPSC_FIFO_SLOTS, memory_order_release);
+
+        pos++;
+        slot = slot >= SPSC_FIFO_SLOTS-1 ? 0 : slot+1;
+
+        //Need to make sure that the memory copy is not optimized out if the content is not checked
+        asm volatile(""
+        :
+        : "rm" (readTmp)
+        :);
+    }
+
+    #if TIME_SERIES_EN
+        timeSeriesRecordFinal(timeSeries, TRANSACTIONS_BLKS);
+    #endif
+
+    timespec_t stopTime;
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+    clock_gettime(CLOCK_MONOTONIC, &stopTime);
+    asm volatile("" ::: "memory"); //Stop Re-ordering of timer
+
+    //Return results
+    double* duration = malloc(sizeof(double));
+    *duration = difftimespec(&stopTime, &startTime);
+    return duration;
+}
+
+const spsc_fifo_impl_t SEQ_RING_FIFO_IMPL = {
+    .name = "seqRing",
+    .init = seq_ring_init,
+    .cleanup = seq_ring_cleanup,
+    .getBuffers = seq_ring_get_buffers,
+    .server_thread = seq_ring_server_thread,
+    .client_thread = seq_ring_client_thread
+};
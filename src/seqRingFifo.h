@@ -0,0 +1,24 @@
+#ifndef _SEQ_RING_FIFO_H
+#define _SEQ_RING_FIFO_H
+
+#include "spscFifoCommon.h"
+#include "testParams.h"
+
+/*
+ * Sequence number per slot ring (as in Vyukov's bounded queue, specialized for a single producer and consumer)
+ * Each slot carries a 64 bit sequence number.  The producer's n-th write may proceed when the slot's sequence number is n and sets it to n+1.
+ * The consumer's n-th read may proceed when the slot's sequence number is n+1 and sets it to n+SPSC_FIFO_SLOTS.
+ */
+
+typedef struct {
+    PartitionCrossingFIFO_t blk;
+    _Atomic uint64_t seq __attribute__((aligned(VITIS_MEM_ALIGNMENT))); //On its own line after the block
+} seq_ring_slot_t;
+
+typedef struct {
+    seq_ring_slot_t *slots; //SPSC_FIFO_SLOTS, allocated on the server core
+} seq_ring_fifo_t;
+
+extern const spsc_fifo_impl_t SEQ_RING_FIFO_IMPL;
+
+#endif
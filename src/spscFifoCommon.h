@@ -0,0 +1,54 @@
+#ifndef _SPSC_FIFO_COMMON_H
+#define _SPSC_FIFO_COMMON_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "laminarFifoCommon.h"
+#include "timeSeries.h"
+#include "fifoCopy.h"
+
+//Alternative single producer single consumer FIFO algorithms benchmarked against the Laminar FIFO.
+//All transact in the same blocks as the Laminar FIFO (PartitionCrossingFIFO_t) and have FIFO_LEN_BLKS+1 slots
+
+#ifndef ALT_FIFO_TESTS
+    #define ALT_FIFO_TESTS 0
+#endif
+
+#define SPSC_FIFO_SLOTS (FIFO_LEN_BLKS+1)
+
+//The maximum number of separately allocated shared buffers in a FIFO (see getBuffers)
+#define SPSC_FIFO_MAX_BUFFERS (4)
+
+typedef struct {
+    void *fifo; //The algorithm specific FIFO state.  This is shared by the server and client
+    _Atomic bool *startTrigger; //This is shared by all threads
+    atomic_flag *readyFlag; //This is unique to each thread
+    time_series_t *timeSeries; //This is unique to each thread.  Only used if TIME_SERIES_EN
+} spsc_fifo_threadArgs_t;
+
+typedef struct {
+    const char* name;
+    void* (*init)(int serverCore, int clientCore); //Allocates and initializes the FIFO state
+    void (*cleanup)(void* fifo);
+    int (*getBuffers)(void* fifo, void** buffers, size_t* sizes); //Lists the shared buffers so the cache state can be set (see cacheState.h).  Returns the number of buffers (at most SPSC_FIFO_MAX_BUFFERS)
+    void* (*server_thread)(void* args); //Takes spsc_fifo_threadArgs_t, returns a malloc-ed double with the duration
+    void* (*client_thread)(void* args); //Takes spsc_fifo_threadArgs_t, returns a malloc-ed double with the duration
+} spsc_fifo_impl_t;
+
+/**
+ * Signals that the calling thread is ready then waits for the start trigger
+ */
+static inline void spscFifoWaitForStart(atomic_flag *readyFlag, _Atomic bool *startTrigger){
+    //==== Signal Ready ====
+    atomic_thread_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(readyFlag, memory_order_release);
+
+    //==== Wait for trigger ====
+    bool go = false;
+    while (!go){
+        go = atomic_load_explicit(startTrigger, memory_order_acquire);
+        atomic_thread_fence(memory_order_release);
+    }
+}
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "spscFifoRunner.h"
+#include "laminarFifoRunner.h"
+#include "testParams.h"
+#include "workerPool.h"
+#include "bufferArena.h"
+#include "vitisNumaAllocHelpers.h"
+#include "cacheState.h"
+
+static spsc_fifo_runner_thread_vars_t* startSpscThread(void* fifo, _Atomic bool* startTrigger, atomic_flag *readyFlag, int core, void* (*thread_fun)(void*)){
+    spsc_fifo_runner_thread_vars_t *threadVars = (spsc_fifo_runner_thread_vars_t*) bufferArenaAlloc(sizeof(spsc_fifo_runner_thread_vars_t), core);
+    threadVars->core = core;
+    threadVars->args.fifo = fifo;
+    threadVars->args.startTrigger = startTrigger;
+    threadVars->args.readyFlag = readyFlag;
+    #if TIME_SERIES_EN
+        threadVars->args.timeSeries = initTimeSeries(core);
+    #else
+        threadVars->args.timeSeries = NULL;
+    #endif
+
+    workerPoolSubmit(core, thread_fun, &(threadVars->args));
+
+    return threadVars;
+}
+
+static atomic_flag* initReadyFlag(int core){
+    atomic_flag *flag = (atomic_flag*) bufferArenaAlloc(sizeof(atomic_flag), core);
+    atomic_signal_fence(memory_order_acquire);
+    atomic_flag_clear_explicit(flag, memory_order_release); //Init since this was malloc-ed
+    atomic_flag_test_and_set_explicit(flag, memory_order_acq_rel);
+    return flag;
+}
+
+void runSpscFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename, const spsc_fifo_impl_t *impl){
+    //Create FIFOs
+    void* fifos[numFIFOs];
+    atomic_flag *serverReadyFlag[numFIFOs];
+    atomic_flag *clientReadyFlag[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        fifos[i] = impl->init(serverCPUs[i], clientCPUs[i]);
+        serverReadyFlag[i] = initReadyFlag(serverCPUs[i]);
+        clientReadyFlag[i] = initReadyFlag(clientCPUs[i]);
+    }
+
+    //Set the cache state of the FIFOs (see cacheState.h)
+    void* fifoBuffers[numFIFOs][SPSC_FIFO_MAX_BUFFERS];
+    size_t fifoBufferSizes[numFIFOs][SPSC_FIFO_MAX_BUFFERS];
+    int numFifoBuffers[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        numFifoBuffers[i] = impl->getBuffers(fifos[i], fifoBuffers[i], fifoBufferSizes[i]);
+        cacheStateBeforeStart(fifoBuffers[i], fifoBufferSizes[i], numFifoBuffers[i], serverCPUs[i], clientCPUs[i]);
+    }
+
+    //Create starting trigger
+    _Atomic bool* startTrigger = (_Atomic bool*) vitis_aligned_alloc(VITIS_MEM_ALIGNMENT, sizeof(_Atomic bool));
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, false, memory_order_release);
+
+    //Start Threads
+    spsc_fifo_runner_thread_vars_t *serverThreadVars[numFIFOs];
+    spsc_fifo_runner_thread_vars_t *clientThreadVars[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        serverThreadVars[i] = startSpscThread(fifos[i], startTrigger, serverReadyFlag[i], serverCPUs[i], impl->server_thread);
+        clientThreadVars[i] = startSpscThread(fifos[i], startTrigger, clientReadyFlag[i], clientCPUs[i], impl->client_thread);
+    }
+
+    //Wait for all threads ready
+    for(int i = 0; i<numFIFOs; i++){
+        bool wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(serverReadyFlag[i], memory_order_acq_rel);
+        }
+        wait = true;
+        while(wait){
+            wait = atomic_flag_test_and_set_explicit(clientReadyFlag[i], memory_order_acq_rel);
+        }
+    }
+
+    for(int i = 0; i<numFIFOs; i++){
+        cacheStateBeforeTrigger(fifoBuffers[i], fifoBufferSizes[i], numFifoBuffers[i]);
+    }
+
+    //Start FIFO transfers
+    atomic_signal_fence(memory_order_acquire);
+    atomic_store_explicit(startTrigger, true, memory_order_release);
+
+    //Wait for threads to finish
+    double serverTimes[numFIFOs];
+    double clientTimes[numFIFOs];
+    for(int i = 0; i<numFIFOs; i++){
+        double *serverResult = (double*) workerPoolJoin(serverThreadVars[i]->core);
+        serverTimes[i] = *serverResult;
+        free(serverResult);
+
+        double *clientResult = (double*) workerPoolJoin(clientThreadVars[i]->core);
+        clientTimes[i] = *clientResult;
+        free(clientResult);
+    }
+
+    //Write results
+    //The frequency is not sampled for the alternative FIFOs
+    writeResults(serverCPUs, clientCPUs, serverTimes, clientTimes, numFIFOs, getCacheStateName(CACHE_STATE), NULL, reportFilename);
+    #if TIME_SERIES_EN
+        time_series_t *serverTimeSeries[numFIFOs];
+        time_series_t *clientTimeSeries[numFIFOs];
+        for(int i = 0; i<numFIFOs; i++){
+            serverTimeSeries[i] = serverThreadVars[i]->args.timeSeries;
+            clientTimeSeries[i] = clientThreadVars[i]->args.timeSeries;
+        }
+        writeTimeSeriesResults(serverTimeSeries, clientTimeSeries, serverCPUs, clientCPUs, numFIFOs, reportFilename);
+    #endif
+
+    //Cleanup
+    for(int i = 0; i<numFIFOs; i++){
+        bufferArenaFree(serverThreadVars[i]->args.timeSeries);
+        bufferArenaFree(clientThreadVars[i]->args.timeSeries);
+        bufferArenaFree(serverThreadVars[i]);
+        bufferArenaFree(clientThreadVars[i]);
+        bufferArenaFree(serverReadyFlag[i]);
+        bufferArenaFree(clientReadyFlag[i]);
+        impl->cleanup(fifos[i]);
+    }
+    free(startTrigger);
+}
@@ -0,0 +1,21 @@
+#ifndef _SPSC_FIFO_RUNNER_H
+#define _SPSC_FIFO_RUNNER_H
+
+#include "spscFifoCommon.h"
+
+typedef struct {
+    int core; //The worker pool core the thread runs on
+    spsc_fifo_threadArgs_t args;
+} spsc_fifo_runner_thread_vars_t;
+
+/**
+ * Runs an alternative FIFO algorithm with the same harness (pinned worker threads, start trigger, reporting) as runLaminarFifoBench
+ * @param serverCPUs a list of CPUs to serve as the server side of FIFOs.  Each server CPU is pared with a client CPU in clientCPUs
+ * @param clientCPUs a list of CPUs to serve as the client side of FIFOs.  Each server CPU is pared with a server CPU in serverCPUs
+ * @param numFIFOs the number of FIFOs (also the size of serverCPUs and clientCPUs)
+ * @param reportFilename
+ * @param impl the FIFO algorithm
+ */
+void runSpscFifoBench(int *serverCPUs, int *clientCPUs, int numFIFOs, char* reportFilename, const spsc_fifo_impl_t *impl);
+
+#endif
@@ -4,6 +4,10 @@
 
 #include "timeHelpers.h"
 
+#ifndef TSC_CALIBRATION_SEC
+    #define TSC_CALIBRATION_SEC (0.1)
+#endif
+
 double difftimespec(timespec_t* a, timespec_t* b){
     return (a->tv_sec - b->tv_sec) + ((double) (a->tv_nsec - b->tv_nsec))*(0.000000001);
 }
@@ -11,3 +15,26 @@ double timespecToDouble(timespec_t* a){
     double a_double = a->tv_sec + (a->tv_nsec)*(0.000000001);
     return a_double;
 }
+
+double getTSCFreqHz(){
+    static double tscFreqHz = 0;
+
+    if(tscFreqHz == 0){
+        timespec_t startTime;
+        timespec_t stopTime;
+
+        clock_gettime(CLOCK_MONOTONIC, &startTime);
+        uint64_t startTSC = readTSC();
+        double elapsed = 0;
+        uint64_t stopTSC;
+        do{
+            clock_gettime(CLOCK_MONOTONIC, &stopTime);
+            stopTSC = readTSC();
+            elapsed = difftimespec(&stopTime, &startTime);
+        }while(elapsed < TSC_CALIBRATION_SEC);
+
+        tscFreqHz = (stopTSC - startTSC)/elapsed;
+    }
+
+    return tscFreqHz;
+}
@@ -2,9 +2,25 @@
 #define _TIME_HELPERS_H
 
 #include <time.h>
+#include <stdint.h>
+#include <x86intrin.h>
 
 typedef struct timespec timespec_t;
 double difftimespec(timespec_t* a, timespec_t* b);
 double timespecToDouble(timespec_t* a);
 
-#endif
\ No newline at end of file
+/**
+ * Reads the timestamp counter.  Not serializing, intended for low overhead sampling inside benchmark loops.
+ * Assumes an invariant TSC (constant rate across cores and P-states)
+ */
+static inline uint64_t readTSC(){
+    return __rdtsc();
+}
+
+/**
+ * Returns the TSC frequency in Hz.  Calibrated against CLOCK_MONOTONIC on the first call and cached after that.
+ * Should be called outside of timed regions.
+ */
+double getTSCFreqHz();
+
+#endif
@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+#include "timeSeries.h"
+#include "testParams.h"
+#include "bufferArena.h"
+
+time_series_t* initTimeSeries(int core){
+    //The arena touches the ring when it is first allocated so that page faults do not occur durring the timed region
+    time_series_t* timeSeries = (time_series_t*) bufferArenaAlloc(sizeof(time_series_t), core);
+    timeSeries->numSamples = 0;
+    timeSeries->finalTSC = 0;
+    timeSeries->finalBlks = 0;
+    return timeSeries;
+}
+
+void writeTimeSeriesHeader(FILE* timeSeriesFile, FILE* summaryFile){
+    fprintf(timeSeriesFile, "Role,CPU,Interval,StartBlk,EndBlk,StartTSC,EndTSC,IntervalTime,IntervalBytes\n");
+    fprintf(summaryFile, "Role,CPU,Intervals,DroppedSamples,MeanRateBytesPerSec,StdDevRateBytesPerSec,CoVRate,MinRateBytesPerSec,MaxRateBytesPerSec,MaxIntervalTime\n");
+}
+
+void writeTimeSeries(FILE* timeSeriesFile, FILE* summaryFile, const char* role, int cpu, time_series_t *timeSeries, long long int bytesPerBlk){
+    double tscFreqHz = getTSCFreqHz();
+
+    //The ring may have wrapped, only the last TIME_SERIES_MAX_SAMPLES are available
+    int64_t firstSample = timeSeries->numSamples > TIME_SERIES_MAX_SAMPLES ? timeSeries->numSamples - TIME_SERIES_MAX_SAMPLES : 0;
+
+    //Running stats over the full length intervals (the final interval is typically partial and is excluded)
+    int64_t fullIntervals = 0;
+    double rateSum = 0;
+    double rateSqSum = 0;
+    double rateMin = INFINITY;
+    double rateMax = 0;
+    double maxIntervalTime = 0;
+
+    int64_t interval = 0;
+    for(int64_t sample = firstSample; sample<timeSeries->numSamples; sample++){
+        uint64_t startTSC = timeSeries->samples[sample & (TIME_SERIES_MAX_SAMPLES-1)];
+        int64_t startBlk = sample*TIME_SERIES_PERIOD_BLKS;
+        uint64_t endTSC;
+        int64_t endBlk;
+        bool fullInterval;
+        if(sample+1<timeSeries->numSamples){
+            endTSC = timeSeries->samples[(sample+1) & (TIME_SERIES_MAX_SAMPLES-1)];
+            endBlk = startBlk+TIME_SERIES_PERIOD_BLKS;
+            fullInterval = true;
+        }else{
+            endTSC = timeSeries->finalTSC;
+            endBlk = timeSeries->finalBlks;
+            fullInterval = false;
+        }
+
+        if(endBlk <= startBlk){
+            continue;
+        }
+
+        double intervalTime = (endTSC-startTSC)/tscFreqHz;
+        long long int intervalBytes = (endBlk-startBlk)*bytesPerBlk;
+        fprintf(timeSeriesFile, "%s,%d,%ld,%ld,%ld,%lu,%lu,%e,%lld\n", role, cpu, interval, startBlk, endBlk, startTSC, endTSC, intervalTime, intervalBytes);
+        interval++;
+
+        if(fullInterval){
+            double rate = intervalBytes/intervalTime;
+            fullIntervals++;
+            rateSum += rate;
+            rateSqSum += rate*rate;
+            rateMin = rate < rateMin ? rate : rateMin;
+            rateMax = rate > rateMax ? rate : rateMax;
+            maxIntervalTime = intervalTime > maxIntervalTime ? intervalTime : maxIntervalTime;
+        }
+    }
+
+    double rateMean = NAN;
+    double rateStdDev = NAN;
+    if(fullIntervals > 0){
+        rateMean = rateSum/fullIntervals;
+        double rateVar = rateSqSum/fullIntervals - rateMean*rateMean;
+        rateStdDev = sqrt(rateVar > 0 ? rateVar : 0);
+    }else{
+        rateMin = NAN;
+        rateMax = NAN;
+    }
+
+    fprintf(summaryFile, "%s,%d,%ld,%ld,%e,%e,%e,%e,%e,%e\n", role, cpu, fullIntervals, firstSample, rateMean, rateStdDev, rateStdDev/rateMean, rateMin, rateMax, maxIntervalTime);
+}
@@ -0,0 +1,64 @@
+#ifndef _TIME_SERIES_H
+#define _TIME_SERIES_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "timeHelpers.h"
+
+//Records a TSC timestamp every 2^TIME_SERIES_PERIOD_LOG2_BLKS blocks so that throttling/stalls durring a run can be seen
+#ifndef TIME_SERIES_EN
+    #define TIME_SERIES_EN (0)
+#endif
+
+#ifndef TIME_SERIES_PERIOD_LOG2_BLKS
+    #define TIME_SERIES_PERIOD_LOG2_BLKS (14)
+#endif
+
+//Must be a power of 2.  If more samples are taken, the oldest samples are overwritten
+#ifndef TIME_SERIES_MAX_SAMPLES
+    #define TIME_SERIES_MAX_SAMPLES (8192)
+#endif
+
+#define TIME_SERIES_PERIOD_BLKS (((int64_t) 1) << TIME_SERIES_PERIOD_LOG2_BLKS)
+
+_Static_assert((TIME_SERIES_MAX_SAMPLES & (TIME_SERIES_MAX_SAMPLES-1)) == 0, "TIME_SERIES_MAX_SAMPLES must be a power of 2");
+
+typedef struct {
+    uint64_t samples[TIME_SERIES_MAX_SAMPLES]; //Ring of TSC timestamps.  Sample i was taken before block i*TIME_SERIES_PERIOD_BLKS was transfered
+    int64_t numSamples; //Total number of samples taken (may be > TIME_SERIES_MAX_SAMPLES if the ring wrapped)
+    uint64_t finalTSC; //TSC after the last block was transfered
+    int64_t finalBlks; //Number of blocks transfered when finalTSC was taken
+} time_series_t;
+
+/**
+ * Allocates the sample ring on the given core.  Free with bufferArenaFree()
+ */
+time_series_t* initTimeSeries(int core);
+
+/**
+ * Call at the top of each block itteration (after the start trigger)
+ */
+static inline void timeSeriesRecord(time_series_t *timeSeries, int64_t blksTransfered){
+    if((blksTransfered & (TIME_SERIES_PERIOD_BLKS-1)) == 0){
+        timeSeries->samples[timeSeries->numSamples & (TIME_SERIES_MAX_SAMPLES-1)] = readTSC();
+        timeSeries->numSamples++;
+    }
+}
+
+/**
+ * Call after the last block was transfered
+ */
+static inline void timeSeriesRecordFinal(time_series_t *timeSeries, int64_t blksTransfered){
+    timeSeries->finalTSC = readTSC();
+    timeSeries->finalBlks = blksTransfered;
+}
+
+void writeTimeSeriesHeader(FILE* timeSeriesFile, FILE* summaryFile);
+
+/**
+ * Writes the interval throughput of a single thread's time series to timeSeriesFile and a summary of the interval rate variation to summaryFile
+ * @param role a label for the thread (ex. Server, Client, Reader)
+ */
+void writeTimeSeries(FILE* timeSeriesFile, FILE* summaryFile, const char* role, int cpu, time_series_t *timeSeries, long long int bytesPerBlk);
+
+#endif
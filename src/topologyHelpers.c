@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include "topologyHelpers.h"
+
+#define TOPOLOGY_MAX_CPUS (1024)
+
+int readCPUList(const char* path, int* cpus, int maxCPUs){
+    FILE* listFile = fopen(path, "r");
+    if(listFile == NULL){
+        return -1;
+    }
+
+    int count = 0;
+    int first, last;
+    while(fscanf(listFile, "%d", &first) == 1){
+        last = first;
+        int sep = fgetc(listFile);
+        if(sep == '-'){
+            if(fscanf(listFile, "%d", &last) != 1){
+                break;
+            }
+            sep = fgetc(listFile);
+        }
+        for(int cpu = first; cpu<=last; cpu++){
+            if(count<maxCPUs){
+                cpus[count] = cpu;
+            }
+            count++;
+        }
+        if(sep != ','){
+            break;
+        }
+    }
+
+    fclose(listFile);
+    return count;
+}
+
+int getSmtSiblings(int core, int* siblings, int maxSiblings){
+    char path[100];
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", core);
+
+    int threads[TOPOLOGY_MAX_CPUS];
+    int numThreads = readCPUList(path, threads, TOPOLOGY_MAX_CPUS);
+    if(numThreads > TOPOLOGY_MAX_CPUS){
+        numThreads = TOPOLOGY_MAX_CPUS;
+    }
+
+    int numSiblings = 0;
+    for(int i = 0; i<numThreads; i++){
+        if(threads[i] != core){
+            if(numSiblings<maxSiblings){
+                siblings[numSiblings] = threads[i];
+            }
+            numSiblings++;
+        }
+    }
+
+    return numSiblings;
+}
+
+int getFirstSmtSibling(int core){
+    int sibling;
+    int numSiblings = getSmtSiblings(core, &sibling, 1);
+    return numSiblings > 0 ? sibling : -1;
+}
+
+/**
+ * Reads a single integer from a sysfs file
+ * @returns 0 on success or -1 if the file could not be read
+ */
+static int readSysfsInt(const char* path, int* val){
+    FILE* valFile = fopen(path, "r");
+    if(valFile == NULL){
+        return -1;
+    }
+    int rtn = fscanf(valFile, "%d", val) == 1 ? 0 : -1;
+    fclose(valFile);
+    return rtn;
+}
+
+/**
+ * Finds the L3 in the cache list of the given core (index3 is not the L3 on all systems)
+ * @returns the cache index of the L3 or -1 if the core has no L3
+ */
+static int getL3CacheIndex(int core){
+    char path[100];
+    for(int index = 0; index<10; index++){
+        int level;
+        snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/cache/index%d/level", core, index);
+        if(readSysfsInt(path, &level) == 0 && level == 3){
+            return index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @returns the lowest numbered core sharing the L3 of the given core or -1 if the core has no L3
+ */
+static int getL3FirstCPU(int core, int index){
+    char path[100];
+    int sharedCPU;
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", core, index);
+    return readCPUList(path, &sharedCPU, 1) > 0 ? sharedCPU : -1;
+}
+
+/**
+ * @returns the L3 id or -1 if the core has no L3
+ */
+static int getL3Id(int core){
+    int index = getL3CacheIndex(core);
+    if(index < 0){
+        return -1;
+    }
+
+    char path[100];
+    int id;
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/cache/index%d/id", core, index);
+    if(readSysfsInt(path, &id) == 0){
+        return id;
+    }
+
+    //Older kernels do not report the id.  Number the L3s densely in the order of their first core (the id is used to group L3s into
+    //dies so it must not be a core number)
+    int firstCPU = getL3FirstCPU(core, index);
+    if(firstCPU < 0){
+        return -1;
+    }
+    int l3sBefore = 0;
+    for(int cpu = 0; cpu<firstCPU; cpu++){
+        int cpuIndex = getL3CacheIndex(cpu);
+        if(cpuIndex >= 0 && getL3FirstCPU(cpu, cpuIndex) == cpu){
+            l3sBefore++;
+        }
+    }
+    return l3sBefore;
+}
+
+/**
+ * The NUMA node of a core is given by the nodeN link in its sysfs directory
+ * @returns the node or -1 if NUMA is not reported
+ */
+static int getNumaNode(int core){
+    char path[100];
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d", core);
+    DIR* cpuDir = opendir(path);
+    if(cpuDir == NULL){
+        return -1;
+    }
+
+    int node = -1;
+    struct dirent* entry;
+    while((entry = readdir(cpuDir)) != NULL){
+        if(strncmp(entry->d_name, "node", 4) == 0 && sscanf(entry->d_name+4, "%d", &node) == 1){
+            break;
+        }
+    }
+
+    closedir(cpuDir);
+    return node;
+}
+
+int getTopologyLocation(int core, topology_location_t* location){
+    char path[100];
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", core);
+    location->cpu = core;
+    if(readSysfsInt(path, &(location->socket)) != 0){
+        location->socket = -1;
+        return -1;
+    }
+    location->l3 = getL3Id(core);
+    location->die = location->l3 < 0 ? -1 : location->l3/TOPOLOGY_L3S_PER_DIE;
+    location->node = getNumaNode(core);
+    snprintf(path, 100, "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", core);
+    if(readCPUList(path, &(location->smtCore), 1) < 1){
+        location->smtCore = core;
+    }
+    return 0;
+}
+
+int getTopologyLevelOfLocations(const topology_location_t* a, const topology_location_t* b){
+    if(a->cpu == b->cpu){
+        return TOPOLOGY_LEVEL_LOCAL;
+    }
+    if(a->socket < 0 || b->socket < 0){
+        return TOPOLOGY_LEVEL_UNKNOWN;
+    }
+
+    if(a->socket != b->socket){
+        return TOPOLOGY_LEVEL_CROSS_SOCKET;
+    }
+    if(a->node != b->node){
+        return TOPOLOGY_LEVEL_SOCKET;
+    }
+    if(a->die != b->die){
+        return TOPOLOGY_LEVEL_NODE;
+    }
+    if(a->l3 != b->l3){
+        return TOPOLOGY_LEVEL_DIE;
+    }
+    if(a->smtCore == b->smtCore){
+        return TOPOLOGY_LEVEL_SMT;
+    }
+    return TOPOLOGY_LEVEL_L3;
+}
+
+int getTopologyLevel(int coreA, int coreB){
+    if(coreA == coreB){
+        return TOPOLOGY_LEVEL_LOCAL;
+    }
+
+    topology_location_t a, b;
+    getTopologyLocation(coreA, &a);
+    getTopologyLocation(coreB, &b);
+    return getTopologyLevelOfLocations(&a, &b);
+}
+
+const char* getTopologyLevelName(int level){
+    switch(level){
+        case TOPOLOGY_LEVEL_LOCAL:
+            return "Local";
+        case TOPOLOGY_LEVEL_SMT:
+            return "SMT";
+        case TOPOLOGY_LEVEL_L3:
+            return "SameL3";
+        case TOPOLOGY_LEVEL_DIE:
+            return "SameDie";
+        case TOPOLOGY_LEVEL_NODE:
+            return "SameNode";
+        case TOPOLOGY_LEVEL_SOCKET:
+            return "SameSocket";
+        case TOPOLOGY_LEVEL_CROSS_SOCKET:
+            return "CrossSocket";
+        default:
+            return "Unknown";
+    }
+}
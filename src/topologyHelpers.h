@@ -0,0 +1,66 @@
+#ifndef _TOPOLOGY_HELPERS_H
+#define _TOPOLOGY_HELPERS_H
+
+//The relationship between 2 cores, from closest to furthest.  Read from sysfs at runtime so that it reflects the NUMA (NPS) mode
+#define TOPOLOGY_LEVEL_UNKNOWN (-1) //The topology of one of the cores could not be read
+#define TOPOLOGY_LEVEL_SMT (0) //SMT siblings (the same physical core)
+#define TOPOLOGY_LEVEL_L3 (1) //The same L3 (CCX)
+#define TOPOLOGY_LEVEL_DIE (2) //Different L3s on the same die (CCD)
+#define TOPOLOGY_LEVEL_NODE (3) //Different dies in the same NUMA node
+#define TOPOLOGY_LEVEL_SOCKET (4) //Different NUMA nodes in the same socket (ex. NPS2, NPS4)
+#define TOPOLOGY_LEVEL_CROSS_SOCKET (5) //Different sockets
+#define TOPOLOGY_LEVELS (6)
+#define TOPOLOGY_LEVEL_LOCAL (-2) //The same core (ex. a memory buffer placed on the core that accesses it).  Not one of the TOPOLOGY_LEVELS
+
+//sysfs does not describe which L3s share a die.  L3s are grouped into dies by their L3 (cache) id.  Zen2 has 2 L3s (CCXs) per die (CCD),
+//Zen3 and later have 1
+#ifndef TOPOLOGY_L3S_PER_DIE
+    #define TOPOLOGY_L3S_PER_DIE (2)
+#endif
+
+typedef struct {
+    int cpu;
+    int l3; //The id of the L3 (-1 if there is no L3).  If the kernel does not report the id, the L3s are numbered in the order of their first core
+    int die; //l3/TOPOLOGY_L3S_PER_DIE
+    int node; //The NUMA node (-1 if NUMA is not reported)
+    int socket; //The physical package id (-1 if the location could not be read)
+    int smtCore; //The first thread in thread_siblings_list (the same for SMT siblings)
+} topology_location_t;
+
+/**
+ * Parses a sysfs CPU list (ex. "0,32" or "0-1") into cpus.
+ * @returns the number of CPUs in the list (only the first maxCPUs are stored) or -1 if the list could not be read
+ */
+int readCPUList(const char* path, int* cpus, int maxCPUs);
+
+/**
+ * Gets the SMT siblings of the given core (from thread_siblings_list).  The core itself is not included.
+ * @returns the number of siblings (0 if SMT is disabled or the topology could not be read)
+ */
+int getSmtSiblings(int core, int* siblings, int maxSiblings);
+
+/**
+ * Gets the first SMT sibling of the given core
+ * @returns the sibling or -1 if the core has no SMT siblings
+ */
+int getFirstSmtSibling(int core);
+
+/**
+ * Reads where the given core is in the topology
+ * @returns 0 on success or -1 if the topology of the core could not be read
+ */
+int getTopologyLocation(int core, topology_location_t* location);
+
+/**
+ * Gets the closest level (see TOPOLOGY_LEVEL_*) the 2 cores share
+ */
+int getTopologyLevel(int coreA, int coreB);
+
+/**
+ * Like getTopologyLevel but from locations read by getTopologyLocation (no sysfs reads).  For comparing many pairs of cores
+ */
+int getTopologyLevelOfLocations(const topology_location_t* a, const topology_location_t* b);
+
+const char* getTopologyLevelName(int level);
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "workerPool.h"
+
+static worker_pool_worker_t* workers[CPU_SETSIZE] = {NULL};
+
+static void* worker_pool_thread(void* args){
+    worker_pool_worker_t *worker = (worker_pool_worker_t*) args;
+
+    pthread_mutex_lock(&(worker->lock));
+    while(true){
+        while(!worker->jobPending && !worker->shutdown){
+            pthread_cond_wait(&(worker->cond), &(worker->lock));
+        }
+
+        if(worker->shutdown){
+            break;
+        }
+
+        //Run the job without holding the lock
+        void* (*fun)(void*) = worker->fun;
+        void* jobArgs = worker->args;
+        worker->jobPending = false;
+        pthread_mutex_unlock(&(worker->lock));
+
+        void* result = fun(jobArgs);
+
+        pthread_mutex_lock(&(worker->lock));
+        worker->result = result;
+        worker->jobDone = true;
+        pthread_cond_broadcast(&(worker->cond));
+    }
+    pthread_mutex_unlock(&(worker->lock));
+
+    return NULL;
+}
+
+static worker_pool_worker_t* getWorker(int core){
+    if(core < 0 || core >= CPU_SETSIZE){
+        printf("Worker pool core %d is out of range ... exiting\n", core);
+        exit(1);
+    }
+
+    if(workers[core] != NULL){
+        return workers[core];
+    }
+
+    worker_pool_worker_t *worker = (worker_pool_worker_t*) malloc(sizeof(worker_pool_worker_t));
+    worker->core = core;
+    worker->fun = NULL;
+    worker->args = NULL;
+    worker->result = NULL;
+    worker->jobPending = false;
+    worker->jobDone = false;
+    worker->shutdown = false;
+    pthread_mutex_init(&(worker->lock), NULL);
+    pthread_cond_init(&(worker->cond), NULL);
+
+    int status;
+    status = pthread_attr_init(&(worker->attr));
+    if (status != 0)
+    {
+        printf("Could not create worker pthread attributes ... exiting");
+        exit(1);
+    }
+
+    //Set worker to run with SCHED_FIFO RT Scheduler with Max Priority
+    //NOTE! This can lock up the computer if this thread is run on a CPU where system tasks are running.
+    status = pthread_attr_setinheritsched(&(worker->attr), PTHREAD_EXPLICIT_SCHED);
+    if (status != 0)
+    {
+        printf("Could not set worker pthread explicit schedule attribute ... exiting\n");
+        exit(1);
+    }
+
+    status = pthread_attr_setschedpolicy(&(worker->attr), SCHED_FIFO);
+    if (status != 0)
+    {
+        printf("Could not set worker pthread schedule policy to SCHED_FIFO ... exiting\n");
+        exit(1);
+    }
+
+    worker->threadParams.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    status = pthread_attr_setschedparam(&(worker->attr), &(worker->threadParams));
+    if (status != 0)
+    {
+        printf("Could not set worker pthread schedule parameter ... exiting\n");
+        exit(1);
+    }
+
+    //Set worker to run on specified CPU
+    CPU_ZERO(&(worker->cpuset));                                                                  //Clear cpuset
+    CPU_SET(core, &(worker->cpuset));                                                             //Add CPU to cpuset
+    status = pthread_attr_setaffinity_np(&(worker->attr), sizeof(cpu_set_t), &(worker->cpuset)); //Set thread CPU affinity
+    if (status != 0)
+    {
+        printf("Could not set worker thread core affinity ... exiting");
+        exit(1);
+    }
+
+    status = pthread_create(&(worker->thread), &(worker->attr), worker_pool_thread, worker);
+    if (status != 0)
+    {
+        printf("Could not create a worker thread ... exiting");
+        errno = status;
+        perror(NULL);
+        exit(1);
+    }
+
+    workers[core] = worker;
+    return worker;
+}
+
+void workerPoolSubmit(int core, void* (*fun)(void*), void* args){
+    worker_pool_worker_t *worker = getWorker(core);
+
+    pthread_mutex_lock(&(worker->lock));
+    if(worker->fun != NULL){ //Not yet joined
+        printf("Worker on core %d already has an outstanding job ... exiting\n", core);
+        exit(1);
+    }
+    worker->fun = fun;
+    worker->args = args;
+    worker->result = NULL;
+    worker->jobDone = false;
+    worker->jobPending = true;
+    pthread_cond_broadcast(&(worker->cond));
+    pthread_mutex_unlock(&(worker->lock));
+}
+
+void* workerPoolJoin(int core){
+    worker_pool_worker_t *worker = workers[core];
+    if(worker == NULL || worker->fun == NULL){
+        printf("No job was submitted to the worker on core %d ... exiting\n", core);
+        exit(1);
+    }
+
+    pthread_mutex_lock(&(worker->lock));
+    while(!worker->jobDone){
+        pthread_cond_wait(&(worker->cond), &(worker->lock));
+    }
+    void* result = worker->result;
+    worker->fun = NULL;
+    worker->args = NULL;
+    worker->jobDone = false;
+    pthread_mutex_unlock(&(worker->lock));
+
+    return result;
+}
+
+void* workerPoolRun(int core, void* (*fun)(void*), void* args){
+    workerPoolSubmit(core, fun, args);
+    return workerPoolJoin(core);
+}
+
+void workerPoolShutdown(){
+    for(int core = 0; core<CPU_SETSIZE; core++){
+        worker_pool_worker_t *worker = workers[core];
+        if(worker != NULL){
+            pthread_mutex_lock(&(worker->lock));
+            worker->shutdown = true;
+            pthread_cond_broadcast(&(worker->cond));
+            pthread_mutex_unlock(&(worker->lock));
+
+            int status = pthread_join(worker->thread, NULL);
+            if (status != 0)
+            {
+                printf("Could not join a worker thread ... exiting");
+                errno = status;
+                perror(NULL);
+                exit(1);
+            }
+
+            pthread_attr_destroy(&(worker->attr));
+            pthread_mutex_destroy(&(worker->lock));
+            pthread_cond_destroy(&(worker->cond));
+            free(worker);
+            workers[core] = NULL;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef _WORKER_POOL_H
+#define _WORKER_POOL_H
+
+#ifndef _GNU_SOURCE
+//Need _GNU_SOURCE, sched.h, and unistd.h for setting thread affinity in Linux
+#define _GNU_SOURCE
+#endif
+
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+/*
+ * A pool of persistent worker threads, one pinned to each core used by the benchmarks.
+ * Workers are created with the SCHED_FIFO RT scheduler at max priority the first time a core is used and are reused
+ * by subsequent tests.  Idle workers block on a condition variable and do not consume CPU time.
+ * 
+ * Only one job may be outstanding on a given core at a time.
+ */
+
+typedef struct {
+    pthread_t thread;
+    pthread_attr_t attr;
+    struct sched_param threadParams;
+    cpu_set_t cpuset;
+    int core;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    void* (*fun)(void*);
+    void* args;
+    void* result;
+    bool jobPending;
+    bool jobDone;
+    bool shutdown;
+} worker_pool_worker_t;
+
+/**
+ * Starts fun(args) on the worker pinned to core.  Returns without waiting for the job to finish.
+ */
+void workerPoolSubmit(int core, void* (*fun)(void*), void* args);
+
+/**
+ * Waits for the job on the worker pinned to core to finish and returns the value returned by the job
+ */
+void* workerPoolJoin(int core);
+
+/**
+ * Runs fun(args) on the worker pinned to core and waits for it to finish
+ */
+void* workerPoolRun(int core, void* (*fun)(void*), void* args);
+
+/**
+ * Stops and joins all workers
+ */
+void workerPoolShutdown();
+
+#endif